@@ -0,0 +1,46 @@
+// Times `range(0, n) => r; sum(r) => s;`, sum / min / max / mean over a
+// materialized typed range, and a typed `array<...>` declaration through
+// the interpreter, reporting wall time and the heap each step leaves
+// behind.
+// usage: node --expose-gc bench/arrays.js [n] [interpreter module]
+const path = require('path');
+
+const n = Number(process.argv[2]) || 10000000;
+const novaModule = path.resolve(process.argv[3] || path.join(__dirname, '../core/nova.js'));
+const { nova } = require(novaModule);
+
+const gc = global.gc || (() => {});
+const heap = () => {
+  gc();
+  const m = process.memoryUsage();
+  return m.heapUsed + m.external;
+};
+
+function time(label, interp, code, check) {
+  const before = heap();
+  const t0 = process.hrtime.bigint();
+  interp.run(code);
+  const ms = Number(process.hrtime.bigint() - t0) / 1e6;
+  const mb = (heap() - before) / 1048576;
+  const ok = check(interp);
+  console.log(`${label.padEnd(30)} ${ms.toFixed(0).padStart(7)} ms ${mb.toFixed(0).padStart(6)} MB  ${ok ? 'ok' : 'WRONG'}`);
+  return ok;
+}
+
+const interp = new nova();
+const at = (a, i) => (typeof a.at === 'function' ? a.at(i) : a[i]);
+let ok = time(`range(0, ${n}) => r`, interp, `range(0, ${n}) => r;`, (it) => it.enums.r.length === n && at(it.enums.r, n - 1) === n - 1);
+ok = time('sum(r) => s', interp, 'sum(r) => s;', (it) => it.maps.s === (n * (n - 1)) / 2) && ok;
+if (typeof interp.enums.r.toTypedArray === 'function') {
+  interp.enums.rt = interp.enums.r.toTypedArray();
+  ok = time('sum(rt) => st (materialized)', interp, 'sum(rt) => st;', (it) => it.maps.st === (n * (n - 1)) / 2) && ok;
+  ok = time('min(rt) => lo', interp, 'min(rt) => lo;', (it) => it.maps.lo === 0) && ok;
+  ok = time('max(rt) => hi', interp, 'max(rt) => hi;', (it) => it.maps.hi === n - 1) && ok;
+  ok = time('mean(rt) => m', interp, 'mean(rt) => m;', (it) => it.maps.m === (n - 1) / 2) && ok;
+}
+
+const literal = Array.from({ length: 10000 }, (_, i) => i * 0.5).join(', ');
+ok = time('array<float64> of 10k', interp, `array<float64> xs { ${literal} }`, (it) => it.maps.xs.length === 10000) && ok;
+ok = time('sum(xs) => t', interp, 'sum(xs) => t;', (it) => it.maps.t === 0.5 * (10000 * 9999) / 2) && ok;
+
+process.exitCode = ok ? 0 : 1;
@@ -0,0 +1,55 @@
+// Sequential and concurrent requests against a local server: the pooled
+// in-process client behind the `http` keyword vs forking curl per request.
+// usage: node bench/http-client.js [requests] [concurrency]
+const { fork, execSync } = require('child_process');
+const client = require('../core/nova-http');
+
+const n = Number(process.argv[2]) || 2000;
+const concurrency = Number(process.argv[3]) || 32;
+
+if (process.argv[2] === '--server') {
+  const http = require('http');
+  const server = http.createServer((req, res) => res.end('{"ok":true}'));
+  server.keepAliveTimeout = 5000;
+  server.listen(0, '127.0.0.1', () => process.send(server.address().port));
+  return;
+}
+
+const time = (label, count, fn) => {
+  const t0 = process.hrtime.bigint();
+  const done = () => {
+    const ms = Number(process.hrtime.bigint() - t0) / 1e6;
+    console.log(`${label.padEnd(28)} ${count} req ${ms.toFixed(0)}ms ${(count / ms * 1000).toFixed(0)} req/s`);
+  };
+  const r = fn();
+  return r && r.then ? r.then(done) : done();
+};
+
+const server = fork(__filename, ['--server']);
+server.on('message', async (port) => {
+  const url = `http://127.0.0.1:${port}/`;
+
+  const curlN = Math.min(n, 200);
+  time('curl (execSync), sequential', curlN, () => {
+    for (let i = 0; i < curlN; i++) execSync(`curl -s "${url}"`);
+  });
+
+  time('pooled, blocking sequential', n, () => {
+    for (let i = 0; i < n; i++) client.requestSync('GET', url);
+  });
+
+  client.configure({ keepAlive: false });
+  time('no keep-alive, sequential', n, () => {
+    for (let i = 0; i < n; i++) client.requestSync('GET', url);
+  });
+  client.configure({ keepAlive: true });
+
+  await time(`pooled, ${concurrency} in flight`, n, async () => {
+    let next = 0;
+    const lane = async () => { while (next++ < n) await client.request('GET', url); };
+    await Promise.all(Array.from({ length: concurrency }, lane));
+  });
+
+  server.kill();
+  for (const agent of Object.values(client.agents)) agent.destroy();
+});
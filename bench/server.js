@@ -0,0 +1,65 @@
+// Load test for the `server` keyword: keep-alive clients hammer a Nova
+// route and report requests/sec and latency percentiles.
+// usage: node bench/server.js [seconds] [connections] [route] [interpreter module]
+// route: "hello" (stateless) or "local" (declares a handler-local variable)
+const path = require('path');
+const http = require('http');
+const { fork } = require('child_process');
+
+const seconds = Number(process.argv[2]) || 5;
+const connections = Number(process.argv[3]) || 32;
+const route = process.argv[4] || 'hello';
+const novaModule = path.resolve(process.argv[5] || path.join(__dirname, '../core/nova.js'));
+const port = 18000 + Math.floor(Math.random() * 1000);
+
+const source = `
+server(${port}) {
+  get("/hello") {
+    send("hello " + req.url);
+  };
+  get("/local") {
+    var greeting = "hello " + req.url;
+    send(greeting);
+  };
+  post("/echo") {
+    json(reqBody);
+  };
+};
+`;
+
+if (process.argv[2] === '--serve') {
+  const { env } = require(process.argv[3]);
+  env.run(process.argv[4]);
+  return;
+}
+
+const child = fork(__filename, ['--serve', novaModule, source], { stdio: ['ignore', 'pipe', 'inherit', 'ipc'] });
+child.stdout.once('data', () => setTimeout(load, 200));
+
+function load() {
+  const agent = new http.Agent({ keepAlive: true, maxSockets: connections });
+  const latencies = [];
+  let errors = 0, wrong = 0;
+  const end = Date.now() + seconds * 1000;
+  const hit = () => new Promise((resolve) => {
+    const name = Math.random().toString(36).slice(2, 8);
+    const t0 = process.hrtime.bigint();
+    http.get({ host: '127.0.0.1', port, path: `/${route}?name=${name}`, agent }, (res) => {
+      let body = '';
+      res.on('data', (c) => (body += c));
+      res.on('end', () => {
+        latencies.push(Number(process.hrtime.bigint() - t0) / 1e6);
+        if (body !== `hello /${route}?name=${name}`) wrong++;
+        resolve();
+      });
+    }).on('error', () => { errors++; resolve(); });
+  });
+  const lane = async () => { while (Date.now() < end) await hit(); };
+  Promise.all(Array.from({ length: connections }, lane)).then(() => {
+    latencies.sort((a, b) => a - b);
+    const pct = (p) => latencies[Math.min(latencies.length - 1, Math.floor(latencies.length * p))].toFixed(2);
+    console.log(`${path.relative(process.cwd(), novaModule)} /${route}: ${(latencies.length / seconds).toFixed(0)} req/s  p50=${pct(0.5)}ms p99=${pct(0.99)}ms  errors=${errors} wrong=${wrong}`);
+    agent.destroy();
+    child.kill();
+  });
+}
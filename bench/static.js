@@ -0,0 +1,79 @@
+// Static file serving: `static(dir)` / sendFile against the old
+// `readFile` + `send` handler, for a 1 KB and a 10 MB asset.
+// usage: node bench/static.js [seconds] [connections] [interpreter module]
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const http = require('http');
+const { fork } = require('child_process');
+
+const seconds = Number(process.argv[2]) || 5;
+const connections = Number(process.argv[3]) || 16;
+const novaModule = path.resolve(process.argv[4] || path.join(__dirname, '../core/nova.js'));
+const port = 19000 + Math.floor(Math.random() * 1000);
+
+if (process.argv[2] === '--serve') {
+  const { env } = require(process.argv[3]);
+  process.chdir(process.argv[5]);
+  env.run(process.argv[4]);
+  return;
+}
+
+const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'nova-static-'));
+const text = (n) => 'abcdefghijklmnopqrstuvwxyz0123456789\n'.repeat(Math.ceil(n / 37)).slice(0, n);
+fs.writeFileSync(path.join(dir, 'small.txt'), text(1024));
+fs.writeFileSync(path.join(dir, 'big.txt'), text(10 << 20));
+
+const source = `
+server(${port}) {
+  static("/static", ".");
+  get("/read/small") {
+    readFile body = ("small.txt");
+    send(body);
+  };
+  get("/read/big") {
+    readFile body = ("big.txt");
+    send(body);
+  };
+};
+`;
+
+const cases = [
+  ['/read/small', 1024], ['/static/small.txt', 1024],
+  ['/read/big', 10 << 20], ['/static/big.txt', 10 << 20],
+];
+
+const child = fork(__filename, ['--serve', novaModule, source, dir], { stdio: ['ignore', 'pipe', 'inherit', 'ipc'] });
+child.stdout.once('data', () => setTimeout(run, 200));
+
+async function load(route, size) {
+  const agent = new http.Agent({ keepAlive: true, maxSockets: connections });
+  const latencies = [];
+  let errors = 0, wrong = 0;
+  const end = Date.now() + seconds * 1000;
+  const hit = () => new Promise((resolve) => {
+    const t0 = process.hrtime.bigint();
+    http.get({ host: '127.0.0.1', port, path: route, agent }, (res) => {
+      let bytes = 0;
+      res.on('data', (c) => (bytes += c.length));
+      res.on('end', () => {
+        latencies.push(Number(process.hrtime.bigint() - t0) / 1e6);
+        if (bytes !== size) wrong++;
+        resolve();
+      });
+    }).on('error', () => { errors++; resolve(); });
+  });
+  const lane = async () => { while (Date.now() < end) await hit(); };
+  await Promise.all(Array.from({ length: connections }, lane));
+  agent.destroy();
+  latencies.sort((a, b) => a - b);
+  const pct = (p) => latencies[Math.min(latencies.length - 1, Math.floor(latencies.length * p))].toFixed(2);
+  const rps = latencies.length / seconds;
+  console.log(`${route.padEnd(18)} ${rps.toFixed(0).padStart(6)} req/s ${(rps * size / 1048576).toFixed(1).padStart(8)} MB/s  p50=${pct(0.5)}ms p99=${pct(0.99)}ms  errors=${errors} wrong=${wrong}`);
+}
+
+async function run() {
+  for (const [route, size] of cases) await load(route, size);
+  child.kill();
+  fs.rmSync(dir, { recursive: true, force: true });
+}
@@ -0,0 +1,281 @@
+// Typed homogeneous arrays and lazy ranges for nova: `array<float64> nums
+// { ... }`, `1..N` / range(), and the sum / min / max / mean / reverse /
+// addto fast paths over them.
+//
+// Numbers in a Float64Array or Int32Array are stored unboxed in one
+// contiguous buffer, and a range is four numbers however long it is, so
+// loops over either never allocate per element. With the kernels addon
+// built, reductions over number typed arrays run as SIMD loops in native
+// code; without it the JS loops here give the same answers, up to the
+// rounding of a different summation order.
+const { inspect } = require('util');
+const { optionalNative } = require('./nova-native');
+
+const Kernels = () => optionalNative('kernels');
+
+const kinds = {
+  int8: Int8Array, uint8: Uint8Array, int16: Int16Array, uint16: Uint16Array,
+  int32: Int32Array, uint32: Uint32Array, float32: Float32Array, float64: Float64Array,
+  int64: BigInt64Array, uint64: BigUint64Array,
+};
+
+const isTypedArray = (v) => ArrayBuffer.isView(v) && !(v instanceof DataView);
+
+const isBigIntArray = (v) => v instanceof BigInt64Array || v instanceof BigUint64Array;
+
+// What the kernels addon takes: typed arrays of numbers.
+const isNumberArray = (v) => isTypedArray(v) && !isBigIntArray(v);
+
+const isInt32 = (x) => (x | 0) === x;
+
+// What a typed element of kind can hold exactly.
+function fits(Typed, x) {
+  if (Typed === BigInt64Array || Typed === BigUint64Array) {
+    return typeof x === 'bigint' && (Typed === BigInt64Array ? BigInt.asIntN(64, x) : BigInt.asUintN(64, x)) === x;
+  }
+  if (typeof x !== 'number') return false;
+  if (Typed === Float64Array) return true;
+  if (Typed === Float32Array) return Number.isNaN(x) || Math.fround(x) === x;
+  return new Typed([x])[0] === x;
+}
+
+// The narrowest of Int32Array / Float64Array holding every value, or null
+// when one is not a number.
+function detect(values) {
+  let Typed = Int32Array;
+  for (let i = 0; i < values.length; i++) {
+    const x = values[i];
+    if (typeof x !== 'number') return null;
+    if (Typed === Int32Array && !isInt32(x)) Typed = Float64Array;
+  }
+  return Typed;
+}
+
+// values as a typed array of kind: a name from `kinds`, or 'number' for
+// detect(). Throws when a value does not fit.
+function from(values, kind = 'number') {
+  const Typed = kind === 'number' ? detect(values) : kinds[kind];
+  if (kind !== 'number' && !Typed) throw new Error(`Unknown typed array kind: ${kind}`);
+  if (!Typed) {
+    const idx = values.findIndex((x) => typeof x !== 'number');
+    throw new Error(`typed array error: element (${values[idx]}) at index ${idx} is not a number`);
+  }
+  for (let i = 0; i < values.length; i++) {
+    if (!fits(Typed, values[i])) {
+      throw new Error(`typed array error: element (${values[i]}) at index ${i} does not fit ${kind}`);
+    }
+  }
+  return Typed.from(values);
+}
+
+// A lazy arithmetic sequence: start, start + step, ... up to end (included
+// when inclusive). `1..N`, `1...N`, range(a, b) and `step` build these, so
+// `loop i in 1..1000000000` runs in constant memory. Elements are computed
+// on indexing; toArray() / toTypedArray() materialize when an array is
+// really needed, and Array methods not defined here work on such a copy.
+class Range {
+  constructor(start, end, step = 1, inclusive = true) {
+    start = Number(start);
+    end = Number(end);
+    step = Number(step);
+    if (Number.isNaN(start) || Number.isNaN(end)) throw new Error('Range bounds must be numbers');
+    if (!Number.isFinite(step) || step === 0) throw new RangeError('Range step must be a non-zero number');
+    this.start = start;
+    this.end = end;
+    this.step = step;
+    this.inclusive = inclusive;
+    const span = (end - start) / step;
+    const n = span < 0 ? 0 : inclusive ? Math.floor(span) + 1 : Math.ceil(span);
+    if (!Number.isSafeInteger(n)) throw new RangeError('Range bounds must be finite');
+    this.size = n;
+  }
+
+  get length() { return this.size; }
+
+  at(i) {
+    i = Math.trunc(Number(i));
+    if (i < 0) i += this.size;
+    return i >= 0 && i < this.size ? this.start + i * this.step : undefined;
+  }
+
+  get first() { return this.at(0); }
+
+  get last() { return this.at(-1); }
+
+  [Symbol.iterator]() {
+    const { start, step, size } = this;
+    let i = 0;
+    return {
+      next: () => (i < size ? { value: start + i++ * step, done: false } : { value: undefined, done: true }),
+      [Symbol.iterator]() { return this; },
+    };
+  }
+
+  includes(x) {
+    if (typeof x !== 'number' || !this.size) return false;
+    const k = (x - this.start) / this.step;
+    return Number.isInteger(k) && k >= 0 && k < this.size;
+  }
+
+  indexOf(x) {
+    return this.includes(x) ? (x - this.start) / this.step : -1;
+  }
+
+  // The same elements in the opposite order, still lazy.
+  reverse() {
+    return this.size ? new Range(this.last, this.first, -this.step, true) : this;
+  }
+
+  toArray() {
+    const out = new Array(this.size);
+    for (let i = 0; i < this.size; i++) out[i] = this.start + i * this.step;
+    return out;
+  }
+
+  // An Int32Array when every element fits, else a Float64Array.
+  toTypedArray() {
+    const n = this.size;
+    const out = n && isInt32(this.first) && isInt32(this.last) && isInt32(this.step) ? new Int32Array(n) : new Float64Array(n);
+    for (let i = 0; i < n; i++) out[i] = this.start + i * this.step;
+    return out;
+  }
+
+  toJSON() { return this.toArray(); }
+
+  // Short ranges read as the array they stand for. Long ones stay compact,
+  // since the interpreter builds debug strings from values it handles.
+  toString() {
+    if (this.size <= PRINT_LIMIT) return this.toArray().toString();
+    return `${this.first}..${this.last}${this.step === 1 ? '' : ` step ${this.step}`}`;
+  }
+
+  [inspect.custom](depth, options, show) {
+    if (this.size <= PRINT_LIMIT) return show(this.toArray(), options);
+    return `Range(${this.toString()}, ${this.size} items)`;
+  }
+}
+
+// util.inspect shows no more than this many array items by default.
+const PRINT_LIMIT = 100;
+
+// Array methods read from a materialized copy; mutators have nothing to
+// mutate.
+for (const name of Object.getOwnPropertyNames(Array.prototype)) {
+  if (name in Range.prototype || typeof Array.prototype[name] !== 'function') continue;
+  const method = Array.prototype[name];
+  Range.prototype[name] = ['push', 'pop', 'shift', 'unshift', 'splice', 'sort', 'fill', 'copyWithin'].includes(name)
+    ? function () { throw new TypeError(`A range is read-only; ${name}() needs toArray() first`); }
+    : function (...args) { return method.apply(this.toArray(), args); };
+}
+
+// range(a, b) => x: a, a + 1, ... below b (up to b when inclusive).
+const range = (start, end, inclusive = false) => new Range(start, end, 1, inclusive);
+
+// Neumaier's variant of Kahan summation: carries the low-order bits each
+// addition drops, so 1e10 followed by a million 0.1s totals 1e10 + 1e5
+// rather than drifting by the rounding of every step.
+function compensatedSum(values) {
+  let s = 0, c = 0;
+  for (let i = 0; i < values.length; i++) {
+    const x = Number(values[i]);
+    const t = s + x;
+    c += Math.abs(s) >= Math.abs(x) ? (s - t) + x : (x - t) + s;
+    s = t;
+  }
+  return s + c;
+}
+
+// Total of an array: ranges in closed form (one rounding at most, where a
+// running total would round at every step), number typed arrays in the
+// kernels addon or a plain loop, bigint kinds as bigints; anything else
+// keeps the `+` of reduce (numbers add, strings join). compensated sums
+// numbers with compensatedSum().
+function sum(values, compensated = false) {
+  if (values instanceof Range) return values.size && ((values.first + values.last) * values.size) / 2;
+  if (isBigIntArray(values)) {
+    let t = 0n;
+    for (let i = 0; i < values.length; i++) t += values[i];
+    return t;
+  }
+  if (isNumberArray(values)) {
+    const K = Kernels();
+    if (K) return K.sum(values, compensated);
+    if (compensated) return compensatedSum(values);
+    let t = 0;
+    for (let i = 0; i < values.length; i++) t += values[i];
+    return t;
+  }
+  const arr = Array.isArray(values) ? values : Array.from(values);
+  if (compensated && arr.every((x) => typeof x === 'number')) return compensatedSum(arr);
+  return arr.reduce((a, b) => a + b, 0);
+}
+
+// Smallest / largest element, skipping NaNs: Infinity / -Infinity when
+// nothing is left, as Math.min() / Math.max() give. Unlike those, arrays of
+// any length work, and bigints compare as bigints.
+function extreme(values, lower) {
+  if (values instanceof Range) {
+    if (!values.size) return lower ? Infinity : -Infinity;
+    return lower === (values.step > 0) ? values.first : values.last;
+  }
+  if (isNumberArray(values) && Kernels()) return lower ? Kernels().min(values) : Kernels().max(values);
+  let m = lower ? Infinity : -Infinity;
+  for (let i = 0; i < values.length; i++) {
+    const x = typeof values[i] === 'bigint' ? values[i] : Number(values[i]);
+    if (lower ? x < m : x > m) m = x;
+  }
+  return m;
+}
+
+const min = (values) => extreme(values, true);
+const max = (values) => extreme(values, false);
+
+// Arithmetic mean; NaN for an empty array.
+function mean(values, compensated = false) {
+  if (values instanceof Range) return values.size ? (values.first + values.last) / 2 : NaN;
+  if (isNumberArray(values) && Kernels()) return Kernels().mean(values, compensated);
+  if (!values.length) return NaN;
+  return Number(sum(values, compensated)) / values.length;
+}
+
+// A reversed copy of the same kind; ranges stay lazy.
+const reverse = (values) => (values instanceof Range ? values.reverse() : values.slice().reverse());
+
+// Buffers append() allocated, with how many elements are in use. Only the
+// view ending at that mark may grow in place; other views of the buffer
+// (aliases, older lengths) and buffers owned elsewhere are copied.
+const grown = new WeakMap();
+
+// arr with value added at the end, for addto. Typed arrays are views into
+// a buffer with spare room that doubles when full, so repeated appends stay
+// amortized O(1); the returned view replaces arr. A value the kind cannot
+// hold widens a number array to Float64Array, or anything to a plain
+// array.
+function append(arr, value) {
+  if (arr instanceof Range) arr = arr.toArray();
+  if (!isTypedArray(arr)) {
+    arr.push(value);
+    return arr;
+  }
+  const Typed = arr.constructor;
+  if (!fits(Typed, value)) {
+    const wider = typeof value === 'number' && !isBigIntArray(arr)
+      ? Float64Array.from(arr)
+      : Array.from(arr);
+    return append(wider, value);
+  }
+  const n = arr.length;
+  const capacity = arr.buffer.byteLength / Typed.BYTES_PER_ELEMENT;
+  let out;
+  if (arr.byteOffset === 0 && grown.get(arr.buffer) === n && n < capacity) {
+    out = new Typed(arr.buffer, 0, n + 1);
+  } else {
+    out = new Typed(new ArrayBuffer(Math.max(16, n * 2) * Typed.BYTES_PER_ELEMENT), 0, n + 1);
+    out.set(arr);
+  }
+  grown.set(out.buffer, n + 1);
+  out[n] = value;
+  return out;
+}
+
+module.exports = { kinds, isTypedArray, detect, from, Range, range, sum, min, max, mean, reverse, append };
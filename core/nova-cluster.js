@@ -0,0 +1,163 @@
+// Multi-process mode for `server(port, { workers: N })`.
+//
+// The primary parses the server block once and hands every worker the same
+// frozen route table, the source of the script's definitions (functions,
+// classes, macros, ...) and a snapshot of its globals, so workers define
+// what the handlers call without re-running the rest of the script. Workers bind with SO_REUSEPORT where Node supports
+// it (kernel load balancing) and fall back to cluster's shared handle
+// otherwise.
+//
+//   SIGHUP            rolling restart: each worker is replaced only after its
+//                     successor is listening, then drained
+//   GET /__health     per-worker stats collected by the primary
+//   crashed workers are respawned
+const cluster = require('cluster');
+const { monitorEventLoopDelay } = require('perf_hooks');
+
+const [major, minor] = process.versions.node.split('.').map(Number);
+const reusePortSupported = major > 23 || (major === 23 && minor >= 1) || (major === 22 && minor >= 12);
+
+const deepFreeze = (o) => {
+  if (o && typeof o === 'object' && !Object.isFrozen(o)) {
+    Object.freeze(o);
+    for (const v of Object.values(o)) deepFreeze(v);
+  }
+  return o;
+};
+
+// Globals that survive IPC (structured-clonable data); workers get them
+// read-write but changes stay local to each worker.
+function shareableGlobals(maps) {
+  const out = {};
+  for (const [k, v] of Object.entries(maps)) {
+    if (typeof v === 'function' || typeof v === 'symbol') continue;
+    try { structuredClone(v); out[k] = v; } catch { /* holds functions or natives, skip */ }
+  }
+  return out;
+}
+
+function startCluster(env, { port, routes, workers, healthInterval = 1000, drainTimeout = 10000 }) {
+  const table = deepFreeze(routes.map(({ method, path, handlerBody, dir }) => ({ method, path, handlerBody, dir })));
+  const globals = shareableGlobals(env.maps);
+  const definitions = [...env.definitions.values()].join('\n');
+  const health = new Map();        // worker id -> latest stats
+  const retiring = new Set();
+  let shuttingDown = false;
+  let restarts = 0;
+
+  cluster.setupPrimary({ exec: __filename, args: [], serialization: 'advanced' });
+
+  const spawn = () => {
+    const worker = cluster.fork({ NOVA_CLUSTER_WORKER: '1' });
+    worker.on('online', () => worker.send({ type: 'init', port, routes: table, definitions, globals, healthInterval, reusePort: reusePortSupported }));
+    worker.on('message', (msg) => {
+      if (msg?.type === 'health' && !retiring.has(worker.id)) {
+        health.set(worker.id, { id: worker.id, pid: worker.process.pid, ...msg.stats });
+        worker.send({ type: 'cluster-health', workers: [...health.values()], restarts });
+      }
+    });
+    worker.on('exit', (code, signal) => {
+      health.delete(worker.id);
+      if (retiring.delete(worker.id) || shuttingDown) return;
+      console.error(`[nova-cluster] worker ${worker.process.pid} died (${signal || code}), respawning`);
+      restarts++;
+      setTimeout(spawn, 100);
+    });
+    return worker;
+  };
+
+  const retire = (worker) => {
+    retiring.add(worker.id);
+    health.delete(worker.id);
+    worker.send({ type: 'drain' });
+    setTimeout(() => { if (!worker.isDead()) worker.kill(); }, drainTimeout).unref();
+  };
+
+  // Replace workers one at a time so capacity never drops below N - 1.
+  const rollingRestart = async () => {
+    const old = Object.values(cluster.workers).filter(w => !retiring.has(w.id));
+    for (const worker of old) {
+      const fresh = spawn();
+      await new Promise((resolve) => fresh.once('listening', resolve));
+      retire(worker);
+    }
+    restarts++;
+    console.log(`[nova-cluster] rolling restart done, ${old.length} workers replaced`);
+  };
+
+  const shutdown = () => {
+    shuttingDown = true;
+    for (const worker of Object.values(cluster.workers)) retire(worker);
+    setTimeout(() => process.exit(0), drainTimeout).unref();
+    cluster.on('exit', () => { if (Object.keys(cluster.workers).length === 0) process.exit(0); });
+  };
+
+  process.on('SIGHUP', rollingRestart);
+  process.on('SIGINT', shutdown);
+  process.on('SIGTERM', shutdown);
+
+  let listening = 0;
+  cluster.on('listening', () => {
+    if (++listening === workers) console.log(`Server running on port ${port} (${workers} workers${reusePortSupported ? ', SO_REUSEPORT' : ''})`);
+  });
+  for (let i = 0; i < workers; i++) spawn();
+  return { rollingRestart, shutdown, health };
+}
+
+// ---------- worker side ----------
+if (cluster.isWorker && process.env.NOVA_CLUSTER_WORKER) {
+  const { env } = require('./nova.js');
+  const express = require('express');
+
+  process.on('message', (msg) => {
+    if (msg?.type !== 'init') return;
+    if (msg.definitions) env.run(msg.definitions);
+    Object.assign(env.maps, msg.globals);
+
+    let requests = 0, inflight = 0, draining = false, clusterHealth = { workers: [] };
+    const loopDelay = monitorEventLoopDelay({ resolution: 10 });
+    loopDelay.enable();
+
+    const app = express();
+    app.use((req, res, next) => {
+      requests++;
+      inflight++;
+      res.once('close', () => inflight--);
+      if (draining) res.setHeader('Connection', 'close');
+      next();
+    });
+    app.get('/__health', (req, res) => res.json({ pid: process.pid, ...clusterHealth }));
+    env.createServerApp(msg.routes, app);
+
+    const server = require('http').createServer(app);
+    server.listen(msg.reusePort ? { port: msg.port, reusePort: true, exclusive: true } : { port: msg.port });
+
+    const report = setInterval(() => {
+      const mem = process.memoryUsage();
+      process.send({
+        type: 'health',
+        stats: {
+          requests, inflight,
+          rss: mem.rss, heapUsed: mem.heapUsed,
+          loopDelayP99: loopDelay.percentile(99) / 1e6,
+          uptime: process.uptime(),
+        },
+      });
+      loopDelay.reset();
+    }, msg.healthInterval);
+    report.unref();
+
+    process.on('message', (m) => {
+      if (m?.type === 'cluster-health') clusterHealth = { workers: m.workers, restarts: m.restarts };
+      // Closing the server right away would also drop idle keep-alive sockets
+      // a client may be writing to; tell clients to go away first.
+      if (m?.type === 'drain' && !draining) {
+        draining = true;
+        clearInterval(report);
+        setTimeout(() => cluster.worker.disconnect(), 1000).unref();
+      }
+    });
+  });
+}
+
+module.exports = { startCluster, shareableGlobals, reusePortSupported };
@@ -0,0 +1,210 @@
+// Exact decimal arithmetic for nova: the Big constructor, nv.decimal, unit
+// and currency conversion, and DigitNumber's radix conversion.
+//
+// The decimal addon keeps coefficients in base-1e9 limbs, so long divisions,
+// square roots and sums over millions of values run without a JS object per
+// intermediate. Without the addon big.js and BigInt give the same results.
+const BigJS = require('big.js');
+const { optionalNative } = require('./nova-native');
+
+const Dec = () => optionalNative('decimal');
+
+// Operands below this many digits stay in big.js: the round trip through
+// the addon costs more than the digit loops it would save.
+const NATIVE_DIGITS = 60;
+
+// A separate constructor from require('big.js') with its own prototype, so
+// other users of the package keep stock big.js.
+const Big = BigJS();
+const P = Big.prototype;
+Big.prototype = Object.create(P);
+
+// "-12345e-2": what the addon reads and returns, and what big.js parses.
+const compact = (x) => (x.s < 0 ? '-' : '') + x.c.join('') + 'e' + (x.e - x.c.length + 1);
+const isBig = (v) => v !== null && typeof v === 'object' && Array.isArray(v.c);
+const arg = (v) => (isBig(v) ? compact(v) : v);
+
+const settingsOk = (C) => C.DP === ~~C.DP && C.DP >= 0 && C.DP <= 1e6 && C.RM === ~~C.RM && C.RM >= 0 && C.RM <= 3;
+
+// Each override hands the operation to the addon when it pays off and
+// otherwise to big.js, which also raises its own errors for bad input and
+// settings. DP and RM come from the value's own constructor, Big or one
+// made by privateBig().
+Big.prototype.times = Big.prototype.mul = function (y) {
+  const D = Dec(), C = this.constructor;
+  y = new C(y);
+  if (D && this.c.length + y.c.length > 2 * NATIVE_DIGITS) return new C(D.mul(compact(this), compact(y)));
+  return P.times.call(this, y);
+};
+
+Big.prototype.div = function (y) {
+  const D = Dec(), C = this.constructor;
+  y = new C(y);
+  if (D && y.c[0] !== 0 && settingsOk(C) && C.DP + this.c.length + y.c.length > NATIVE_DIGITS) {
+    return new C(D.div(compact(this), compact(y), C.DP, C.RM));
+  }
+  return P.div.call(this, y);
+};
+
+// big.js's digit-by-digit sqrt is slow at any precision and can stall at a
+// small Big.DP, so every valid sqrt goes to the addon.
+Big.prototype.sqrt = function () {
+  const D = Dec(), C = this.constructor;
+  if (D && this.s > 0 && settingsOk(C)) return new C(D.sqrt(compact(this), C.DP, C.RM));
+  return P.sqrt.call(this);
+};
+
+// A constructor with Big's methods but DP / RM of its own, for code that
+// needs its own precision without changing it for every other Big user.
+const privateBig = () => {
+  const C = BigJS();
+  C.prototype = Big.prototype;
+  return C;
+};
+
+// Exact total of an array (numbers, strings, bigints, Bigs) or Float64Array.
+Big.sum = (values) => new Big(sumCompact(values));
+
+// --- nv.decimal ---
+// Take numbers, numeric strings, bigints or Bigs; return plain decimal
+// strings ("0.3", never "3e-1"). dp / rm follow big.js: rm 0 down,
+// 1 half-up (default), 2 half-even, 3 up.
+
+// Fallback arithmetic, on a constructor whose DP / RM can be set per call.
+const B = BigJS();
+const big = (v) => new B(arg(v));
+const withDP = (dp, rm, f) => {
+  B.DP = dp;
+  B.RM = rm;
+  return f();
+};
+
+function add(a, b) {
+  const D = Dec();
+  return D ? D.toFixed(D.add(arg(a), arg(b))) : big(a).plus(big(b)).toFixed();
+}
+function sub(a, b) {
+  const D = Dec();
+  return D ? D.toFixed(D.sub(arg(a), arg(b))) : big(a).minus(big(b)).toFixed();
+}
+function mul(a, b) {
+  const D = Dec();
+  return D ? D.toFixed(D.mul(arg(a), arg(b))) : big(a).times(big(b)).toFixed();
+}
+function div(a, b, dp = 20, rm = 1) {
+  const D = Dec();
+  return D ? D.toFixed(D.div(arg(a), arg(b), dp, rm)) : withDP(dp, rm, () => big(a).div(big(b)).toFixed());
+}
+function mod(a, b) {
+  const D = Dec();
+  return D ? D.toFixed(D.mod(arg(a), arg(b))) : big(a).mod(big(b)).toFixed();
+}
+function sqrt(a, dp = 20, rm = 1) {
+  const D = Dec();
+  return D ? D.toFixed(D.sqrt(arg(a), dp, rm)) : withDP(dp, rm, () => big(a).sqrt().toFixed());
+}
+function pow(a, n, dp = 20, rm = 1) {
+  const D = Dec();
+  return D ? D.toFixed(D.pow(arg(a), n, dp, rm)) : withDP(dp, rm, () => big(a).pow(n).toFixed());
+}
+function round(a, dp = 0, rm = 1) {
+  const D = Dec();
+  return D ? D.toFixed(D.round(arg(a), dp, rm)) : big(a).round(dp, rm).toFixed();
+}
+function toFixed(a, dp, rm = 1) {
+  const D = Dec();
+  return D ? D.toFixed(arg(a), dp, rm) : big(a).toFixed(dp, rm);
+}
+function cmp(a, b) {
+  const D = Dec();
+  return D ? D.cmp(arg(a), arg(b)) : big(a).cmp(big(b));
+}
+
+// Bigs inside a plain array go over as compact strings; typed arrays and
+// arrays without objects pass through untouched.
+const bigsToStrings = (v) => (Array.isArray(v) && v.some((x) => x !== null && typeof x === 'object') ? v.map(arg) : arg(v));
+
+function sumCompact(values, dp, rm = 1) {
+  const D = Dec();
+  if (D) return D.sum(bigsToStrings(values), dp, rm);
+  let total = new B(0);
+  for (const v of values) total = total.plus(big(v));
+  return compact(dp === undefined ? total : total.round(dp, rm));
+}
+
+function sum(values, dp, rm = 1) {
+  return toFixed(sumCompact(values, dp, rm));
+}
+
+// Running exact total: acc.add(x) / acc.add([x, y, ...]) / acc.sub(...),
+// acc.value(dp?, rm?) -> string, acc.reset().
+class Accumulator {
+  constructor() {
+    const D = Dec();
+    this.native = D ? new D.Accumulator() : null;
+    this.total = new B(0);
+  }
+
+  add(v) {
+    if (this.native) this.native.add(bigsToStrings(v));
+    else for (const x of Array.isArray(v) || ArrayBuffer.isView(v) ? v : [v]) this.total = this.total.plus(big(x));
+    return this;
+  }
+
+  sub(v) {
+    if (this.native) this.native.sub(bigsToStrings(v));
+    else for (const x of Array.isArray(v) || ArrayBuffer.isView(v) ? v : [v]) this.total = this.total.minus(big(x));
+    return this;
+  }
+
+  value(dp, rm = 1) {
+    if (this.native) return toFixed(this.native.value(dp, rm));
+    return (dp === undefined ? this.total : this.total.round(dp, rm)).toFixed();
+  }
+
+  reset() {
+    if (this.native) this.native.reset();
+    this.total = new B(0);
+    return this;
+  }
+}
+
+// --- radix conversion (DigitNumber) ---
+
+// Digits of a non-negative integer (number, bigint or string) in base,
+// least significant first.
+function toBase(value, base) {
+  const D = Dec();
+  if (D) return Array.from(D.toBase(String(value), base));
+  const s = big(value).toFixed();
+  if (!/^\d+$/.test(s)) throw new Error('toBase expects a non-negative integer');
+  let x = BigInt(s);
+  const b = BigInt(base), digits = [];
+  do {
+    digits.push(Number(x % b));
+    x /= b;
+  } while (x > 0n);
+  return digits;
+}
+
+// The integer whose base digits (least significant first) are given, as a
+// decimal string.
+function fromBase(digits, base) {
+  const D = Dec();
+  if (D) return D.fromBase(digits, base);
+  const b = BigInt(base);
+  let x = 0n;
+  for (let i = digits.length - 1; i >= 0; i--) {
+    if (digits[i] < 0 || digits[i] >= base) throw new Error('Digit out of range for base');
+    x = x * b + BigInt(digits[i]);
+  }
+  return x.toString();
+}
+
+module.exports = {
+  Big, privateBig,
+  add, sub, mul, div, mod, sqrt, pow, round, toFixed, cmp, sum,
+  accumulator: () => new Accumulator(),
+  Accumulator,
+  toBase, fromBase,
+};
@@ -0,0 +1,211 @@
+// Recursive listing and content search for `listFiles(dir, { ... })`,
+// nv.fs.walk / nv.fs.grep and cli/nvfind.
+//
+// The walk addon lists and reads on a thread pool and only hands back the
+// lines that contain a literal every match must have (or whole files when a
+// regex has none); the regex itself runs here on those lines. Without the
+// addon the same options are served by a plain fs walk.
+const fs = require('fs');
+const path = require('path');
+const { optionalNative } = require('./nova-native');
+
+const Walk = () => optionalNative('walk');
+
+// "*.{js,ts}" -> ["*.js", "*.ts"]; the addon only knows * ** ? and [...].
+function expandBraces(glob) {
+  let depth = 0, open = -1;
+  for (let i = 0; i < glob.length; i++) {
+    const c = glob[i];
+    if (c === '\\') { i++; continue; }
+    if (c === '{' && depth++ === 0) open = i;
+    else if (c === '}' && depth > 0 && --depth === 0) {
+      const parts = [];
+      let d = 0, start = open + 1;
+      for (let j = open + 1; j < i; j++) {
+        if (glob[j] === '\\') j++;
+        else if (glob[j] === '{') d++;
+        else if (glob[j] === '}') d--;
+        else if (glob[j] === ',' && d === 0) { parts.push(glob.slice(start, j)); start = j + 1; }
+      }
+      parts.push(glob.slice(start, i));
+      if (parts.length < 2) continue;
+      const head = glob.slice(0, open), tail = glob.slice(i + 1);
+      return parts.flatMap((p) => expandBraces(head + p + tail));
+    }
+  }
+  return [glob];
+}
+
+const globList = (v) => (v == null || v === '' ? [] : [].concat(v)).flatMap((g) => expandBraces(String(g)));
+
+// Same rules as the addon: '*' and '?' stay within one path segment, '**'
+// crosses them, and a pattern without '/' is matched against the name only.
+function globToRegExp(glob) {
+  let re = '';
+  for (let i = 0; i < glob.length; i++) {
+    const c = glob[i];
+    if (c === '*' && glob[i + 1] === '*') {
+      if (glob[i + 2] === '/') { re += '(?:.*/)?'; i += 2; } else { re += '.*'; i++; }
+    } else if (c === '*') re += '[^/]*';
+    else if (c === '?') re += '[^/]';
+    else if (c === '[') {
+      const end = glob.indexOf(']', i + 2);
+      if (end < 0) { re += '\\['; continue; }
+      let body = glob.slice(i + 1, end).replace(/\\/g, '\\\\');
+      if (body[0] === '!') body = '^' + body.slice(1);
+      re += `(?!/)[${body}]`;
+      i = end;
+    } else {
+      if (c === '\\' && i + 1 < glob.length) i++;
+      re += glob[i].replace(/[.*+?^${}()|[\]\\/]/g, '\\$&');
+    }
+  }
+  return new RegExp(`^${re}$`, 's');
+}
+
+const globMatcher = (globs) => {
+  const compiled = globs.map((g) => ({ re: globToRegExp(g), full: g.includes('/') }));
+  return (name, rel) => compiled.some(({ re, full }) => re.test(full ? rel : name));
+};
+
+// The longest run of plain characters every match of `re` has to contain,
+// used as the native prefilter; '' when there is none (top-level '|').
+function requiredLiteral(re) {
+  const src = re.source;
+  let best = '', run = '';
+  const flush = () => { if (run.length > best.length) best = run; run = ''; };
+  for (let i = 0; i < src.length; i++) {
+    const c = src[i];
+    if (c === '|') return '';
+    if (c === '\\') {
+      const esc = /^\\(?:x[0-9a-fA-F]{2}|u\{[0-9a-fA-F]+\}|u[0-9a-fA-F]{4}|[pP]\{[^}]*\}|k<[^>]*>|c[A-Za-z]|\d+|[A-Za-z])/.exec(src.slice(i));
+      if (esc) { flush(); i += esc[0].length - 1; continue; }
+      run += src[++i] ?? '';
+    } else if (c === '(') {
+      flush();
+      // skip the group: anything inside may be optional or alternated
+      for (let depth = 1; depth && ++i < src.length;) {
+        if (src[i] === '\\') i++;
+        else if (src[i] === '[') { while (++i < src.length && src[i] !== ']') if (src[i] === '\\') i++; }
+        else if (src[i] === '(') depth++;
+        else if (src[i] === ')') depth--;
+      }
+    } else if (c === '[') {
+      flush();
+      while (++i < src.length && src[i] !== ']') if (src[i] === '\\') i++;
+    } else if (c === '*' || c === '?') {
+      run = run.slice(0, -1);
+      flush();
+    } else if (c === '{' && /^\{\d+(,\d*)?\}/.test(src.slice(i))) {
+      if (/^\{0[,}]/.test(src.slice(i))) run = run.slice(0, -1);
+      flush();
+      i = src.indexOf('}', i);
+    } else if (c === '+' || c === '.' || c === '^' || c === '$') {
+      flush();
+    } else {
+      run += c;
+    }
+  }
+  flush();
+  // ASCII case folding only in the addon
+  return re.flags.includes('i') && /[^\x00-\x7f]/.test(best) ? '' : best;
+}
+
+function walkOptions(opts = {}) {
+  return {
+    pattern: globList(opts.pattern),
+    ignore: globList(opts.ignore),
+    hidden: !!opts.hidden,
+    maxDepth: Number.isInteger(opts.maxDepth) ? opts.maxDepth : opts.recursive ? -1 : 1,
+    type: opts.type === 'dir' || opts.type === 'all' ? opts.type : 'file',
+    ...(opts.threads ? { threads: Number(opts.threads) } : {}),
+  };
+}
+
+function walkJS(root, o, onFile) {
+  const include = o.pattern.length ? globMatcher(o.pattern) : null;
+  const exclude = o.ignore.length ? globMatcher(o.ignore) : null;
+  const out = [];
+  const stack = [['', 0]];
+  while (stack.length) {
+    const [rel, depth] = stack.pop();
+    let entries;
+    try {
+      entries = fs.readdirSync(rel ? path.join(root, rel) : root, { withFileTypes: true });
+    } catch (e) {
+      if (!rel) throw e;
+      continue;
+    }
+    for (const e of entries) {
+      if (e.name[0] === '.' && !o.hidden) continue;
+      const r = rel ? `${rel}/${e.name}` : e.name;
+      if (exclude && exclude(e.name, r)) continue;
+      const wanted = !include || include(e.name, r);
+      if (e.isDirectory()) {
+        if (o.type !== 'file' && wanted && !onFile) out.push(r);
+        if (o.maxDepth < 0 || depth + 1 < o.maxDepth) stack.push([r, depth + 1]);
+      } else if (o.type !== 'dir' && wanted) {
+        if (onFile) onFile(r, out); else out.push(r);
+      }
+    }
+  }
+  return onFile ? out.sort((a, b) => (a.file < b.file ? -1 : a.file > b.file ? 1 : 0)) : out.sort();
+}
+
+// search(root, query, opts) -> [{ file, line, text }]
+// query: a RegExp or a plain substring (opts.ignoreCase for ASCII folding).
+function search(root, query, opts = {}) {
+  const o = walkOptions({ recursive: true, ...opts });
+  const re = query instanceof RegExp ? new RegExp(query.source, query.flags.replace(/[gy]/g, '')) : null;
+  const needle = re ? requiredLiteral(re) : String(query);
+  const ignoreCase = re ? re.flags.includes('i') : !!opts.ignoreCase;
+  const maxFileSize = opts.maxFileSize || 64 << 20;
+  const folded = needle.toLowerCase();
+  const test = re ? (line) => re.test(line)
+    : ignoreCase ? (line) => line.toLowerCase().includes(folded) : (line) => line.includes(needle);
+
+  const addon = Walk();
+  const raw = addon
+    ? addon.search(root, { ...o, needle, ignoreCase, maxFileSize })
+    : walkJS(root, o, (file, out) => {
+      let text;
+      try {
+        const buf = fs.readFileSync(path.join(root, file));
+        if (buf.length > maxFileSize || buf.subarray(0, 8192).includes(0)) return;
+        text = buf.toString('utf8');
+      } catch { return; }
+      if (needle && !(ignoreCase ? text.toLowerCase() : text).includes(ignoreCase ? folded : needle)) return;
+      out.push({ file, line: 0, text });
+    });
+
+  const hits = [];
+  for (const hit of raw) {
+    if (hit.line) {
+      if (!re || test(hit.text)) hits.push(hit);
+      continue;
+    }
+    // whole file: no usable literal, or the JS fallback
+    const lines = hit.text.split('\n');
+    if (lines[lines.length - 1] === '') lines.pop();
+    lines.forEach((text, i) => {
+      if (text.endsWith('\r')) text = text.slice(0, -1);
+      if (test(text)) hits.push({ file: hit.file, line: i + 1, text });
+    });
+  }
+  return hits;
+}
+
+// list(root, { recursive, pattern, ignore, hidden, maxDepth, type, contains, match })
+// -> paths relative to root, sorted. contains/match keep files whose content
+// has the substring / matches the regex source.
+function list(root, opts = {}) {
+  if (opts.contains != null || opts.match != null) {
+    const query = opts.match != null ? new RegExp(opts.match, opts.ignoreCase ? 'i' : '') : String(opts.contains);
+    return [...new Set(search(root, query, { recursive: false, ...opts, type: 'file' }).map((h) => h.file))];
+  }
+  const o = walkOptions(opts);
+  const addon = Walk();
+  return addon ? addon.walk(root, o) : walkJS(root, o);
+}
+
+module.exports = { list, search, expandBraces, globToRegExp, requiredLiteral };
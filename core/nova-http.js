@@ -0,0 +1,122 @@
+// In-process HTTP client for the `http` keyword.
+//
+// Requests go through per-protocol keep-alive agents, so repeated calls to a
+// host reuse pooled sockets (and TLS sessions) instead of forking curl for
+// every request. Up to `maxSockets` requests per host are in flight at once;
+// the rest queue on the agent. The blocking form pumps the event loop
+// natively until the response is complete, or runs curl when the async
+// addon is not built.
+const http = require('http');
+const https = require('https');
+const { execFileSync } = require('child_process');
+const { optionalNative } = require('./nova-native');
+
+const agentOptions = { keepAlive: true, keepAliveMsecs: 1000, maxSockets: 64, maxFreeSockets: 16 };
+const agents = {
+  'http:': new http.Agent(agentOptions),
+  'https:': new https.Agent(agentOptions),
+};
+
+function configure({ maxSockets, maxFreeSockets, keepAlive } = {}) {
+  for (const agent of Object.values(agents)) {
+    if (maxSockets !== undefined) agent.maxSockets = maxSockets;
+    if (maxFreeSockets !== undefined) agent.maxFreeSockets = maxFreeSockets;
+    if (keepAlive !== undefined) agent.keepAlive = keepAlive;
+  }
+}
+
+// request(method, url, { headers, body, timeout, onData }) -> Promise<{ status, headers, body }>
+// With onData the body is streamed chunk by chunk and not buffered.
+function request(method, url, opts = {}) {
+  return new Promise((resolve, reject) => {
+    let target;
+    try { target = new URL(url); } catch { return reject(new Error(`Invalid URL: ${url}`)); }
+    const transport = target.protocol === 'https:' ? https : target.protocol === 'http:' ? http : null;
+    if (!transport) return reject(new Error(`Unsupported protocol: ${target.protocol}`));
+
+    const { headers, body } = prepare(opts);
+    if (body) headers['Content-Length'] = body.length;
+
+    const req = transport.request(target, {
+      method: String(method || 'GET').toUpperCase(),
+      headers,
+      agent: agents[target.protocol],
+      timeout: opts.timeout,
+    }, (res) => {
+      const chunks = [];
+      res.on('data', (chunk) => (opts.onData ? opts.onData(chunk) : chunks.push(chunk)));
+      res.on('error', reject);
+      res.on('end', () => resolve({
+        status: res.statusCode,
+        headers: res.headers,
+        body: opts.onData ? '' : Buffer.concat(chunks).toString(opts.encoding || 'utf8'),
+      }));
+    });
+    req.on('timeout', () => req.destroy(new Error(`Request timed out after ${opts.timeout}ms`)));
+    req.on('error', reject);
+    req.end(body);
+  });
+}
+
+function hasHeader(headers, name) {
+  return Object.keys(headers).some(k => k.toLowerCase() === name);
+}
+
+// Headers and body Buffer (or null) to send for opts.
+function prepare(opts) {
+  const headers = { ...(opts.headers || {}) };
+  let body = opts.body;
+  if (body === undefined || body === null || body === '') return { headers, body: null };
+  if (typeof body === 'object' && !Buffer.isBuffer(body)) {
+    body = JSON.stringify(body);
+    if (!hasHeader(headers, 'content-type')) headers['Content-Type'] = 'application/json';
+  }
+  body = Buffer.isBuffer(body) ? body : Buffer.from(String(body));
+  // Same default curl used for --data.
+  if (!hasHeader(headers, 'content-type')) headers['Content-Type'] = 'application/x-www-form-urlencoded';
+  return { headers, body };
+}
+
+// Blocking form: pumps the loop with the async addon, else runs curl as the
+// `http` keyword did before this client existed (no pooled sockets, no onData).
+function requestSync(method, url, opts = {}) {
+  const native = optionalNative('async');
+  if (native?.awaitBlock) return native.awaitBlock(request(method, url, opts));
+  return curlSync(method, url, opts);
+}
+
+function curlSync(method, url, opts) {
+  const { headers, body } = prepare(opts);
+  const args = ['-sS', '-D', '-', '-X', String(method || 'GET').toUpperCase()];
+  for (const [k, v] of Object.entries(headers)) args.push('-H', `${k}: ${v}`);
+  if (body) args.push('--data-binary', '@-');
+  if (opts.timeout) args.push('--max-time', String(opts.timeout / 1000));
+  args.push('--', url);
+  let out;
+  try {
+    out = execFileSync('curl', args, { input: body || '', maxBuffer: 1 << 30, stdio: 'pipe' });
+  } catch (e) {
+    throw new Error(String(e.stderr || e.message).trim());
+  }
+  // -D - writes the header block(s) first; a 100 Continue comes before the real one.
+  let start = 0, status = 0, responseHeaders = {};
+  for (;;) {
+    const end = out.indexOf('\r\n\r\n', start);
+    if (end < 0) break;
+    const lines = out.subarray(start, end).toString('latin1').split('\r\n');
+    status = Number(lines[0].split(' ')[1]);
+    responseHeaders = {};
+    for (const line of lines.slice(1)) {
+      const colon = line.indexOf(':');
+      if (colon > 0) responseHeaders[line.slice(0, colon).trim().toLowerCase()] = line.slice(colon + 1).trim();
+    }
+    start = end + 4;
+    if (status >= 200 || !out.subarray(start, start + 5).equals(Buffer.from('HTTP/'))) break;
+  }
+  return { status, headers: responseHeaders, body: out.subarray(start).toString(opts.encoding || 'utf8') };
+}
+
+// all([[method, url, opts], ...]) -> Promise of responses, issued concurrently.
+const all = (requests) => Promise.all(requests.map(([method, url, opts]) => request(method, url, opts)));
+
+module.exports = { request, requestSync, all, configure, agents };
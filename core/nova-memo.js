@@ -0,0 +1,342 @@
+// Memoization for nova: Memoize(fn, opts), `memoize (x) { ... }` and the
+// `memo func` modifier.
+//
+// A cache keys each call by a canonical encoding of its arguments: numbers,
+// strings and other primitives by type and value, arrays and plain objects
+// by contents with object keys sorted, Maps and Sets by their entries in any
+// order, typed arrays by their bytes, and functions and symbols by identity.
+// It holds at most `capacity` results, evicting the least recently (lru) or
+// least frequently (lfu) used, and with a `ttl` in milliseconds drops ones
+// older than that. With the memo addon the key is hashed with XXH64 and the
+// table and its eviction lists live in native code, and typed arrays are
+// keyed by hashing their bytes in place; without it the JsCache here keeps
+// the same semantics with string keys in a Map.
+const { optionalNative } = require('./nova-native');
+
+const Native = () => optionalNative('memo');
+
+// Deeper arguments, usually cyclic ones, are not cached: the call just runs.
+const MAX_DEPTH = 32;
+const UNCACHEABLE = Symbol('uncacheable');
+
+const objectIds = new WeakMap();
+const symbolIds = new Map();
+let nextId = 1;
+
+const identity = (v) => {
+  const ids = typeof v === 'symbol' ? symbolIds : objectIds;
+  let id = ids.get(v);
+  if (id === undefined) ids.set(v, (id = nextId++));
+  return id;
+};
+
+const str = (s) => s.length + ':' + s;
+
+function keyOf(v, depth) {
+  if (depth > MAX_DEPTH) throw UNCACHEABLE;
+  switch (typeof v) {
+    case 'undefined': return 'u';
+    case 'boolean': return v ? 't' : 'f';
+    case 'number': return 'd' + (v === 0 ? 0 : v);
+    case 'string': return 's' + str(v);
+    case 'bigint': return 'g' + v;
+    case 'object': break;
+    default: return 'i' + identity(v);
+  }
+  if (v === null) return 'n';
+  if (Array.isArray(v)) {
+    let out = 'a' + v.length + '[';
+    for (let i = 0; i < v.length; i++) out += keyOf(v[i], depth + 1) + ',';
+    return out + ']';
+  }
+  if (ArrayBuffer.isView(v)) {
+    return 'T' + v.constructor.name + str(Buffer.from(v.buffer, v.byteOffset, v.byteLength).toString('latin1'));
+  }
+  if (v instanceof ArrayBuffer) return 'B' + str(Buffer.from(v).toString('latin1'));
+  if (v instanceof Date) return 'D' + v.getTime();
+  if (v instanceof Promise) return 'i' + identity(v);
+  if (v instanceof Map || v instanceof Set) {
+    const parts = Array.from(v, (e) => keyOf(e, depth + 1)).sort();
+    return (v instanceof Map ? 'M' : 'S') + parts.length + '[' + parts.join(',') + ']';
+  }
+  const keys = Object.keys(v);
+  for (let i = 1; i < keys.length; i++) {
+    if (keys[i - 1] > keys[i]) {
+      keys.sort();
+      break;
+    }
+  }
+  let out = 'o' + keys.length + '{';
+  for (const k of keys) out += str(k) + keyOf(v[k], depth + 1) + ',';
+  return out + '}';
+}
+
+// The same interface as the addon's MemoCache, see natives/memo/src/addon.cpp:
+// lookup(...args) -> slot | -1 (miss) | -2 (uncacheable), store(),
+// abandon(), delete(...args), clear(), stats(); find(args) is lookup with
+// the arguments as an array.
+class JsCache {
+  constructor({ capacity = 10000, policy = 'lru', ttl = 0 } = {}) {
+    if (!(capacity >= 1)) throw new TypeError('capacity must be at least 1');
+    if (policy !== 'lru' && policy !== 'lfu') throw new TypeError("policy must be 'lru' or 'lfu'");
+    this.capacity = Math.min(Math.floor(capacity), 4294967294);
+    this.policy = policy;
+    this.ttl = Math.max(0, ttl || 0);
+    this.entries = new Map();   // key -> { slot, freq, expires }; lru order
+    this.buckets = new Map();   // lfu: freq -> Set of keys, oldest first
+    this.minFreq = 0;
+    this.free = [];
+    this.slots = 0;
+    this.pending = [];
+    this.counts = { hits: 0, misses: 0, evictions: 0, expired: 0, uncacheable: 0 };
+  }
+
+  key(args) {
+    try {
+      let out = 'A' + args.length;
+      for (const a of args) out += keyOf(a, 0) + ',';
+      return out;
+    } catch (e) {
+      if (e === UNCACHEABLE) return null;
+      throw e;
+    }
+  }
+
+  lookup(...args) {
+    return this.find(args);
+  }
+
+  find(args) {
+    const key = this.key(args);
+    if (key === null) {
+      this.counts.uncacheable++;
+      return -2;
+    }
+    let e = this.entries.get(key);
+    if (e && this.ttl > 0 && Date.now() >= e.expires) {
+      this.remove(key, e);
+      this.counts.expired++;
+      e = undefined;
+    }
+    if (!e) {
+      this.counts.misses++;
+      this.pending.push(key);
+      return -1;
+    }
+    this.counts.hits++;
+    if (this.policy === 'lru') {
+      this.entries.delete(key);
+      this.entries.set(key, e);
+    } else {
+      const bucket = this.buckets.get(e.freq);
+      bucket.delete(key);
+      if (bucket.size === 0) {
+        this.buckets.delete(e.freq);
+        if (this.minFreq === e.freq) this.minFreq++;
+      }
+      this.bucket(++e.freq).add(key);
+    }
+    return e.slot;
+  }
+
+  store() {
+    if (this.pending.length === 0) throw new TypeError('store() without a missed lookup()');
+    const key = this.pending.pop();
+    let e = this.entries.get(key);
+    if (!e) {
+      if (this.entries.size >= this.capacity) this.evict();
+      e = { slot: this.free.length ? this.free.pop() : this.slots++, freq: 0, expires: 0 };
+      this.entries.set(key, e);
+      if (this.policy === 'lfu') {
+        this.bucket(0).add(key);
+        this.minFreq = 0;
+      }
+    }
+    if (this.ttl > 0) e.expires = Date.now() + this.ttl;
+    return e.slot;
+  }
+
+  abandon() {
+    this.pending.pop();
+  }
+
+  delete(...args) {
+    const key = this.key(args);
+    const e = key !== null && this.entries.get(key);
+    if (!e) return -1;
+    this.remove(key, e);
+    return e.slot;
+  }
+
+  clear() {
+    this.entries.clear();
+    this.buckets.clear();
+    this.free = [];
+    this.slots = 0;
+    this.minFreq = 0;
+    return this;
+  }
+
+  stats() {
+    return { ...this.counts, size: this.entries.size, capacity: this.capacity, policy: this.policy, ttl: this.ttl };
+  }
+
+  bucket(freq) {
+    let b = this.buckets.get(freq);
+    if (!b) this.buckets.set(freq, (b = new Set()));
+    return b;
+  }
+
+  remove(key, e) {
+    this.entries.delete(key);
+    this.free.push(e.slot);
+    if (this.policy === 'lfu') {
+      const bucket = this.buckets.get(e.freq);
+      bucket.delete(key);
+      if (bucket.size === 0) this.buckets.delete(e.freq);
+    }
+  }
+
+  evict() {
+    let key;
+    if (this.policy === 'lru') {
+      key = this.entries.keys().next().value;
+    } else {
+      if (!this.buckets.has(this.minFreq)) this.minFreq = Math.min(...this.buckets.keys());
+      key = this.buckets.get(this.minFreq).values().next().value;
+    }
+    const e = this.entries.get(key);
+    if (this.ttl > 0 && Date.now() >= e.expires) this.counts.expired++;
+    else this.counts.evictions++;
+    this.remove(key, e);
+  }
+}
+
+// Arguments the addon keys faster than keyOf: primitives and raw bytes.
+const isFlat = (v) => (typeof v !== 'object' && typeof v !== 'function' && typeof v !== 'symbol') || v === null ||
+  ArrayBuffer.isView(v) || v instanceof ArrayBuffer;
+
+// The addon's MemoCache behind the JsCache interface. Reading an object's
+// properties through N-API costs far more than in JS, so objects, arrays,
+// Maps, Sets and identities are keyed here with keyOf and only flat values
+// cross as they are: lookup(shape, ...flat), where shape holds '#' for each
+// flat argument and the keyOf text of each other one.
+class NativeCache {
+  constructor(opts) {
+    this.cache = new (Native().MemoCache)(opts);
+    this.uncacheable = 0;
+  }
+
+  args(args) {
+    let shape = '';
+    const out = [shape];
+    for (const a of args) {
+      if (isFlat(a)) {
+        shape += '#';
+        out.push(a);
+        continue;
+      }
+      try {
+        shape += keyOf(a, 0);
+      } catch (e) {
+        if (e === UNCACHEABLE) return null;
+        throw e;
+      }
+    }
+    out[0] = shape;
+    return out;
+  }
+
+  lookup(...args) {
+    return this.find(args);
+  }
+
+  // A lone flat argument that is not a string goes across by itself: no
+  // shaped call starts with anything but the shape string.
+  find(args) {
+    if (args.length === 1 && typeof args[0] !== 'string' && isFlat(args[0])) return this.cache.lookup(args[0]);
+    const keyed = this.args(args);
+    if (keyed === null) {
+      this.uncacheable++;
+      return -2;
+    }
+    // spread calls into the addon take a slow path in V8
+    switch (keyed.length) {
+      case 1: return this.cache.lookup(keyed[0]);
+      case 2: return this.cache.lookup(keyed[0], keyed[1]);
+      case 3: return this.cache.lookup(keyed[0], keyed[1], keyed[2]);
+      default: return this.cache.lookup(...keyed);
+    }
+  }
+
+  store() { return this.cache.store(); }
+  abandon() { this.cache.abandon(); }
+
+  delete(...args) {
+    if (args.length === 1 && typeof args[0] !== 'string' && isFlat(args[0])) return this.cache.delete(args[0]);
+    const keyed = this.args(args);
+    return keyed === null ? -1 : this.cache.delete(...keyed);
+  }
+
+  clear() {
+    this.cache.clear();
+    return this;
+  }
+
+  stats() {
+    const stats = this.cache.stats();
+    stats.uncacheable += this.uncacheable;
+    return stats;
+  }
+}
+
+// Memoize(fn, { capacity, policy, ttl }) or Memoize(fn, capacity). The
+// result has .original, .stats(), .clear() and .delete(...args). A call that
+// throws is not cached, nor is a promise once it rejects.
+function Memoize(fn, opts = {}) {
+  if (typeof opts === 'number') opts = { capacity: opts };
+  const cache = Native() ? new NativeCache(opts) : new JsCache(opts);
+  let values = [];
+
+  const memo = function (...args) {
+    const slot = cache.find(args);
+    if (slot >= 0) return values[slot];
+    if (slot === -2) return fn.apply(this, args);
+    let value;
+    try {
+      value = fn.apply(this, args);
+    } catch (e) {
+      cache.abandon();
+      throw e;
+    }
+    values[cache.store()] = value;
+    if (value instanceof Promise) value.catch(() => memo.delete(...args));
+    return value;
+  };
+
+  memo.original = fn;
+  memo.cache = cache;
+  memo.stats = () => cache.stats();
+  memo.clear = () => {
+    cache.clear();
+    values = [];
+    return memo;
+  };
+  memo.delete = (...args) => {
+    const slot = cache.delete(...args);
+    if (slot < 0) return false;
+    values[slot] = undefined;
+    return true;
+  };
+  return memo;
+}
+
+// The 16 hex digit hash of the arguments' key, or undefined when they are
+// uncacheable; needs the addon.
+const hash = (...args) => {
+  const n = Native();
+  if (!n) throw new Error('nv.memo.hash needs the memo addon (natives/memo)');
+  return n.hash(...args);
+};
+
+module.exports = { Memoize, JsCache, NativeCache, hash };
@@ -0,0 +1,13 @@
+// Natives that the runtime can work without: optionalNative(name) is the
+// addon from natives/<name>, or null when it isn't built. The require is
+// tried once per name.
+const loaded = {};
+
+function optionalNative(name) {
+  if (!(name in loaded)) {
+    try { loaded[name] = require(`../natives/${name}`); } catch { loaded[name] = null; }
+  }
+  return loaded[name];
+}
+
+module.exports = { optionalNative };
@@ -0,0 +1,215 @@
+// Pool of pre-warmed Nova interpreters living in worker_threads.
+//
+// Each worker loads its own interpreter once and keeps it between jobs.
+// Jobs go out over a MessageChannel; the worker bumps a shared counter when
+// a reply is posted, so the parent can block on Atomics.wait and then pick
+// the reply up synchronously with receiveMessageOnPort. A worker that exits
+// sets the second word and bumps the counter on its way out, so a parent
+// blocked in wait() wakes up, fails that worker's jobs and replaces it.
+const os = require('os');
+const {
+  Worker, MessageChannel, receiveMessageOnPort, isMainThread, workerData,
+} = require('worker_threads');
+
+const { Range } = require('./nova-arrays');
+
+const isTypedArray = (v) => ArrayBuffer.isView(v) && !(v instanceof DataView);
+
+// A lazy range would arrive as a bare object, so it crosses as the typed
+// array it stands for.
+function materializeRanges(vars) {
+  if (!vars || !Object.values(vars).some((v) => v instanceof Range)) return vars;
+  const out = { ...vars };
+  for (const [k, v] of Object.entries(out)) if (v instanceof Range) out[k] = v.toTypedArray();
+  return out;
+}
+
+// Drop values that can't cross a thread boundary (functions, class instances
+// holding natives, ...) instead of failing the whole job.
+function cloneable(vars) {
+  const out = {};
+  for (const [k, v] of Object.entries(materializeRanges(vars))) {
+    if (typeof v === 'function' || typeof v === 'symbol') continue;
+    try { structuredClone(v); out[k] = v; } catch { /* not transferable */ }
+  }
+  return out;
+}
+
+function transferables(vars) {
+  const list = [];
+  for (const v of Object.values(vars)) {
+    if (isTypedArray(v) && v.buffer instanceof ArrayBuffer && !list.includes(v.buffer)) list.push(v.buffer);
+  }
+  return list;
+}
+
+function post(port, msg, transfer) {
+  msg.vars = materializeRanges(msg.vars);
+  try {
+    port.postMessage(msg, transfer);
+  } catch {
+    msg.vars = cloneable(msg.vars);
+    port.postMessage(msg, transfer.filter(b => Object.values(msg.vars).some(v => v && v.buffer === b)));
+  }
+}
+
+class NovaPool {
+  constructor(size = os.cpus().length) {
+    this.slots = [];
+    this.closed = false;
+    for (let i = 0; i < Math.max(1, size); i++) this.slots.push(this._spawn());
+    this.nextSlot = 0;
+    this.nextId = 1;
+  }
+
+  _spawn() {
+    const { port1, port2 } = new MessageChannel();
+    // [replies posted, worker gone]
+    const signal = new Int32Array(new SharedArrayBuffer(8));
+    const worker = new Worker(__filename, {
+      workerData: { novaPool: true, port: port2, signal },
+      transferList: [port2],
+    });
+    worker.unref();
+    const slot = { worker, port: port1, signal, posted: 0, stash: new Map(), pending: new Set(), dead: false };
+    // Seen when the parent is not blocked in wait(): a worker dying between jobs.
+    worker.on('error', (e) => this._died(slot, `failed: ${e && e.message || e}`));
+    worker.on('exit', (code) => this._died(slot, `exited with code ${code}`));
+    return slot;
+  }
+
+  _drain(slot) {
+    let msg;
+    while ((msg = receiveMessageOnPort(slot.port))) {
+      slot.stash.set(msg.message.id, msg.message);
+      slot.pending.delete(msg.message.id);
+    }
+  }
+
+  // Fails the jobs a dead worker still owed and puts a fresh worker in its
+  // place; the new slot keeps the stash, so waiting on those jobs throws.
+  _died(slot, why) {
+    if (slot.dead) return;
+    slot.dead = true;
+    this._drain(slot);
+    for (const id of slot.pending) slot.stash.set(id, { id, error: `Pool worker ${why}` });
+    slot.pending.clear();
+    slot.worker.terminate();
+    const i = this.slots.indexOf(slot);
+    if (i < 0 || this.closed) return;
+    const fresh = this._spawn();
+    fresh.stash = slot.stash;
+    this.slots[i] = fresh;
+  }
+
+  get size() { return this.slots.length; }
+
+  // Queue a block; typed arrays in vars are moved (not copied) when transfer is set.
+  submit(code, vars = {}, index = 0, transfer = false) {
+    if (Atomics.load(this.slots[this.nextSlot].signal, 1) !== 0) this._died(this.slots[this.nextSlot], 'exited');
+    const slot = this.slots[this.nextSlot];
+    this.nextSlot = (this.nextSlot + 1) % this.slots.length;
+    const id = this.nextId++;
+    post(slot.port, { id, code, vars, index }, transfer ? transferables(vars) : []);
+    slot.posted++;
+    slot.pending.add(id);
+    return { id, slot: this.slots.indexOf(slot), seq: slot.posted };
+  }
+
+  // Blocks the calling thread until the job behind handle has finished.
+  wait(handle) {
+    for (;;) {
+      const slot = this.slots[handle.slot];
+      if (slot.stash.has(handle.id)) {
+        const reply = slot.stash.get(handle.id);
+        slot.stash.delete(handle.id);
+        if (reply.error !== undefined) throw reply.error;
+        return reply;
+      }
+      const done = Atomics.load(slot.signal, 0);
+      const gone = Atomics.load(slot.signal, 1) !== 0;
+      if (done < handle.seq && !gone) {
+        Atomics.wait(slot.signal, 0, done);
+        continue;
+      }
+      this._drain(slot);
+      if (gone && !slot.stash.has(handle.id)) this._died(slot, 'exited');
+    }
+  }
+
+  // Runs code `count` times across the pool (index 0..count-1) and joins.
+  map(count, code, vars = {}) {
+    const handles = [];
+    for (let i = 0; i < count; i++) handles.push(this.submit(code, vars, i));
+    // Collect every reply before throwing, so none is left behind in a stash.
+    let failed = null;
+    const replies = handles.map((h) => {
+      try { return this.wait(h); } catch (e) { failed ??= { e }; }
+    });
+    if (failed) throw failed.e;
+    return replies;
+  }
+
+  terminate() {
+    this.closed = true;
+    for (const s of this.slots) s.worker.terminate();
+    this.slots = [];
+  }
+}
+
+let shared = null;
+const getPool = () => (shared ??= new NovaPool());
+
+// ---------- worker side ----------
+if (!isMainThread && workerData && workerData.novaPool) {
+  const { port, signal } = workerData;
+  const { env } = require('./nova.js');
+  const baseline = new Set(Object.keys(env.maps));
+
+  const reply = (msg, transfer = []) => {
+    try {
+      port.postMessage(msg, transfer);
+    } catch {
+      msg.vars = cloneable(msg.vars || {});
+      port.postMessage(msg);
+    }
+    Atomics.add(signal, 0, 1);
+    Atomics.notify(signal, 0);
+  };
+
+  process.on('exit', () => {
+    Atomics.store(signal, 1, 1);
+    Atomics.add(signal, 0, 1);
+    Atomics.notify(signal, 0);
+  });
+
+  let current = null;
+  process.on('uncaughtException', (e) => {
+    if (current !== null) reply({ id: current, error: String(e && e.message || e) });
+    current = null;
+  });
+
+  port.on('message', ({ id, code, vars, index }) => {
+    current = id;
+    let msg;
+    try {
+      Object.assign(env.maps, vars);
+      env.maps.i = index;
+      const output = env.run(code);
+      const out = {};
+      for (const k of Object.keys(env.maps)) {
+        if (k !== 'i' && !baseline.has(k)) out[k] = env.maps[k];
+      }
+      msg = { id, output: typeof output === 'function' ? undefined : output, vars: cloneable(out) };
+    } catch (e) {
+      msg = { id, error: String(e && e.message || e) };
+    } finally {
+      // Keep the interpreter warm but don't leak one job's variables into the next.
+      for (const k of Object.keys(env.maps)) if (!baseline.has(k)) delete env.maps[k];
+    }
+    current = null;
+    reply(msg, msg.vars ? transferables(msg.vars) : []);
+  });
+}
+
+module.exports = { NovaPool, getPool };
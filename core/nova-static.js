@@ -0,0 +1,210 @@
+// Static files for `server` blocks: the `static(dir)` route and the
+// `sendFile(path)` handler helper.
+//
+// Files go from disk to the socket as Buffers (streamed for big files), never
+// through a JS string. Small hot files live in a byte-bounded LRU together with
+// gzip/brotli variants compressed once, so a repeat hit is one stat plus one
+// write. Responses carry ETag/Last-Modified (conditional GETs get 304) and
+// single byte ranges get 206.
+const fs = require('fs');
+const path = require('path');
+const zlib = require('zlib');
+const util = require('util');
+const mime = require('mime-types');
+
+const defaults = {
+  maxAge: 0,                  // Cache-Control max-age, seconds
+  cacheBytes: 32 << 20,       // LRU budget, counting compressed variants
+  maxCachedFile: 256 << 10,   // bigger files are always streamed
+  compressMin: 1024,          // don't bother compressing tiny files
+  highWaterMark: 256 << 10,   // read size when streaming
+  index: 'index.html',
+};
+
+const compressible = (type) => /^text\/|[+/](json|javascript|xml)\b|^image\/svg/.test(type);
+
+// LRU keyed by absolute path; Map iteration order doubles as recency.
+class FileCache {
+  constructor(limit) {
+    this.limit = limit;
+    this.bytes = 0;
+    this.entries = new Map();
+  }
+  get(key, stat) {
+    const entry = this.entries.get(key);
+    if (!entry) return null;
+    this.entries.delete(key);
+    if (entry.mtimeMs !== stat.mtimeMs || entry.size !== stat.size) {
+      this.bytes -= entry.bytes;
+      return null;
+    }
+    this.entries.set(key, entry);
+    return entry;
+  }
+  set(key, entry) {
+    const old = this.entries.get(key);
+    if (old) { this.bytes -= old.bytes; this.entries.delete(key); }
+    if (entry.bytes > this.limit) return;
+    this.entries.set(key, entry);
+    this.bytes += entry.bytes;
+    for (const [k, e] of this.entries) {
+      if (this.bytes <= this.limit) break;
+      this.entries.delete(k);
+      this.bytes -= e.bytes;
+    }
+  }
+  clear() { this.entries.clear(); this.bytes = 0; }
+}
+
+const cache = new FileCache(defaults.cacheBytes);
+const pending = new Map(); // path -> Promise<entry>, so a cold file is read once
+
+const etagFor = (stat) => `"${stat.size.toString(16)}-${Math.floor(stat.mtimeMs).toString(16)}"`;
+
+async function loadEntry(file, stat, type, opts) {
+  const body = await fs.promises.readFile(file);
+  const entry = { mtimeMs: stat.mtimeMs, size: stat.size, body, gzip: null, br: null, bytes: body.length };
+  if (compressible(type) && body.length >= opts.compressMin) {
+    const [gzip, br] = await Promise.all([
+      util.promisify(zlib.gzip)(body, { level: 9 }),
+      util.promisify(zlib.brotliCompress)(body, {
+        params: { [zlib.constants.BROTLI_PARAM_QUALITY]: 9, [zlib.constants.BROTLI_PARAM_SIZE_HINT]: body.length },
+      }),
+    ]);
+    if (gzip.length < body.length) { entry.gzip = gzip; entry.bytes += gzip.length; }
+    if (br.length < body.length) { entry.br = br; entry.bytes += br.length; }
+  }
+  return entry;
+}
+
+function cachedEntry(file, stat, type, opts) {
+  const hit = cache.get(file, stat);
+  if (hit) return hit;
+  let load = pending.get(file);
+  if (!load) {
+    load = loadEntry(file, stat, type, opts).finally(() => pending.delete(file));
+    load.then((entry) => cache.set(file, entry), () => { });
+    pending.set(file, load);
+  }
+  return load;
+}
+
+function isFresh(req, etag, mtimeMs) {
+  const inm = req.headers['if-none-match'];
+  if (inm) {
+    if (inm.trim() === '*') return true;
+    const base = etag.slice(0, -1);
+    return inm.split(',').some((tag) => {
+      tag = tag.trim().replace(/^W\//, '');
+      return tag === etag || tag.startsWith(base + '-');
+    });
+  }
+  const ims = Date.parse(req.headers['if-modified-since']);
+  return !isNaN(ims) && Math.floor(mtimeMs / 1000) * 1000 <= ims;
+}
+
+// Single `bytes=a-b` range -> { start, end }, -1 if unsatisfiable, null to
+// send the whole file (no header, If-Range mismatch or a multi-range request).
+function parseRange(req, size, etag, mtimeMs) {
+  const header = req.headers.range;
+  if (!header || !header.startsWith('bytes=') || header.includes(',')) return null;
+  const ifRange = req.headers['if-range'];
+  if (ifRange && ifRange !== etag && Date.parse(ifRange) !== Math.floor(mtimeMs / 1000) * 1000) return null;
+  const [, a, b] = /^bytes=(\d*)-(\d*)$/.exec(header.trim()) || [];
+  if (a === undefined || (a === '' && b === '')) return null;
+  let start, end;
+  if (a === '') { start = Math.max(0, size - Number(b)); end = size - 1; } // suffix range
+  else { start = Number(a); end = b === '' ? size - 1 : Math.min(Number(b), size - 1); }
+  return start > end || start >= size ? -1 : { start, end };
+}
+
+function pickEncoding(req, entry) {
+  const accept = req.headers['accept-encoding'] || '';
+  if (entry.br && /\bbr\b/.test(accept)) return 'br';
+  if (entry.gzip && /\bgzip\b/.test(accept)) return 'gzip';
+  return null;
+}
+
+// sendFile(req, res, file, opts) -> Promise<boolean>; false when the path is
+// missing or not a regular file (nothing has been written yet).
+async function sendFile(req, res, file, opts = {}) {
+  opts = { ...defaults, ...opts };
+  file = path.resolve(file);
+  let stat;
+  try { stat = await fs.promises.stat(file); } catch { return false; }
+  if (stat.isDirectory() && opts.index) {
+    file = path.join(file, opts.index);
+    try { stat = await fs.promises.stat(file); } catch { return false; }
+  }
+  if (!stat.isFile()) return false;
+
+  const type = mime.contentType(path.extname(file)) || 'application/octet-stream';
+  const etag = etagFor(stat);
+  res.setHeader('Accept-Ranges', 'bytes');
+  res.setHeader('Last-Modified', stat.mtime.toUTCString());
+  res.setHeader('Cache-Control', `public, max-age=${opts.maxAge}`);
+  if (!res.getHeader('Content-Type')) res.setHeader('Content-Type', type);
+  if (compressible(type)) res.setHeader('Vary', 'Accept-Encoding');
+
+  const head = req.method === 'HEAD';
+  if ((req.method === 'GET' || head) && isFresh(req, etag, stat.mtimeMs)) {
+    res.setHeader('ETag', etag);
+    res.statusCode = 304;
+    res.removeHeader('Content-Type');
+    res.end();
+    return true;
+  }
+
+  const range = parseRange(req, stat.size, etag, stat.mtimeMs);
+  if (range === -1) {
+    res.statusCode = 416;
+    res.setHeader('Content-Range', `bytes */${stat.size}`);
+    res.end();
+    return true;
+  }
+
+  if (!range && stat.size <= opts.maxCachedFile) {
+    const entry = await cachedEntry(file, stat, type, opts);
+    const encoding = pickEncoding(req, entry);
+    const body = encoding ? entry[encoding] : entry.body;
+    res.setHeader('ETag', encoding ? `${etag.slice(0, -1)}-${encoding}"` : etag);
+    if (encoding) res.setHeader('Content-Encoding', encoding);
+    res.setHeader('Content-Length', body.length);
+    res.end(head ? undefined : body);
+    return true;
+  }
+
+  res.setHeader('ETag', etag);
+  const start = range ? range.start : 0;
+  const end = range ? range.end : stat.size - 1;
+  if (range) {
+    res.statusCode = 206;
+    res.setHeader('Content-Range', `bytes ${start}-${end}/${stat.size}`);
+  }
+  res.setHeader('Content-Length', end - start + 1);
+  if (head || end < start) { res.end(); return true; }
+
+  await new Promise((resolve) => {
+    const stream = fs.createReadStream(file, { start, end, highWaterMark: opts.highWaterMark });
+    stream.on('error', (err) => { res.destroy(err); resolve(); });
+    res.on('close', () => { stream.destroy(); resolve(); });
+    stream.pipe(res);
+  });
+  return true;
+}
+
+// Express middleware serving `root`; unknown paths fall through to next().
+function serveStatic(root, opts = {}) {
+  root = path.resolve(root);
+  return (req, res, next) => {
+    if (req.method !== 'GET' && req.method !== 'HEAD') return next();
+    let rel;
+    try { rel = decodeURIComponent(req.path); } catch { return res.status(400).end(); }
+    if (rel.includes('\0')) return res.status(400).end();
+    const file = path.join(root, path.normalize('/' + rel));
+    if (file !== root && !file.startsWith(root + path.sep)) return res.status(403).end();
+    sendFile(req, res, file, opts).then((sent) => { if (!sent) next(); }, next);
+  };
+}
+
+module.exports = { sendFile, serveStatic, cache, defaults };
@@ -336,8 +336,20 @@ try {
 }
 const Pointers = () => require('../natives/pointers');
 const Utills = () => require('../natives/utils');
-
-const Big = require('big.js');
+const { optionalNative } = require('./nova-native');
+const Screen = () => optionalNative('screen');
+const AsyncNative = () => optionalNative('async');
+const Proc = () => optionalNative('proc');
+const NovaPool = () => require('./nova-pool');
+const NovaHttp = () => require('./nova-http');
+const NovaCluster = () => require('./nova-cluster');
+const NovaStatic = () => require('./nova-static');
+const NovaFiles = () => require('./nova-files');
+const NovaDecimal = () => require('./nova-decimal');
+const NovaArrays = () => require('./nova-arrays');
+const NovaMemo = () => require('./nova-memo');
+// typeof checks every value against it, so bound once rather than per call
+const NovaRange = NovaArrays().Range;
 
 const getGlobal = () => Object.getOwnPropertyNames(globalThis)
   .concat(Object.getOwnPropertySymbols(globalThis))
@@ -345,8 +357,14 @@ const getGlobal = () => Object.getOwnPropertyNames(globalThis)
     acc[key] = globalThis[key];
     return acc;
   }, {});
+// pi to n decimals, truncated. The pi addon (binary-splitting Chudnovsky)
+// handles millions of digits; the big.js series is the fallback.
 function pi(n) {
-  Big.DP = n + 2; // extra digits for rounding
+  n = Math.max(0, Math.floor(Number(n) || 0));
+  const native = optionalNative('pi');
+  if (native) return native.pi(n);
+  const Big = NovaDecimal().privateBig();
+  Big.DP = n + 10; // guard digits, cut off below
   const C = new Big(426880).times(Big(10005).sqrt());
   let M = new Big(1);
   let L = new Big(13591409);
@@ -363,7 +381,7 @@ function pi(n) {
   }
 
   const pi = C.div(S);
-  return pi.toFixed(n);
+  return pi.round(n, Big.roundDown).toFixed(n);
 }
 
 
@@ -581,14 +599,19 @@ class DigitNumber {
   }
 
   static fromString(str, digitSet) {
+    const index = new Map();
+    let longest = 1;
+    digitSet.forEach((d, idx) => {
+      if (!index.has(d)) index.set(d, idx);
+      longest = Math.max(longest, d.length);
+    });
     const digits = [];
     let i = str.length;
     while (i > 0) {
       let matched = false;
-      for (let len = Math.min(i, 10); len > 0; len--) {
-        let part = str.slice(i - len, i);
-        let idx = digitSet.indexOf(part);
-        if (idx !== -1) {
+      for (let len = Math.min(i, longest, 10); len > 0; len--) {
+        const idx = index.get(str.slice(i - len, i));
+        if (idx !== undefined) {
           digits.push(idx);
           i -= len;
           matched = true;
@@ -600,20 +623,25 @@ class DigitNumber {
     return new DigitNumber(digits, digitSet);
   }
 
+  // Exact: a number while it fits in one, a BigInt beyond that.
   toDecimal() {
-    let result = 0;
-    let base = this.base;
-    for (let i = 0; i < this.digits.length; i++) {
-      result += this.digits[i] * Math.pow(base, i);
+    const base = this.base;
+    if (this.digits.length * Math.log2(base) < 53) {
+      let result = 0;
+      for (let i = this.digits.length - 1; i >= 0; i--) result = result * base + this.digits[i];
+      return result;
     }
-    return result;
+    const value = BigInt(NovaDecimal().fromBase(this.digits, base));
+    return value <= BigInt(Number.MAX_SAFE_INTEGER) ? Number(value) : value;
   }
 
-
-
+  // value: a number, or a bigint / integer string of any length.
   static fromDecimal(value, digitSet) {
     const base = digitSet.length;
     if (value === 0) return new DigitNumber([0], digitSet);
+    if (typeof value !== 'number' || value > Number.MAX_SAFE_INTEGER) {
+      return new DigitNumber(NovaDecimal().toBase(value, base), digitSet);
+    }
     let digits = [];
     while (value > 0) {
       digits.push(value % base);
@@ -631,28 +659,7 @@ class DigitNumber {
   }
 }
 
-const Memoize = (fn) => {
-    const cache = new Map();
-
-    const callable = (...args) => {
-        const key = JSON.stringify(args);
-        if (!cache.has(key)) {
-            cache.set(key, fn(...args));
-        }
-        return cache.get(key);
-    };
-
-    callable.cache = cache;
-    callable.original = fn;
-
-    return new Proxy(callable, {
-        get: (target, prop) => (prop in target ? target[prop] : undefined),
-        set: (target, prop, value) => {
-            target[prop] = value;
-            return true;
-        }
-    });
-};
+const Memoize = (fn, opts) => NovaMemo().Memoize(fn, opts);
 
 const fengari = require("fengari");
 const lua = fengari.lua;
@@ -710,15 +717,28 @@ const luaEnv = {
   }
 };
 
+const openWindows = new Map();   // id -> Electron child, until it exits
 function windowUI(options) {
   const fs = require('fs');
   const path = require('path');
-  const configPath = path.join(tmp, 'nova_windowui_config.json');
+  // Windows with an id are retained: later calls rewrite the config file and
+  // the already-open window reloads it instead of a new Electron process spawning.
+  const id = options.id !== undefined ? String(options.id).replace(/[^\w-]/g, '_') : null;
+  const configPath = path.join(tmp, id ? `nova_windowui_${id}.json` : 'nova_windowui_config.json');
   fs.writeFileSync(configPath, JSON.stringify(options), 'utf8');
-  spawn('npx', ['electron', path.join(__dirname, '../electron-ui/main.js'), configPath], {
+  if (id && openWindows.has(id)) return;
+  const child = spawn('npx', ['electron', path.join(__dirname, '../electron-ui/main.js'), configPath], {
     detached: true,
     stdio: 'ignore'
-  }).unref();
+  });
+  child.unref();
+  if (id) {
+    // Once the user closes it, the next call with this id opens a new one.
+    const forget = () => { if (openWindows.get(id) === child) openWindows.delete(id); };
+    openWindows.set(id, child);
+    child.once('exit', forget);
+    child.once('error', forget);
+  }
 }
 // --- BigInt ---
 BigInt.prototype.toJSON = function() {
@@ -1495,17 +1515,78 @@ function generateConsoleUI(options = {}) {
 }
 
 
+// Blocks the thread in-process instead of forking a `sleep`/`timeout` command.
+const sleepCell = new Int32Array(new SharedArrayBuffer(4));
 function sleepSync(seconds) {
-  if (process.platform === 'win32') {
-    // For Windows, use the 'timeout' command
-    // /T: timeout in seconds, /NOBREAK: ignore key presses
-    // Note: timeout is in seconds, so convert ms. Minimum 1 second.
-    execSync(`timeout /T ${Math.max(1, Math.ceil(seconds))} /NOBREAK`, { stdio: 'inherit' });
-  } else {
-    // For Unix-like systems (Linux, macOS), use the 'sleep' command
-    // sleep can handle fractional seconds
-    execSync(`sleep ${seconds}`);
+  const ms = Number(seconds) * 1000;
+  if (ms > 0) Atomics.wait(sleepCell, 0, 0, ms);
+}
+
+// Pending `async` events per interpreter. Kept off the instance because scope
+// backups deep-clone every own property.
+const asyncTimers = new WeakMap();
+
+// "a, b, c" -> ["a", "b, c"], ignoring commas inside quotes and brackets.
+function splitFirstComma(text) {
+  let depth = 0, quote = null;
+  for (let i = 0; i < text.length; i++) {
+    const c = text[i];
+    if (quote) { if (c === quote && text[i - 1] !== '\\') quote = null; continue; }
+    if (c === '"' || c === "'" || c === '`') quote = c;
+    else if ('([{'.includes(c)) depth++;
+    else if (')]}'.includes(c)) depth--;
+    else if (c === ',' && depth === 0) return [text.slice(0, i).trim(), text.slice(i + 1).trim()];
   }
+  return [text.trim(), ''];
+}
+
+// One request's view of a table (maps / functions): reads fall through to
+// the shared table, names created during the request stay in `locals` and
+// vanish with it, and assigning to a name the shared table already has still
+// updates it, so counters and caches shared across requests keep working.
+function layeredScope(shared, locals = {}) {
+  const own = (k) => Object.prototype.hasOwnProperty.call(locals, k);
+  return new Proxy(locals, {
+    get: (t, k) => (own(k) ? t[k] : shared[k]),
+    has: (t, k) => own(k) || k in shared,
+    set: (t, k, v) => {
+      if (!own(k) && Object.prototype.hasOwnProperty.call(shared, k)) shared[k] = v;
+      else t[k] = v;
+      return true;
+    },
+    deleteProperty: (t, k) => (own(k) ? delete t[k] : delete shared[k]),
+    ownKeys: (t) => [...new Set([...Reflect.ownKeys(shared), ...Reflect.ownKeys(t)])],
+    getOwnPropertyDescriptor: (t, k) => {
+      if (own(k)) return Reflect.getOwnPropertyDescriptor(t, k);
+      const d = Reflect.getOwnPropertyDescriptor(shared, k);
+      return d && { ...d, configurable: true };
+    },
+  });
+}
+
+// setTimeout stand-in for the native TimerWheel when the addon isn't built.
+function timeoutWheel(fire) {
+  const handles = new Map();
+  let nextId = 1;
+  return {
+    add(ms) {
+      const id = nextId++;
+      handles.set(id, setTimeout(() => { handles.delete(id); fire([id]); }, ms));
+      return id;
+    },
+    cancel(id) {
+      if (!handles.has(id)) return false;
+      clearTimeout(handles.get(id));
+      return handles.delete(id);
+    },
+    flush() {
+      const ids = [...handles.keys()];
+      for (const h of handles.values()) clearTimeout(h);
+      handles.clear();
+      fire(ids);
+    },
+    size: () => handles.size,
+  };
 }
 
 /**
@@ -1534,7 +1615,7 @@ function findClosestMatch(wordArray, wordToMatch) {
   return rating > 0.4 ? target : wordToMatch;
 }
 
-function safeReadFile(filename) {
+function resolveUserPath(filename) {
   // Remove quotes if present
   if (typeof filename === 'string') {
     filename = filename.trim();
@@ -1553,6 +1634,11 @@ function safeReadFile(filename) {
   if (!fs.existsSync(filename)) {
     throw new Error(`File not found: ${filename}`);
   }
+  return filename;
+}
+
+function safeReadFile(filename) {
+  filename = resolveUserPath(filename);
 
   // Try reading
   try {
@@ -1562,6 +1648,52 @@ function safeReadFile(filename) {
   }
 }
 
+// Lazy file readers for readLines/readChunks and nv.lines/nv.chunks: one
+// fixed buffer however big the file is.
+function* fileLines(filename) {
+  filename = resolveUserPath(filename);
+  const native = Proc();
+  if (native) return yield* native.fileLines(filename);
+  const { StringDecoder } = require('string_decoder');
+  const decoder = new StringDecoder('utf8');
+  const buf = Buffer.allocUnsafe(1 << 20);
+  const fd = fs.openSync(filename, 'r');
+  try {
+    let rest = '', n;
+    while ((n = fs.readSync(fd, buf, 0, buf.length, null)) > 0) {
+      const text = rest + decoder.write(buf.subarray(0, n));
+      const last = text.lastIndexOf('\n');
+      if (last < 0) { rest = text; continue; }
+      yield* text.slice(0, last).split(/\r?\n/);
+      rest = text.slice(last + 1);
+    }
+    rest += decoder.end();
+    if (rest) yield rest;
+  } finally {
+    fs.closeSync(fd);
+  }
+}
+function* fileChunks(filename, size = 1 << 16) {
+  filename = resolveUserPath(filename);
+  const { StringDecoder } = require('string_decoder');
+  const decoder = new StringDecoder('utf8');
+  const buf = Buffer.allocUnsafe(Math.max(1, Number(size) || 1 << 16));
+  const fd = fs.openSync(filename, 'r');
+  try {
+    let n;
+    while ((n = fs.readSync(fd, buf, 0, buf.length, null)) > 0) {
+      const text = decoder.write(buf.subarray(0, n));
+      if (text) yield text;
+    }
+    const tail = decoder.end();
+    if (tail) yield tail;
+  } finally {
+    fs.closeSync(fd);
+  }
+}
+// Generators and other one-shot iterators; `loop` walks these lazily.
+const isIterator = (v) => v !== null && typeof v === 'object' && typeof v.next === 'function' && typeof v[Symbol.iterator] === 'function';
+
 function parseKeol(code) {
   const parser = new KeolParser();
   parser.addCommand('eval_nova', ((args) => { runNovaCode(args) }));
@@ -1647,7 +1779,6 @@ JSON.parse = function(text, reviver) {
 };
     this._backups = {};
     this.extends = extendsClass;
-    this.asyncQueqe = [];
     this.wrappers = {};
     this.breakFn = () => { throw 'k'; };
     this.contiFn = () => { throw 'k'; };
@@ -1818,8 +1949,8 @@ this.QAEs = {
     (a && typeof a === "object" && Object.keys(a).length === 0),
   nonempty: (a) => !this.QAEs.empty(a),
   unique: (a, i, arr) => arr.indexOf(a) === i,
-  first: (a) => Array.isArray(a) ? a[0] : null,
-  last: (a) => Array.isArray(a) ? a[a.length - 1] : null,
+  first: (a) => this.typeof(a) === 'array' ? a.at(0) : null,
+  last: (a) => this.typeof(a) === 'array' ? a.at(-1) : null,
   length: (a) => (a != null && (a.length !== undefined)) ? a.length : null,
 
   // booleans
@@ -1842,7 +1973,7 @@ this.QAEs = {
   number: (a) => typeof a === "number",
   boolean: (a) => typeof a === "boolean",
   object: (a) => typeof a === "object" && a !== null && !Array.isArray(a),
-  array: (a) => Array.isArray(a),
+  array: (a) => this.typeof(a) === 'array',
   function: (a) => typeof a === "function",
   date: (a) => a instanceof Date,
   regexp: (a) => a instanceof RegExp,
@@ -1866,22 +1997,22 @@ this.QAEs = {
     // ...existing code...
     this.keywordsArray = [
       // Control Flow
-      'if', 'else', 'unless', 'while', 'do', 'repeat', 'for', 'loop', 'break', 'continue', 'return', 'give', 'try', 'catch', 'finally', 'throw', 'Terminate', 'exit', 'expect', 'expt', 'match', 'switch', 'until', 'when', 'with', 'foreach', 'engage', 'rate', 'cast', 'comment', 'end', 'call_code',
+      'if', 'else', 'unless', 'while', 'do', 'repeat', 'parallel', 'spawn', 'join', 'for', 'loop', 'break', 'continue', 'return', 'give', 'try', 'catch', 'finally', 'throw', 'Terminate', 'exit', 'expect', 'expt', 'match', 'switch', 'until', 'when', 'with', 'foreach', 'engage', 'rate', 'cast', 'comment', 'end', 'call_code',
 
       // Variables & Data
       'var', 'let', 'const', 'array', 'enum', 'map', 'struct', 'type', 'classify' ,'macro', 'session', 'enter', 'backup', 'retrieve', 'delete', 'addto',
 
       // Functions & Blocks
-      'func', 'function', 'ifunc', 'defunc', 'lambda', 'compose', 'partial', 'block', 'snippet', 'template', 'keyfunc', 'implements', 'interface',
+      'func', 'function', 'ifunc', 'defunc', 'memo', 'memoize', 'lambda', 'compose', 'partial', 'block', 'snippet', 'template', 'keyfunc', 'implements', 'interface',
 
       // I/O & System
-      'print', 'println', 'log', 'logln', 'logO', 'banner', 'windowUI', 'UI', 'input', 'getpress', 'beep', 'term', 'exec', 'execFile', 'createFile', 'deleteFile', 'listFiles', 'readFile', 'write', 'require', 'import', 'plugin', 'server', 'invoke', 'sleep', 'wait', 'infer', "'IS CLI'",
+      'print', 'println', 'log', 'logln', 'logO', 'banner', 'windowUI', 'UI', 'input', 'getpress', 'beep', 'term', 'proc', 'exec', 'execFile', 'createFile', 'deleteFile', 'listFiles', 'readFile', 'readLines', 'readChunks', 'write', 'require', 'import', 'plugin', 'server', 'invoke', 'sleep', 'wait', 'infer', "'IS CLI'",
 
       // Device/Termux Integration
       'notify', 'toast', 'vibrate', 'clipboard', 'copy', 'paste', 'open', 'ringtones', 'brightness', 'set_brightness', 'battery_status', 'sms_send', 'call_log', 'contact_list', 'camera', 'camera_photo', 'torch', 'wifi_info', 'location', 'microphone_record', 'microphone_stop', 'dialog',
 
       // Math & Utils
-      'math', 'random', 'sum', 'range', 'reverse', 'ascii', 'chars', 'keys', 'uuid', 'jsonParse', 'jsonStringify', 'parseURL', 'sha256', 'randomBytes', 'sandbox', 'osPlatform', 'cpu', 'mem', 'userInfo', 'network', 'uptime', 'hostname', 'arch', 'load', 'tmpDir', 'pathDir', 'pathBase', 'pathExt', 'pathJoin', 'pid', 'cwd', 'env', 'platform', 'exists',
+      'math', 'random', 'sum', 'min', 'max', 'mean', 'range', 'reverse', 'ascii', 'chars', 'keys', 'uuid', 'jsonParse', 'jsonStringify', 'parseURL', 'sha256', 'randomBytes', 'sandbox', 'osPlatform', 'cpu', 'mem', 'userInfo', 'network', 'uptime', 'hostname', 'arch', 'load', 'tmpDir', 'pathDir', 'pathBase', 'pathExt', 'pathJoin', 'pid', 'cwd', 'env', 'platform', 'exists',
 
       // Streams & Patterns
       'stream', 'istream', 'fnstream', 'pattern',
@@ -2105,7 +2236,24 @@ let vv = typeof val === 'string' ? val.length : 100000000000;
 
       signals: () => require('../natives/signals'),
       typesys: () => require('../natives/types'),
+      // struct("Point", [["x", "int"], ["y", "double"]]) -> type whose
+      // at(buffer | pointer, offset) views read and write C layout in place
+      struct: (name, fields, opts) => require('../natives/types').types.struct(name, fields, opts),
+      // vector(Point, n, { layout: 'soa' }) -> contiguous array of Point
+      // records with native sort / save / load and typed-array columns
+      vector: (type, capacity, opts) => require('../natives/types').types.vector(type, capacity, opts),
       crout: () => require('../natives/coroutines'),
+      parallel: () => require('../natives/parallel'),
+      // SIMD sum / min / max / argmin / argmax / mean / variance / dot /
+      // prefixSum / histogram over typed arrays
+      kernels: () => require('../natives/kernels'),
+      // memoize(fn, { capacity, policy: 'lru' | 'lfu', ttl }) -> fn with a
+      // bounded cache and .stats(); memo() is its XXH64-keyed native cache
+      memoize: (fn, opts) => Memoize(fn, opts),
+      memo: () => require('../natives/memo'),
+      channels: () => require('../natives/channels'),
+      lines: (file) => fileLines(file),
+      chunks: (file, size) => fileChunks(file, size),
       dl: () => require('../natives/dl'),
 
       instance: (a, ...args) => new a(args),
@@ -2240,7 +2388,7 @@ arr_obj: {
         sqr: (x) => x * x,
         cube: (x) => x * x * x,
         hypot3: (x, y, z) => Math.hypot(x, y, z),
-        mean: (arr) => arr.reduce((s, v) => s + v, 0) / arr.length,
+        mean: (arr) => NovaArrays().mean(arr),
         median: (arr) => {
           const a = [...arr].sort((x, y) => x - y);
           const mid = Math.floor(a.length / 2);
@@ -2255,7 +2403,7 @@ arr_obj: {
         comb: (n, r) => math.factorial(n) / (math.factorial(r) * math.factorial(n - r)),
         isEven: (n) => n % 2 === 0,
         isOdd: (n) => n % 2 !== 0,
-        sum: (arr) => arr.reduce((a, b) => a + b, 0),
+        sum: (arr) => NovaArrays().sum(arr),
         prod: (arr) => arr.reduce((a, b) => a * b, 1),
         variance: (arr) => {
           const m = math.mean(arr);
@@ -2275,6 +2423,28 @@ arr_obj: {
         modulo: (a, b) => ((a % b) + b) % b,
       },
 
+      // exact decimal math (called as decimal.add("0.1", "0.2") -> "0.3").
+      // Arguments may be numbers, numeric strings or bigints; results are
+      // plain decimal strings. dp defaults to 20 for div/sqrt/pow; rm is
+      // 0 down, 1 half-up (default), 2 half-even, 3 up.
+      decimal: {
+        add: (a, b) => NovaDecimal().add(a, b),
+        sub: (a, b) => NovaDecimal().sub(a, b),
+        mul: (a, b) => NovaDecimal().mul(a, b),
+        div: (a, b, dp, rm) => NovaDecimal().div(a, b, dp, rm),
+        mod: (a, b) => NovaDecimal().mod(a, b),
+        sqrt: (a, dp, rm) => NovaDecimal().sqrt(a, dp, rm),
+        pow: (a, n, dp, rm) => NovaDecimal().pow(a, n, dp, rm),
+        round: (a, dp, rm) => NovaDecimal().round(a, dp, rm),
+        toFixed: (a, dp, rm) => NovaDecimal().toFixed(a, dp, rm),
+        cmp: (a, b) => NovaDecimal().cmp(a, b),
+        // exact total of an array or Float64Array, rounded to dp if given
+        sum: (values, dp, rm) => NovaDecimal().sum(values, dp, rm),
+        // running total: acc.add(x).add([y, z]); acc.value(2)
+        accumulator: () => NovaDecimal().accumulator(),
+        big: (v) => new (NovaDecimal().Big)(v),
+      },
+
       // string map methods (called as string.upper("hello"), string.split("hello,world", ","))
       // These are utility functions that take the string as their first explicit argument.
       string: {
@@ -2411,7 +2581,10 @@ arr_obj: {
         rmdir: { native: (_ctx, path) => { try { require('fs').rmdirSync(path, { recursive: true }); return "✅ Removed directory " + path; } catch (e) { return "❌ Rmdir error: " + e.message; } } },
         stat: { native: (_ctx, path) => { try { return require('fs').statSync(path); } catch (e) { return "❌ Stat error: " + e.message; } } },
         readdir: { native: (_ctx, path) => { try { return require('fs').readdirSync(path); } catch (e) { return "❌ Readdir error: " + e.message; } } },
-        list: { native: (_ctx, dir) => { try { const files = require('fs').readdirSync(dir); return files.map(file => { const filePath = require('path').join(dir, file);  }); } catch (e) { return "❌ List files error: " + e.message; } } },
+        list: { native: (_ctx, dir) => { try { const files = require('fs').readdirSync(dir); return files.map(file => require('path').join(dir, file)); } catch (e) { return "❌ List files error: " + e.message; } } },
+        // walk(dir, "*.js") or walk(dir, { pattern, ignore, hidden, maxDepth, type }); grep(dir, "text" | /re/, same)
+        walk: (dir, opts) => NovaFiles().list(dir, { recursive: true, ...(typeof opts === 'string' ? { pattern: opts } : opts) }),
+        grep: (dir, query, opts) => NovaFiles().search(dir, query, typeof opts === 'string' ? { pattern: opts } : opts),
         append: (f, data) => fs.appendFileSync(f, data),
       },
 
@@ -3680,6 +3853,9 @@ this.varMethods = {
     this.states = {};
     this.allVars = {};
     this.macros = {};
+    // source of each func/class/macro/... statement, keyed by kind and name,
+    // so cluster workers can define the same things before serving
+    this.definitions = new Map();
     this.types = {
     integer: {
         function: (val) => {
@@ -5030,8 +5206,8 @@ if (target[key]?._destructor) {
     // null
     if (value === null) return 'null';
 
-    // arrays
-    if (Array.isArray(value)) return "array";
+    // arrays: plain, typed, or a lazy range
+    if (Array.isArray(value) || (ArrayBuffer.isView(value) && !(value instanceof DataView)) || value instanceof NovaRange) return "array";
 
     // numbers
     if (typeof value === 'number' || value?.__isPointerNumber) {
@@ -5054,6 +5230,13 @@ if (target[key]?._destructor) {
       default: return typeof value;
     }
   }
+
+  // Anything typeof calls an array, as a plain Array (ranges and typed
+  // arrays are copied); null for everything else.
+  asArray(value) {
+    if (Array.isArray(value)) return value;
+    return this.typeof(value) === 'array' ? Array.from(value) : null;
+  }
 extractFn(expr) {
 if (expr.trim().match(/^\(.*\)\s*=>\s*{.*}$/s)) {
       this.debug('found arrow function');
@@ -5546,7 +5729,6 @@ return this.fn([], expr, { usetype: 'expr' });
       const expected = this.evaluateExpr(right);
       this.debug(`typeis evaluated val: ${val}, expected: ${expected}`);
       if (val === null && expected === 'null') return true;
-      if (Array.isArray(val) && expected === 'array') return true;
       return this.typeof(val) === expected;
     }
     if (expr.startsWith('default ')) {
@@ -5566,9 +5748,7 @@ return this.fn([], expr, { usetype: 'expr' });
       const a = Number(this.evaluateExpr(parts[0]));
       const b = Number(this.evaluateExpr(parts[1]));
       this.debug(`range a: ${a}, b: ${b}`);
-      return Array.from({
-        length: b - a + 1
-      }, (_, i) => a + i);
+      return NovaArrays().range(a, b, true);
     }
 
     if (expr.startsWith('not ')) {
@@ -5740,8 +5920,11 @@ if (IST('array')) {
   // bb is now the array literal token like '{1,2,3}'
   let val = this.parseArray(bb.slice(1, -1));
 
-  // If there’s a type argument, validate elements
-if (typeArgs.length > 0) {
+  // A numeric kind (int32, float64, ..., or number to pick one) stores the
+  // elements in a typed array; other type arguments validate them.
+if (typeArgs.length === 1 && (typeArgs[0] in NovaArrays().kinds || typeArgs[0] === 'number')) {
+  val = NovaArrays().from(val, typeArgs[0]);
+} else if (typeArgs.length > 0) {
   let expectedType = typeArgs[0];  // 'integer', 'string', etc.
   for (let idx = 0; idx < val.length; idx++) {
     if (!typeArgs.includes(this.typeof(val[idx]))) {
@@ -6213,6 +6396,8 @@ this.ref.set(left, val);
 if (typeof fn === "function") {
 let lf = left;
   left = ((...args) => fn(lf, ...args)).bind(this);
+} else if (left instanceof NovaRange && typeof val === 'number') {
+  left = left.at(val) ?? left;
 } else {
   left = left?.[val] ?? left;
 }
@@ -6314,10 +6499,20 @@ let lf = left;
 continue;
       }
       if (IST('memoize')) {
-        let b = op;
-        let body = grouped[i++];
-        left = Memoize(this.fn(this.parseArr(b.slice(1, -1)), body.slice(1, -1)));
-        if (i + 1 > grouped.length - 1) return left;
+        // memoize (a, b) { body }: the parameters arrive as '(' a , b ')'
+        // or as one grouped token
+        let j = grouped.lastIndexOf('memoize', inoi) + 1, params;
+        if (grouped[j] === '(') {
+          const close = grouped.indexOf(')', j);
+          params = grouped.slice(j + 1, close).join(' ');
+          j = close + 1;
+        } else {
+          params = grouped[j++].slice(1, -1);
+        }
+        let body = grouped[j++];
+        left = Memoize(this.fn(this.parseArr(params), body.slice(1, -1)));
+        i = j;
+        if (i > grouped.length - 1) return left;
         continue
       }
       if (IST('if')) {
@@ -6423,16 +6618,7 @@ evaluedR = true;
 }
 return rhs_val;
 }
-const start = Number(left);
-const end = Number(right());
-if (isNaN(start) || isNaN(end)) throw new Error("Range bounds must be numbers");
-const result = [];
-for (let n = start; n <= end; n++) {
-  if (isExlusive && n === end) break;
-  result.push(n);
-}
-
-left = result; // assign back to left for chaining
+left = new NovaRange(left, right(), 1, !isExlusive); // lazy, for chaining
 evaluedRangeOp = true;
         }
 if (!evaluedRangeOp) left = left["__empty"]();
@@ -6535,7 +6721,8 @@ left = Number(`${(typeof left === 'number') ? left : lre}.${val}`);
 continue;
 }
 this.ref.set(left, val);
-if (typeof fn === "function" && !(left.hasOwnProperty(val))) {
+// typed arrays and ranges keep length on the prototype, not as an own property
+if (typeof fn === "function" && !(left.hasOwnProperty(val) || (val === 'length' && this.typeof(left) === 'array'))) {
 let fl = left;
   left = ((...args) => fn(fl, ...args));
 } else {
@@ -6573,18 +6760,7 @@ evaluedR = true;
 }
 }
 right(); // evaluate RHS once
-const start = Number(left);
-const end = Number(rhs_val);
-
-if (isNaN(start) || isNaN(end)) throw new Error("Range bounds must be numbers");
-
-const result = [];
-for (let n = start; n <= end; n++) {
-  if (isExlusive && n === end) break;
-  result.push(n);
-}
-
-left = result; // assign back to left for chaining
+left = new NovaRange(left, rhs_val, 1, !isExlusive); // lazy, for chaining
 evaluedRangeOp = true;
         }
         if (!evaluedRangeOp) left = left["__empty"]?.() ?? null;
@@ -7034,8 +7210,8 @@ if (this.typeops?.[this.typeof(left)]?.[op] && !this?.IS_IN_TYPE_OPS && !this.op
           } else if (typeof left === 'bigint' || typeof r === 'bigint') {
             left = BigInt(left) + BigInt(r);
           } else if (this.typeof(left) === 'array' || this.typeof(r) === 'array') {
-            left = (this.typeof(left) === 'array' ? left : [left])
-              .concat(this.typeof(r) === 'array' ? r : [r]);
+            left = (this.typeof(left) === 'array' ? Array.from(left) : [left])
+              .concat(this.typeof(r) === 'array' ? Array.from(r) : [r]);
           } else {
             left = Number(left) + Number(r);
           }
@@ -7134,9 +7310,14 @@ if (this.typeops?.[this.typeof(left)]?.[op] && !this?.IS_IN_TYPE_OPS && !this.op
 
         case 'between': left = Number(left) > Number(right()) && Number(left) < Number(extra()); break;
         case 'not': left = !Boolean(right()); break;
-        case 'join': if (Array.isArray(left)) left = left.join(String(right())); break;
-        case 'concat': if (Array.isArray(left)) left = left.concat(right()); break;
-        case 'index': if (Array.isArray(left)) left = left[Number(right())]; break;
+        case 'join': if (this.typeof(left) === 'array') left = this.asArray(left).join(String(right())); break;
+        case 'concat': {
+          if (this.typeof(left) !== 'array') break;
+          const r = right();
+          left = this.asArray(left).concat(this.asArray(r) ?? r);
+          break;
+        }
+        case 'index': if (this.typeof(left) === 'array') left = left instanceof NovaRange ? left.at(Number(right())) : left[Number(right())]; break;
         case 'avg': left = (Number(left) + Number(right())) / 2; break;
         case 'diff': left = Math.abs(Number(left) - Number(right())); break;
         case 'ratio': left = Number(left) / Number(right()); break;
@@ -7160,26 +7341,27 @@ if (this.typeops?.[this.typeof(left)]?.[op] && !this?.IS_IN_TYPE_OPS && !this.op
         case 'equals_ignore': left = String(left).toLowerCase() === String(right()).toLowerCase(); break;
         case 'cmp': left = String(left).localeCompare(String(right())); break; // -1,0,1
         case 'zip': {
-          const arr1 = Array.isArray(left) ? left : [left];
-          const arr2 = Array.isArray(right()) ? right() : [right()];
+          const r = right();
+          const arr1 = this.asArray(left) ?? [left];
+          const arr2 = this.asArray(r) ?? [r];
           left = arr1.map((v, i) => [v, arr2[i]]);
           break;
         }
         case 'intersect': {
-          const arr1 = Array.isArray(left) ? left : [];
-          const arr2 = Array.isArray(right()) ? right() : [];
+          const arr1 = this.asArray(left) ?? [];
+          const arr2 = this.asArray(right()) ?? [];
           left = arr1.filter(v => arr2.includes(v));
           break;
         }
         case 'diff_arr': {
-          const arr1 = Array.isArray(left) ? left : [];
-          const arr2 = Array.isArray(right()) ? right() : [];
+          const arr1 = this.asArray(left) ?? [];
+          const arr2 = this.asArray(right()) ?? [];
           left = arr1.filter(v => !arr2.includes(v));
           break;
         }
         case 'union': {
-          const arr1 = Array.isArray(left) ? left : [];
-          const arr2 = Array.isArray(right()) ? right() : [];
+          const arr1 = this.asArray(left) ?? [];
+          const arr2 = this.asArray(right()) ?? [];
           left = [...new Set([...arr1, ...arr2])];
           break;
         }
@@ -7249,10 +7431,11 @@ if (this.typeops?.[this.typeof(left)]?.[op] && !this?.IS_IN_TYPE_OPS && !this.op
           this.debug(`result: ${left}`);
           return left;
         case 'step': {
-          let start = Array.isArray(left) ? (left[0]) : 0;
-          let end = Array.isArray(left) ? (left[left.length - 1]) : left;
+          const seq = Array.isArray(left) || left instanceof NovaRange;
+          let start = seq ? (left.at(0)) : 0;
+          let end = seq ? (left.at(-1)) : left;
           let step = right();
-          left = Array.from({ length: Math.floor((end - start) / step) + 1 }, (_, i) => start + i * step);
+          left = new NovaRange(start, end, step, true);
           break;
         }
         case '||':
@@ -7291,7 +7474,8 @@ if (this.typeops?.[this.typeof(left)]?.[op] && !this?.IS_IN_TYPE_OPS && !this.op
         if (category.hasOwnProperty(unit)) {
           const unitDef = category[unit];
           if (typeof unitDef === 'object' && unitDef !== null && unitDef.hasOwnProperty('initial_base')) {
-            const convertedValue = value * unitDef.initial_base;
+            // Decimal product, so 1.1h is 3960 rather than 3960.0000000000005.
+            const convertedValue = Number(NovaDecimal().mul(value, unitDef.initial_base));
             this.debug(`Converted ${value}${unit} to ${convertedValue} (base units of ${categoryName})`);
             return convertedValue;
           }
@@ -7477,33 +7661,9 @@ advanceE();
         throw new Error(`Invalid range: start or end is not a valid number in '${token}'`);
       }
 
-      const result = [];
-      if (start <= end) {
-        if (operator === '..') { // Inclusive
-          this.debug('Generating ascending inclusive range.');
-          for (let i = start; i <= end; i++) {
-            result.push(i);
-          }
-        } else { // Exclusive "..."
-          this.debug('Generating ascending exclusive range.');
-          for (let i = start; i < end; i++) {
-            result.push(i);
-          }
-        }
-      } else { // Decrementing range
-        if (operator === '..') { // Inclusive
-          this.debug('Generating descending inclusive range.');
-          for (let i = start; i >= end; i--) {
-            result.push(i);
-          }
-        } else { // Exclusive "..."
-          this.debug('Generating descending exclusive range.');
-          for (let i = start; i > end; i--) {
-            result.push(i);
-          }
-        }
-      }
-      this.debug(`Range result: ${JSON.stringify(result)}`);
+      // lazy: elements are produced as the range is iterated or indexed
+      const result = new NovaRange(start, end, start <= end ? 1 : -1, operator === '..');
+      this.debug(`Range result: ${result}`);
       return result;
     }
 
@@ -7709,7 +7869,9 @@ advanceE();
       return this.webs[value];
     }
     if (this.enums?.hasOwnProperty(value)) {
-      this.debug(`Found '${value}' in 'this.enums': ${this.enums[value]}`);
+      // not the value itself: the message is built even with debug off, and
+      // a range result can hold millions of elements
+      this.debug(`Found '${value}' in 'this.enums'.`);
       this.ref.set(this.enums, value);
       return this.enums[value];
     }
@@ -8504,9 +8666,14 @@ linkObjects(obj1, obj2, propName = 'ref') {
   }
 
   execute(code, options) {
-    code = require('./nvopt.js')(code);
-    let cleaned = this.tokenize(code).code;
-    let tokens = this.tokenize(code).tokens;
+    let cleaned, tokens;
+    if (options?.compiled) {
+      ({ code, cleaned } = options.compiled);
+      tokens = options.compiled.tokens.slice(); // expect() may patch tokens in place
+    } else {
+      code = require('./nvopt.js')(code);
+      ({ code: cleaned, tokens } = this.tokenize(code));
+    }
     let pos = 0;
 
 function watchTokensNewline(shouldTerminate) {
@@ -8537,6 +8704,7 @@ let shouldTerminate = false;
 
 let stopWatcher = watchTokensNewline(shouldTerminate);
 
+    try {
     while (pos < tokens.length) {
 
       // Helper function: split on comma, but ignore those inside quotes/backticks
@@ -8741,6 +8909,17 @@ shouldTerminate = false;
         if (this.options.vartroub) body = this._replaceAll(body);
         return body;
       };
+      // the token after the parenthesized group opening at tokens[at]
+      const afterParen = (at) => {
+        let depth = 0;
+        for (let k = at; k < tokens.length; k++) {
+          if (tokens[k] === '(') depth++;
+          else if (tokens[k] === ')' && --depth === 0) return tokens[k + 1];
+        }
+        return undefined;
+      };
+      // records the statement that began at token `start` as a definition
+      const define = (key, start) => this.definitions.set(key, tokens.slice(start, pos).join(' '));
       const parseBlock = () => {
 shouldTerminate = false;
         if (this.options.spaceMet) return parseUntil('fi');
@@ -9095,7 +9274,7 @@ shouldTerminate = false;
         expect(';');
 
         try {
-          require('child_process').execSync(`input tap ${x} ${y}`);
+          this._runTool(['input', 'tap', x, y]);
         } catch (e) {
           this._log(`Tap error: ${e.message}`);
         }
@@ -9103,9 +9282,8 @@ shouldTerminate = false;
         next();
         let key = this.evaluateExpr(parseParen());
         expect(';');
-        const shPath = '/bin/bash';
         console.clear();
-        execSync(`input keyevent ${key}`, { shPath, encoding: 'utf8' });
+        this._runTool(['input', 'keyevent', key]);
       } else if (current === 'banner') {
         next();
         const body = parseParen();
@@ -9241,7 +9419,7 @@ shouldTerminate = false;
         else if (Formatlang === 'keol') parsed = parseKeol(body)
         else if (Formatlang === 'self') parsed = this.parseMapInline(body)
         else throw `Unkown or unsuppored formatting language: ${FormatLang}`;
-        console.log(generateConsoleUI(parsed));
+        if (parsed.id === undefined || !this._renderRetainedUI(parsed)) console.log(generateConsoleUI(parsed));
         expect(';');
       } else if (current === 'println') {
         next();
@@ -9451,6 +9629,7 @@ if (typeArgs.length > 0 && structDef.params) {
         this.ret = {};
         this.states = {};
         this.macros = {};
+        this.definitions = new Map();
         this.defunctions = {};
         this.structs = {};
         this.blocks = {};
@@ -9534,6 +9713,40 @@ if (typeArgs.length > 0 && structDef.params) {
             this.exec(body);
           }
         }
+      } else if (current === 'parallel' && !this.functions[current]) {
+        // parallel(n) { ... } => results;  runs n copies on the worker pool, i = 0..n-1
+        next();
+        const times = parseExpr_math(parseParen());
+        const body = parseBlock();
+        let target = null;
+        if (peek() === '=>') { next(); target = next(); expect(';'); }
+
+        if (body.trim() !== '' && times > 0) {
+          const replies = NovaPool().getPool().map(times, body, this._captureVars(body));
+          for (const r of replies) Object.assign(this.maps, r.vars);
+          if (target) this.maps[target] = replies.map(r => r.vars);
+        }
+      } else if (current === 'spawn' && !this.functions[current]) {
+        // spawn { ... } => handle;  typed arrays in scope are moved to the worker
+        next();
+        const body = parseBlock();
+        expect('=>');
+        const target = next();
+        expect(';');
+        const pool = NovaPool().getPool();
+        this.maps[target] = { spawned: pool.submit(body, this._captureVars(body), 0, true) };
+      } else if (current === 'join' && !this.functions[current]) {
+        next();
+        const name = next();
+        let target = null;
+        if (peek() === '=>') { next(); target = next(); }
+        expect(';');
+        const handle = this.maps[name];
+        if (!handle || !handle.spawned) throw new Error(`join: ${name} is not a spawned task`);
+        const reply = NovaPool().getPool().wait(handle.spawned);
+        Object.assign(this.maps, reply.vars);
+        if (target) this.maps[target] = reply.vars;
+        delete this.maps[name];
       } else if (current === 'tb$') {
         next();
         const body = parseBlock();
@@ -9557,11 +9770,13 @@ if (typeArgs.length > 0 && structDef.params) {
 
         this.maps[mapName] = entries;
       } else if (current === 'class') {
+        const start = pos;
         next();
         const mapName = next(); const mapBlock = parseBlock(); // assume block like `{ a = 1; b = [1, 2]; c = { d = 4 }; f =>
         const entries = this.parseMapInline(mapBlock);
 
         this.classes[mapName] = entries;
+        define('class ' + mapName, start);
       } else if (current === 'web') {
         next();
         const mapName = next();
@@ -9573,6 +9788,7 @@ if (typeArgs.length > 0 && structDef.params) {
 
         this.webs[mapName] = new webfirm(entries);
       } else if (current === 'enum') {
+        const start = pos;
         next();
         const enumName = next();
         const enumBlock = parseBlock(); // like `{ A, B, C }`
@@ -9582,14 +9798,23 @@ if (typeArgs.length > 0 && structDef.params) {
 
         this.enums[enumName] = values;
         this.maps[enumName] = values;
+        define('enum ' + enumName, start);
       } else if (current === 'array') {
         next();
+        // array<float64> nums { ... }: a typed array of that kind, or of the
+        // narrowest one that fits with array<number>
+        let kind;
+        if (peek() === '<') {
+          next();
+          kind = next();
+          expect('>');
+        }
         const arrayName = next();
         const arrayBlock = parseBlock(); // returns the string inside `{ ... }`
 
 
         const items = this.parseArray(arrayBlock);
-        this.maps[arrayName] = items;
+        this.maps[arrayName] = kind ? NovaArrays().from(items, kind) : items;
       } else if (current === 'DYNAMIC') {
         next();
         const naSme = next();
@@ -9635,6 +9860,21 @@ if (typeArgs.length > 0 && structDef.params) {
         } catch (e) {
           throw e;
         }
+      } else if ((current === 'readLines' || current === 'readChunks') && !this.functions[current]) {
+        // readLines line = ("big.log") { ... };  readChunks c = ("big.bin", 65536) { ... };
+        // The body runs per line / chunk; the file is never held in memory whole.
+        const chunked = next() === 'readChunks';
+        const varName = next();
+        expect('=');
+        const [fileExpr, sizeExpr] = splitFirstComma(parseParen());
+        const filename = this.evaluateExpr(fileExpr);
+        const compiled = this.compile(parseBlock());
+        expect(';');
+        const source = chunked ? fileChunks(filename, sizeExpr && this.evaluateExpr(sizeExpr)) : fileLines(filename);
+        for (const item of source) {
+          this.maps[varName] = item;
+          this.runCompiled(compiled);
+        }
       } else if (current === 'test') {
         next();
         const topic = next();
@@ -9777,15 +10017,17 @@ if (typeArgs.length > 0 && structDef.params) {
           throw new Error(`Failed to delete file ${fname}: ${e.message}`);
         }
       } else if (current === 'listFiles') {
+        // listFiles ("dir");  listFiles ("dir", { recursive: true, pattern: "*.{js,nv}", contains: "TODO" });
         next();
-        const dir = this.evaluateExpr((parseParen()));
+        const [dirExpr, optionsExpr] = splitFirstComma(parseParen());
+        const dir = this.evaluateExpr(dirExpr);
         expect(';');
         try {
           let dname = dir.trim();
           if ((dname.startsWith('"') && dname.endsWith('"')) || (dname.startsWith("'") && dname.endsWith("'"))) {
             dname = dname.slice(1, -1);
           }
-          const files = fs.readdirSync(dname);
+          const files = optionsExpr ? NovaFiles().list(dname, this.parseOptionsLiteral(optionsExpr)) : fs.readdirSync(dname);
           this.maps['lastFileList'] = files;
           this._log(`${dname}: ${files.join(', ')}`);
         } catch (e) {
@@ -9800,9 +10042,16 @@ if (typeArgs.length > 0 && structDef.params) {
           // Map shell names to paths
           let shellPath = `/bin/${shell}` || '/bin/bash';
 
-          const output = execSync(cmd, { shell: shellPath, encoding: 'utf8' });
-          this._log(output.trim());
-          this.maps['lastTermOutput'] = output.trim();
+          // Lines are printed as the command produces them.
+          const lines = [];
+          const { code } = this._streamLines([[shellPath, '-c', cmd]], (line) => {
+            if (this.loggable) console.log(line);
+            lines.push(line);
+          });
+          if (code !== 0) throw new Error(`Command failed with exit code ${code}: ${cmd}`);
+          const output = lines.join('\n').trim();
+          this.resultOutput = '\n' + output;
+          this.maps['lastTermOutput'] = output;
         } catch (e) {
           this._log(`${shell} term error: ${e.message}`);
           this.maps['lastTermOutput'] = '';
@@ -10041,11 +10290,13 @@ if (typeArgs.length > 0 && structDef.params) {
           if (shouldconti) { shouldconti = false; continue; };
         }
       } else if (current === 'macro') {
+        const start = pos;
         next();
         const name = this.evaluateExpr(next());
         const body = this.evaluateExpr((parseParen()));
         expect(';');
         this.macros[name] = body;
+        define('macro ' + name, start);
       } else if (current === 'namespace') {
         next();
 	let name = parseUntilSem();
@@ -10580,7 +10831,29 @@ session("${name}") {
         if (shouldFinalize) break;
 
         continue;
+      } else if (current === 'memo' && !this.functions[current]) {
+        // memo func name(args) => { ... };  memo(opts) func ...: opts is a
+        // capacity or { capacity, policy: "lru" | "lfu", ttl }
+        const start = pos;
+        next();
+        let opts;
+        if (peek() === '(') {
+          const text = parseParen().trim();
+          opts = text.startsWith('{') ? this.parseOptionsLiteral(text) : this.evaluateExpr(text);
+        }
+        expect('func');
+        const funcName = next();
+        const paramsStr = parseParen();
+        expect('=>');
+        const valueBlock = parseBlock();
+        expect(';');
+        this.functions[funcName] = Memoize(this.extract({
+          args: this.parseArr(paramsStr),
+          body: valueBlock
+        }), opts);
+        define('func ' + funcName, start);
       } else if (current === 'func') {
+        const start = pos;
         next();
         const funcName = next();
         const paramsStr = parseParen();
@@ -10591,20 +10864,25 @@ session("${name}") {
           args: this.parseArr(paramsStr),
           body: valueBlock
         });
+        define('func ' + funcName, start);
       } else if (current === 'ifunc') {
+        const start = pos;
         next(); // skip 'ifunc'
         const name = next(); // function name
         const arg = parseParen().trim();
         const body = parseBlock();
         expect(';');
         this.infuncs[name] = { arg, body };
+        define('ifunc ' + name, start);
       } else if (current === 'function') {
+        const start = pos;
         next(); // skip 'function'
         const name = next(); // function name
         const args = parseParen().split(',').map(s => s.trim()).filter(Boolean); // argument names
         const body = parseBlock();
 
         this.functions[name] = { args, body };
+        define('func ' + name, start);
         continue;
       } else if (this.infuncs[current]) {
         const fnName = next();
@@ -10654,11 +10932,13 @@ session("${name}") {
         const expr = this.evaluateExpr(parseUntil('=>'));
         let iterable;
 
-        const parsed = this.parseArray(expr);
+        // arrays, typed arrays and ranges are walked as they are: a range
+        // yields its elements one at a time
+        const parsed = isIterator(expr) || this.typeof(expr) === 'array' ? expr : this.parseArray(expr);
         iterable = parsed;
 
 
-        if (!Array.isArray(iterable)) {
+        if (this.typeof(iterable) !== 'array' && !isIterator(iterable)) {
           throw `Nova runtime error: 'loop in' requires iterable array, got: ${typeof iterable}`;
         }
 
@@ -10734,7 +11014,7 @@ session("${name}") {
         const path = this.evaluateExpr((parseParen())).trim();
         expect(';');
         try {
-          require('child_process').execSync(`termux-share -a send -u ${path}`);
+          this._runTool(['termux-share', '-a', 'send', '-u', path]);
           this._log(`Shared file: ${path}`);
         } catch (e) {
           this._log('error: ' + e.message);
@@ -10744,7 +11024,7 @@ session("${name}") {
         const outputPath = this.evaluateExpr((parseParen())).trim();
         expect(';');
         try {
-          require('child_process').execSync(`termux-camera-photo -c 0 -o ${outputPath}`);
+          this._runTool(['termux-camera-photo', '-c', 0, '-o', outputPath]);
           this._log(`Photo saved to ${outputPath}`);
         } catch (e) {
           this._log('error: ' + e.message);
@@ -10756,7 +11036,7 @@ session("${name}") {
         const [title, content] = parseParen().split(',').map(v => this.evaluateExpr(v.trim()));
         expect(';');
         try {
-          require('child_process').execSync(`termux-notification --title "${title}" --content "${content}"`);
+          this._runTool(['termux-notification', '--title', title, '--content', content]);
           this._log(`Notified: ${title}`);
         } catch (e) {
           this._log('error: ' + e.message);
@@ -10766,7 +11046,7 @@ session("${name}") {
         const text = this.evaluateExpr((parseParen()));
         expect(';');
         try {
-          require('child_process').execSync(`termux-clipboard-set <<< "${text}"`);
+          this._runTool(['termux-clipboard-set'], text);
           this._log(`Copied to clipboard`);
         } catch (e) {
           this._log('error: ' + e.message);
@@ -10778,7 +11058,7 @@ session("${name}") {
         const pathOrUrl = this.evaluateExpr((parseParen())).trim();
         expect(';');
         try {
-          require('child_process').execSync(`termux-open '${pathOrUrl}'`);
+          this._runTool(['termux-open', pathOrUrl]);
           this._log(`Opened: ${pathOrUrl}`);
         } catch (e) {
           this._log('error: ' + e.message);
@@ -10790,7 +11070,7 @@ session("${name}") {
         const varName = next(); // Variable to store the JSON ringtone list
         expect(';');
         try {
-          const ringtoneList = require('child_process').execSync('termux-ringtones').toString().trim();
+          const ringtoneList = this._runTool(['termux-ringtones']);
           this.maps[varName] = JSON.parse(ringtoneList); // Parse the JSON output
         } catch (e) {
           this._log('error: ' + e.message);
@@ -10802,7 +11082,7 @@ session("${name}") {
         const message = this.evaluateExpr((parseParen())); // Expecting a string message
         expect(';');
         try {
-          require('child_process').execSync(`termux-toast "${message}"`);
+          this._runTool(['termux-toast', message]);
         } catch (e) {
           this._log('error: ' + e.message);
         }
@@ -10812,7 +11092,7 @@ session("${name}") {
         expect(';');
         try {
           // You might want to add validation here to ensure duration is a number
-          require('child_process').execSync(`termux-vibrate -d ${duration}`);
+          this._runTool(['termux-vibrate', '-d', duration]);
           this._log(`Vibrated for ${duration}ms`);
         } catch (e) {
           this._log('error: ' + e.message);
@@ -10826,7 +11106,7 @@ session("${name}") {
         expect(')');
         expect(';');
         try {
-          require('child_process').execSync(`termux-notification -t "${title}" -c "${content}"`);
+          this._runTool(['termux-notification', '-t', title, '-c', content]);
           this._log(`Displayed notification with title "${title}" and content "${content}"`);
         } catch (e) {
           this._log('error: ' + e.message);
@@ -10837,7 +11117,7 @@ session("${name}") {
         const varName = next(); // Variable to store the brightness level
         expect(';');
         try {
-          const brightness = require('child_process').execSync('termux-brightness').toString().trim();
+          const brightness = this._runTool(['termux-brightness']);
           this.maps[varName] = parseInt(brightness, 10); // Store as integer
         } catch (e) {
           this._log('error: ' + e.message);
@@ -10848,7 +11128,7 @@ session("${name}") {
         expect(';');
         try {
           // Add validation to ensure level is between 0 and 255
-          require('child_process').execSync(`termux-brightness ${level}`);
+          this._runTool(['termux-brightness', level]);
           this._log(`Set brightness to ${level}`);
         } catch (e) {
           this._log('error: ' + e.message);
@@ -10859,7 +11139,7 @@ session("${name}") {
         const varName = next(); // Variable to store the JSON battery info
         expect(';');
         try {
-          const batteryInfo = require('child_process').execSync('termux-battery-status').toString().trim();
+          const batteryInfo = this._runTool(['termux-battery-status']);
           this.maps[varName] = JSON.parse(batteryInfo); // Parse the JSON output
           this._log(`Battery status stored in ${varName}`);
         } catch (e) {
@@ -10874,7 +11154,7 @@ session("${name}") {
         expect(')');
         expect(';');
         try {
-          require('child_process').execSync(`termux-sms-send -n "${phoneNumber}" "${message}"`);
+          this._runTool(['termux-sms-send', '-n', phoneNumber, message]);
           this._log(`Sent SMS to ${phoneNumber}: "${message}"`);
         } catch (e) {
           this._log('error: ' + e.message);
@@ -10885,7 +11165,7 @@ session("${name}") {
         const varName = next(); // Variable to store the JSON call log
         expect(';');
         try {
-          const callLog = require('child_process').execSync('termux-call-log').toString().trim();
+          const callLog = this._runTool(['termux-call-log']);
           this.maps[varName] = JSON.parse(callLog); // Parse the JSON output
           this._log(`Call log stored in ${varName}`);
         } catch (e) {
@@ -10897,7 +11177,7 @@ session("${name}") {
         const varName = next(); // Variable to store the JSON contact list
         expect(';');
         try {
-          const contactList = require('child_process').execSync('termux-contact-list').toString().trim();
+          const contactList = this._runTool(['termux-contact-list']);
           this.maps[varName] = JSON.parse(contactList); // Parse the JSON output
           this._log(`Contact list stored in ${varName}`);
         } catch (e) {
@@ -10912,7 +11192,7 @@ session("${name}") {
         expect(')');
         expect(';');
         try {
-          require('child_process').execSync(`termux-camera-photo -c ${cameraId} "${outputPath}"`);
+          this._runTool(['termux-camera-photo', '-c', cameraId, outputPath]);
           this._log(`Took photo with camera ${cameraId} and saved to "${outputPath}"`);
         } catch (e) {
           this._log('error: ' + e.message);
@@ -10948,7 +11228,7 @@ session("${name}") {
         }
 
         try {
-          const result = require('child_process').execSync(command).toString().trim();
+          const result = this._runTool(require('shell-quote').parse(command).filter(a => typeof a === 'string'));
           this._log(`Termux Dialog (${dialogType}) Result: ` + result);
           // You might want to parse the result (e.g., "true"/"false" for confirm, or entered text)
           return result;
@@ -10963,7 +11243,7 @@ session("${name}") {
         expect(';');
         try {
           // Add validation for 'on' or 'off'
-          require('child_process').execSync(`termux-torch ${state}`);
+          this._runTool(['termux-torch', state]);
           this._log(`Torch set to ${state}`);
         } catch (e) {
           this._log('error: ' + e.message);
@@ -10974,7 +11254,7 @@ session("${name}") {
         const varName = next(); // Variable to store the JSON Wi-Fi info
         expect(';');
         try {
-          const wifiInfo = require('child_process').execSync('termux-wifi-connectioninfo').toString().trim();
+          const wifiInfo = this._runTool(['termux-wifi-connectioninfo']);
           this.maps[varName] = JSON.parse(wifiInfo); // Parse the JSON output
           this._log(`Wi-Fi connection info stored in ${varName}`);
         } catch (e) {
@@ -10986,7 +11266,7 @@ session("${name}") {
         const varName = next(); // Variable to store the JSON location info
         expect(';');
         try {
-          const locationInfo = require('child_process').execSync('termux-location').toString().trim();
+          const locationInfo = this._runTool(['termux-location']);
           this.maps[varName] = JSON.parse(locationInfo); // Parse the JSON 
           this._log(`Location info stored in  ${varName}`);
         } catch (e) {
@@ -11002,7 +11282,7 @@ session("${name}") {
         expect(';');
         try {
           // Use -q for quiet mode and -d for duration
-          require('child_process').execSync(`termux-microphone-record -f "${outputPath}" -d ${duration}`);
+          this._runTool(['termux-microphone-record', '-f', outputPath, '-d', duration]);
         } catch (e) {
           this._log('error: ' + e.message);
         }
@@ -11010,7 +11290,7 @@ session("${name}") {
         next();
         expect(';');
         try {
-          require('child_process').execSync('termux-microphone-record -s');
+          this._runTool(['termux-microphone-record', '-s']);
         } catch (e) {
           this._log('error: ' + e.message);
         }
@@ -11021,7 +11301,7 @@ session("${name}") {
         expect(';'); // Expect a semicolon after the variable name
         try {
           // Use termux-clipboard-set to copy the variable's value to the clipboard
-          require('child_process').execSync(`termux-clipboard-set "${this.evaluateExpr(varName)}"`);
+          this._runTool(['termux-clipboard-set', this.evaluateExpr(varName)]);
           this._log(`Copied **${varName}** to clipboard!`);
         } catch (e) {
           this._log(`Error copying to clipboard: ${e.message}`); // Log specific error message
@@ -11033,7 +11313,7 @@ session("${name}") {
         expect(';'); // Expect a semicolon after the variable name
         try {
           // Use termux-clipboard-get to retrieve content from the clipboard
-          const clipboardContent = require('child_process').execSync('termux-clipboard-get').toString().trim();
+          const clipboardContent = this._runTool(['termux-clipboard-get']);
           this.maps[varName] = clipboardContent; // Assign clipboard content to the variable
           this._log(`Pasted clipboard content into **${varName}**`);
         } catch (e) {
@@ -11448,54 +11728,83 @@ session("${name}") {
         };
       } else if (current === 'http') {
         next(); // 'http'
-        const method = next(); // GET, POST, etc.
-        const url = this.evaluateExpr(parseParen()).trim();
+        const settle = (response) => {
+          this.maps['res'] = response.body.trim();
+          this.maps['status'] = response.status;
+          this.maps['resHeaders'] = response.headers;
+        };
+        const failed = (e) => {
+          this.maps['res'] = '';
+          this.maps['status'] = 500;
+          console.error('[NOVA_HTTP_ERR]', e.message);
+        };
 
-        let body = '';
-        let headers = [];
+        if (peek() === 'wait') {
+          // http wait p;  blocks on a request started with `http async`
+          next();
+          const name = next();
+          expect(';');
+          try {
+            if (!AsyncNative()) throw new Error('http wait needs the async native addon');
+            settle(AsyncNative().awaitBlock(Promise.resolve(this.maps[name])));
+          } catch (e) {
+            failed(e);
+          }
+        } else {
+          let isAsync = false;
+          if (peek() === 'async') { next(); isAsync = true; }
+          const method = next(); // GET, POST, etc.
+          const url = this.evaluateExpr(parseParen()).trim();
 
-        if (peek() === '{') {
-          next(); // Consume '{'
+          let body = '';
+          let headers = {};
 
-          while (peek() !== '}') {
-            const key = next();
+          if (peek() === '{') {
+            next(); // Consume '{'
 
-            if (key === 'headers') {
-              expect('=');
-              const headerBlock = this.evaluateExpr(parseBlock());
-              const keolObj = parseKeol(headerBlock);
-              const parsedHeaders = keolObj?.default ?? keolObj;
+            while (peek() !== '}') {
+              const key = next();
 
-              headers = Object.entries(parsedHeaders)
-                .map(([k, v]) => `-H "${k}: ${v}"`);
-              expect(';');
-            }
+              if (key === 'headers') {
+                expect('=');
+                const headerBlock = this.evaluateExpr(parseBlock());
+                const keolObj = parseKeol(headerBlock);
+                const parsedHeaders = keolObj?.default ?? keolObj;
 
-            else if (key === 'body') {
-              expect('=');
-              body = this.evaluateExpr(next());
-              expect(';');
-            }
+                headers = { ...parsedHeaders };
+                expect(';');
+              }
 
-            else {
-              throw `❌ Unexpected key in http block: '${key}'`;
-            }
-          }
+              else if (key === 'body') {
+                expect('=');
+                body = this.evaluateExpr(next());
+                expect(';');
+              }
 
-          expect('}');
-          expect(';');
-        }
+              else {
+                throw `❌ Unexpected key in http block: '${key}'`;
+              }
+            }
 
-        const curl = `curl -s -X ${method.toUpperCase()} ${headers.join(' ')} ${body ? `--data '${body}'` : ''} "${url}"`;
+            expect('}');
+          }
+          let target = 'res';
+          if (peek() === '=>') { next(); target = next(); }
+          if (peek() === ';') next();
 
-        try {
-          const response = execSync(curl, { encoding: 'utf8' });
-          this.maps['res'] = response.trim();
-          this.maps['status'] = 200;
-        } catch (e) {
-          this.maps['res'] = '';
-          this.maps['status'] = 500;
-          console.error('[NOVA_HTTP_ERR]', e.message);
+          if (isAsync) {
+            // Promise of { status, headers, body }; several can be in flight at once.
+            // A failure surfaces on `http wait`, not as an unhandled rejection.
+            const pending = NovaHttp().request(method, url, { headers, body });
+            pending.catch(() => {});
+            this.maps[target] = pending;
+          } else {
+            try {
+              settle(NovaHttp().requestSync(method, url, { headers, body }));
+            } catch (e) {
+              failed(e);
+            }
+          }
         }
       }
       else if (current === 'osPlatform') {
@@ -11630,14 +11939,53 @@ session("${name}") {
       } else if (current === 'sh') {
         next();
         const shellCmd = this.evaluateExpr(parseBlock());
-        const { execSync } = require('child_process');
         try {
-          const output = execSync(shellCmd, { encoding: 'utf8' });
-          this._log(output.trim());
+          // Streamed line by line; nothing is kept once printed.
+          const { code } = this._streamLines([['/bin/sh', '-c', shellCmd]], (line) => this._log(line));
+          if (code !== 0) this._log(`Command failed with exit code ${code}: ${shellCmd}`);
         } catch (e) {
           this._log(e.message);
         }
         expect(';');
+      } else if (current === 'proc' && !this.functions[current]) {
+        // proc("cmd") => line { ... };                 body runs once per output line
+        // proc(["cat", f], ["grep", "x"]) => line { ... };   argv pipeline, no shell
+        // proc async(...) => line { ... } => h;  ...  proc wait h;
+        next();
+        if (peek() === 'wait') {
+          next();
+          const name = next();
+          expect(';');
+          const handle = this.maps[name];
+          if (!handle || !handle.streaming) throw new Error(`proc wait: ${name} is not a running process`);
+          if (!AsyncNative()) throw new Error('proc wait needs the async native addon');
+          this.maps['status'] = AsyncNative().awaitBlock(handle.streaming).code;
+        } else {
+          let isAsync = false;
+          if (peek() === 'async') { next(); isAsync = true; }
+          const stages = this._commandStages(parseParen());
+          expect('=>');
+          const lineVar = next();
+          const compiled = this.compile(parseBlock());
+          const onLine = (line) => {
+            this.maps[lineVar] = line;
+            this.runCompiled(compiled);
+          };
+          if (isAsync) {
+            expect('=>');
+            const target = next();
+            expect(';');
+            if (!Proc()) throw new Error('proc async needs the proc native addon');
+            // Runs alongside the script; lines are handled whenever the event loop turns.
+            // A failure surfaces on `proc wait`, not as an unhandled rejection.
+            const streaming = Proc().run(stages).each(onLine);
+            streaming.catch(() => {});
+            this.maps[target] = { streaming };
+          } else {
+            expect(';');
+            this.maps['status'] = this._streamLines(stages, onLine).code;
+          }
+        }
       } else if (current === 'sandbox') {
         next();
         const codeBlock = this.evaluateExpr(parseBlock()); // ← pull user's code block
@@ -11685,21 +12033,28 @@ session("${name}") {
         expect('=>');
         const varName = this.evaluateExpr(next());
         expect(';');
-        this.enums[varName] = this.evaluateExpr(arr).slice().reverse();
+        // an array is used as is: evaluating it again would print and re-parse it
+        this.enums[varName] = NovaArrays().reverse(this.typeof(arr) === 'array' ? arr : this.evaluateExpr(arr));
       } else if (current === 'ascii') {
         next();
         const str = this.evaluateExpr(parseParen());
         expect('=>');
         const varName = this.evaluateExpr(next());
         expect(';');
-        this.enums[varName] = this.evaluateExpr(str).split('').map(c => c.charCodeAt(0));
-      } else if (current === 'sum') {
+        this.enums[varName] = String(str).split('').map(c => c.charCodeAt(0));
+      } else if (current === 'sum' || (['min', 'max', 'mean'].includes(current) && !this.functions[current] &&
+          tokens[pos + 1] === '(' && afterParen(pos + 1) === '=>')) {
+        // sum(xs) => s;  min / max / mean alike unless the script defines a
+        // function by that name; `sum(xs, kahan)` and `mean(xs, kahan)` use
+        // compensated summation
         next();
-        const arr = this.evaluateExpr(parseParen());
+        const body = parseParen();
+        const kahan = /,\s*kahan\s*$/.test(body);
+        const arr = this.evaluateExpr(kahan ? body.replace(/,\s*kahan\s*$/, '') : body);
         expect('=>');
         const varName = this.evaluateExpr(next());
         expect(';');
-        this.maps[varName] = this.evaluateExpr(arr).reduce((a, b) => a + b, 0);
+        this.maps[varName] = NovaArrays()[current](this.typeof(arr) === 'array' ? arr : this.evaluateExpr(arr), kahan);
       } else if (current === 'keys') {
         next();
         const obj = this.evaluateExpr(parseParen());
@@ -11713,10 +12068,7 @@ session("${name}") {
         expect('=>');
         let varName = this.evaluateExpr(next());
         expect(';');
-        this.enums[varName] = Array.from(
-          { length: this.evaluateExpr(end) - this.evaluateExpr(start) },
-          (_, i) => i + this.evaluateExpr(start)
-        );
+        this.enums[varName] = NovaArrays().range(start, end);
       } else if (current === 'plugin' && !this.options?.strict) {
         next();
         let path = this.evaluateExpr(parseParen());
@@ -11791,14 +12143,21 @@ session("${name}") {
         const block = parseBlock();               // block to run
 
         const map = this.evaluateExpr(mapName.trim());
-        let arr = (typeof map === 'object') ? Object.keys(map) : map
-        arr.forEach((key, i, y) => {
+        const each = (key, i, y) => {
           this.maps[keyVar[0]] = key;
 	  this.maps[keyVar[1] || 'iter_i'] = i;
           this.maps[keyVar[2] || 'iter_third_arg'] = y;
 
           this.exec(block);
-        });
+        };
+        if (map instanceof NovaRange) {
+          // a range gives its values, one at a time
+          let i = 0;
+          for (const v of map) each(v, i++, map);
+        } else {
+          let arr = (typeof map === 'object') ? Object.keys(map) : map
+          arr.forEach(each);
+        }
       } else if (current === 'engage') {
         next();
 
@@ -12029,8 +12388,7 @@ session("${name}") {
         next();
         const ms = Number(this.evaluateExpr(parseParen()));
         expect(';');
-        const wait = Date.now() + ms;
-        while (Date.now() < wait); // Brutal scync sleep, baby
+        sleepSync(ms / 1000);
       }
       else if (current === 'envkeys') {
         next(); expect(';');
@@ -12059,8 +12417,10 @@ session("${name}") {
       } else if (current === 'server') {
         next(); // Consume 'server' keyword
 
-        // Parse the port number, could be a literal or a variable
-        const port = this.evaluateExpr(parseParen()); // e.g., server(3000) or server(myPort)
+        // Parse the port number, could be a literal or a variable, plus options
+        const [portExpr, optionsExpr] = splitFirstComma(parseParen()); // e.g., server(3000, { workers: 4 })
+        const port = this.evaluateExpr(portExpr);
+        const serverOptions = optionsExpr ? this.parseOptionsLiteral(optionsExpr) : {};
         expect('{'); // Expecting the block for server routes
 
         const routes = [];
@@ -12075,68 +12435,21 @@ session("${name}") {
             expect(';');
 
             routes.push({ method, path, handlerBody });
+          } else if (method === 'static') {
+            // static("public"); or static("/assets", "public");
+            next();
+            const [first, second] = splitFirstComma(parseParen());
+            const dir = this.evaluateExpr(second ?? first);
+            const path = second === undefined ? '/' : this.evaluateExpr(first);
+            expect(';');
+            routes.push({ method, path, dir });
           } else {
-            throw new Error(`Unexpected token '${method}' inside server block. Expected 'get', 'post', etc.`);
+            throw new Error(`Unexpected token '${method}' inside server block. Expected 'get', 'post', 'static', etc.`);
           }
         }
         expect('}');
         expect(';'); // Expecting a semicolon after the server definition
 
-        // --- Execution Phase ---
-        // This part would typically happen in your runtime/interpreter, not necessarily in the parser.
-        // However, for demonstration, I'm including it here.
-
-        const express = require('express');
-        const app = express();
-        app.use(express.json());
-
-        routes.forEach(({ method, path, handlerBody }) => {
-          app[method](path, (req, res) => {
-            this.maps['req'] = req; // Make 'req' available in the script's scope
-            this.maps['res'] = res; // Make 'res' available in the script's scope
-            this.maps['reqBody'] = req.body;
-            this.maps['resBody'] = res.body;
-            this.functions['send'] = (data) => {
-              res.send(data); // Custom send function to respond
-            };
-            this.functions['html'] = (htmlString, options = {}) => {
-              // Import cheerio dynamically to ensure it's loaded only when needed,
-              // or if this code is part of a larger module, it can be imported at the top.
-              const cheerio = require('cheerio');
-
-              if (typeof htmlString !== 'string') {
-                console.error("Error: Input to 'html' function must be a string.");
-                return null;
-              }
-
-              try {
-                // Use cheerio.load() to parse the HTML string
-                const $ = cheerio.load(htmlString, options);
-                console.log("HTML string parsed successfully.");
-                return $; // Return the Cheerio object for further manipulation
-              } catch (error) {
-                console.error("Error parsing HTML string:", error);
-                return null;
-              }
-            };
-            this.functions['json'] = (data) => {
-              res.json(data); // Custom json function to respond with JSON
-            };
-            this.functions['status'] = (statusCode) => {
-              res.status(statusCode); // Custom status function to set response status
-            };
-
-            try {
-              this.run(handlerBody); // Execute the parsed route handler
-            } catch (e) {
-              console.error(`Error in route ${method.toUpperCase()} ${path}:`, e);
-              if (!res.headersSent) {
-                res.status(500).send('Internal Server Error');
-              }
-            }
-          });
-        });
-
         // Convert the port to a number, handling variables if necessary
         let resolvedPort;
         if (this.maps[port] !== undefined) {
@@ -12149,9 +12462,15 @@ session("${name}") {
           throw new Error(`Invalid port number: ${port}`);
         }
 
-        app.listen(resolvedPort, () => {
-          console.log(`Server running on port ${resolvedPort}`);
-        });
+        const workers = Number(serverOptions.workers) || 1;
+        if (workers > 1) {
+          // server(port, { workers: N }): N interpreter processes share the port.
+          NovaCluster().startCluster(this, { ...serverOptions, port: resolvedPort, routes, workers });
+        } else {
+          this.createServerApp(routes).listen(resolvedPort, () => {
+            console.log(`Server running on port ${resolvedPort}`);
+          });
+        }
       } else if (current === '"IS CLI"') {
         next(); // Consume 'commander' keyword
         expect('=');
@@ -12198,7 +12517,7 @@ session("${name}") {
         let name = next();
         let val = parseParen();
         this.maps[name] = this.evaluateExpr(name);
-        if (Array.isArray(this.maps[name])) { this.maps[name].push(this.evaluateExpr(val)); expect(';'); }
+        if (this.typeof(this.maps[name]) === 'array') { this.maps[name] = NovaArrays().append(this.maps[name], this.evaluateExpr(val)); expect(';'); }
         else this.maps[name][this.evaluateExpr(val)] = this.evaluateExpr(parseUntilSem());
       }
       else if (current === 'require') {
@@ -12401,6 +12720,10 @@ session("${name}") {
       stopWatcher();
       if (options?.oneRun) return { tokens, cleaned, code, pos, res: this.resultOutput };
     }
+    } finally {
+      // A statement that throws must not leave the watcher spinning.
+      stopWatcher();
+    }
     this.processAsyncQueqe(true);
 Object.keys(this.fnopts).forEach((a) => {
   if (this.options[a]) {
@@ -12412,44 +12735,57 @@ Object.keys(this.fnopts).forEach((a) => {
 });
   }
 
-  processAsyncQueqe(flushAll = false) {
-    // Run processing asynchronously to avoid recursive stack growth
-    setTimeout(() => {
-      let i = 0;
-      while (i < this.asyncQueqe.length) {
-        const event = this.asyncQueqe[i];
-        if (!(typeof event?.callback === 'function' || event?.ready)) {
-          i++;
-          continue;
-        }
-        if (event.ready || flushAll) {
+  asyncTimers() {
+    let timers = asyncTimers.get(this);
+    if (!timers) {
+      const callbacks = new Map();
+      const fire = (ids) => {
+        for (const id of ids) {
+          const callback = callbacks.get(id);
+          callbacks.delete(id);
+          if (typeof callback !== 'function') continue;
           try {
-            event.callback();
+            callback();
           } catch (err) {
             console.error("AsyncQueue callback error:", err);
           }
-          this.asyncQueqe.splice(i, 1); // remove finished
-        } else {
-          i++;
         }
-      }
-    }, 0);
+      };
+      const native = AsyncNative();
+      const wheel = native?.TimerWheel ? new native.TimerWheel(fire) : timeoutWheel(fire);
+      timers = { wheel, callbacks };
+      asyncTimers.set(this, timers);
+    }
+    return timers;
+  }
+
+  // Due events are fired by the timer wheel itself; flushAll runs every
+  // pending one right away.
+  processAsyncQueqe(flushAll = false) {
+    const timers = asyncTimers.get(this);
+    if (!flushAll || !timers || timers.wheel.size() === 0) return;
+    setTimeout(() => timers.wheel.flush(), 0);
   }
 
   scheduleAsync(callback, delay = 0) {
-    const event = {
-      callback,
-      ready: false
-    };
-    setTimeout(() => {
-      event.ready = true;
-      // Automatically process when ready
-      this.processAsyncQueqe();
-    }, delay);
-    this.asyncQueqe.push(event);
+    const { wheel, callbacks } = this.asyncTimers();
+    const id = wheel.add(Number(delay) || 0);
+    callbacks.set(id, callback);
+    return id;
+  }
+
+  cancelAsync(id) {
+    const timers = asyncTimers.get(this);
+    if (!timers) return false;
+    timers.callbacks.delete(id);
+    return timers.wheel.cancel(id);
   }
   awaitSync(fn, ...args) {
-    return fn(...args);
+    const result = fn(...args);
+    if (!result || typeof result.then !== 'function') return result;
+    // Block until the promise settles by pumping the event loop natively.
+    const native = AsyncNative();
+    return native ? native.awaitBlock(Promise.resolve(result)) : result;
   }
   debug(expr) {
     if (this.options.maxedDebug) {
@@ -12534,6 +12870,100 @@ Object.keys(this.fnopts).forEach((a) => {
     return this.resultOutput;
   }
 
+  // Express app for a parsed `server` block: [{ method, path, handlerBody }].
+  // Shared by the single-process server and nova-cluster workers.
+  createServerApp(routes, app) {
+    const express = require('express');
+    app = app || express();
+    app.use(express.json());
+
+    const html = (htmlString, options = {}) => {
+      // Import cheerio dynamically to ensure it's loaded only when needed,
+      // or if this code is part of a larger module, it can be imported at the top.
+      const cheerio = require('cheerio');
+
+      if (typeof htmlString !== 'string') {
+        console.error("Error: Input to 'html' function must be a string.");
+        return null;
+      }
+
+      try {
+        // Use cheerio.load() to parse the HTML string
+        const $ = cheerio.load(htmlString, options);
+        console.log("HTML string parsed successfully.");
+        return $; // Return the Cheerio object for further manipulation
+      } catch (error) {
+        console.error("Error parsing HTML string:", error);
+        return null;
+      }
+    };
+
+    routes.forEach(({ method, path, handlerBody, dir }) => {
+      if (method === 'static') {
+        app.use(path, NovaStatic().serveStatic(dir));
+        return;
+      }
+      // Tokenized once here instead of on every request.
+      const compiled = this.compile(handlerBody);
+      app[method](path, (req, res) => {
+        // Each request gets its own variable/function layer, so a handler
+        // that yields to the event loop (http wait, awaitSync) can't have
+        // req/res swapped by a request that arrives meanwhile.
+        const shared = { maps: this.maps, functions: this.functions };
+        this.maps = layeredScope(shared.maps, { req, res, reqBody: req.body, resBody: res.body });
+        this.functions = layeredScope(shared.functions, {
+          send: (data) => res.send(data),
+          json: (data) => res.json(data),
+          status: (statusCode) => res.status(statusCode),
+          sendFile: (file) => NovaStatic().sendFile(req, res, file).then((sent) => {
+            if (!sent && !res.headersSent) res.status(404).send('Not Found');
+          }, (err) => {
+            console.error(`Error in route ${method.toUpperCase()} ${path}:`, err);
+            if (!res.headersSent) res.status(500).send('Internal Server Error');
+          }),
+          html,
+        });
+
+        try {
+          this.runCompiled(compiled); // Execute the precompiled route handler
+        } catch (e) {
+          console.error(`Error in route ${method.toUpperCase()} ${path}:`, e);
+          if (!res.headersSent) {
+            res.status(500).send('Internal Server Error');
+          }
+        } finally {
+          this.maps = shared.maps;
+          this.functions = shared.functions;
+        }
+      });
+    });
+    return app;
+  }
+
+  // `{ key: value, key2 = value2 }` -> object, values evaluated as Nova expressions.
+  parseOptionsLiteral(text) {
+    const options = {};
+    const inner = String(text).trim().replace(/^\{/, '').replace(/\}$/, '');
+    for (const pair of this._splitArgs(inner).flatMap((p) => p.split(';'))) {
+      const m = /^\s*["']?(\w+)["']?\s*[:=]\s*([\s\S]+?)\s*$/.exec(pair);
+      if (m) options[m[1]] = this.evaluateExpr(m[2]);
+    }
+    return options;
+  }
+
+  // Tokenizes a block once so it can be executed many times (server
+  // handlers) without going through nvopt and the tokenizer again.
+  compile(code) {
+    code = require('./nvopt.js')(this._replaceMacros(code));
+    const { code: cleaned, tokens } = this.tokenize(code);
+    return { code, cleaned, tokens };
+  }
+  runCompiled(compiled) {
+    this.execute(null, { compiled });
+    if (this.options?.allowRetsAsPrinted) console.log(this.resultOutput);
+    return this.resultOutput;
+  }
+
   _replaceResu(str) {
     // Match myResu$1, 18$
     return str.replace(/\b([a-zA-Z_]\w*)\$([^$]+)\$/g, (match, resuName, argsStr) => {
@@ -12664,6 +13094,107 @@ Object.keys(this.fnopts).forEach((a) => {
     result = this._replaceMaps(result);
     return result;
   }
+  // UI with an `id` is retained: the widget keeps its state and position on the
+  // native screen, calls merge new options into that state and only the cells
+  // that changed since the last frame are written to the terminal.
+  _renderRetainedUI(options) {
+    const screen = Screen();
+    if (!screen || !process.stdout.isTTY) return false;
+    if (!this.uiWidgets) {
+      this.uiWidgets = {};
+      this.uiNextRow = 0;
+      screen.init(process.stdout.rows || 24, process.stdout.columns || 80);
+      process.stdout.on('resize', () => {
+        screen.init(process.stdout.rows || 24, process.stdout.columns || 80);
+        for (const w of Object.values(this.uiWidgets)) screen.setContent(w.id, generateConsoleUI(w.state));
+        process.stdout.write(screen.frame());
+      });
+    }
+    const id = String(options.id);
+    let widget = this.uiWidgets[id];
+    if (!widget) {
+      widget = this.uiWidgets[id] = { id, state: {}, row: options.row ?? this.uiNextRow, col: options.col ?? 0 };
+    }
+    Object.assign(widget.state, options);
+    if (options.row !== undefined) widget.row = options.row;
+    if (options.col !== undefined) widget.col = options.col;
+    screen.widget(id, widget.row, widget.col);
+    const { rows } = screen.setContent(id, generateConsoleUI(widget.state));
+    if (options.row === undefined) this.uiNextRow = Math.max(this.uiNextRow, widget.row + rows + 1);
+    const out = screen.frame();
+    if (out) process.stdout.write(out);
+    return true;
+  }
+  // Variables a block sent to the worker pool can see: only the ones it names,
+  // so a big unrelated map in scope isn't cloned for every job.
+  _captureVars(body) {
+    const vars = {};
+    for (const name of new Set(body.match(/[A-Za-z_]\w*/g) || [])) {
+      if (name === 'i' || !Object.prototype.hasOwnProperty.call(this.maps, name)) continue;
+      const v = this.maps[name];
+      if (typeof v !== 'function') vars[name] = v;
+    }
+    return vars;
+  }
+  // `proc` arguments: "cmd" runs through /bin/sh, ["prog", arg, ...]
+  // is an argv (no shell, no quoting); several arguments form a pipeline.
+  _commandStages(argText) {
+    return this._splitArgs(argText).map((arg) => {
+      arg = arg.trim();
+      const value = arg.startsWith('[') && arg.endsWith(']')
+        ? this._splitArgs(arg.slice(1, -1)).map(a => this.evaluateExpr(a.trim()))
+        : this.evaluateExpr(arg);
+      return Array.isArray(value) ? value.map(String) : ['/bin/sh', '-c', String(value)];
+    });
+  }
+  // Feeds a command's stdout to onLine one line at a time and returns
+  // { code, signal }. Output is never held in memory as a whole, and the
+  // child waits on the pipe while onLine runs. Without the proc addon the
+  // command runs through execSync and its output is buffered.
+  _streamLines(stages, onLine, opts = {}) {
+    const native = Proc();
+    if (!native) {
+      const { quote } = require('shell-quote');
+      const cmd = stages.map(argv => argv[0] === '/bin/sh' && argv[1] === '-c' ? argv[2] : quote(argv)).join(' | ');
+      let out, code = 0;
+      try {
+        out = execSync(cmd, { encoding: 'utf8', maxBuffer: Infinity, stdio: ['inherit', 'pipe', 'inherit'] });
+      } catch (e) {
+        out = e.stdout || '';
+        code = e.status ?? 1;
+      }
+      for (const line of out.split('\n').slice(0, out.endsWith('\n') ? -1 : undefined)) onLine(line);
+      return { code, signal: null };
+    }
+    const proc = native.run(stages, opts);
+    try {
+      for (const line of proc) onLine(line);
+    } catch (e) {
+      proc.kill();
+      proc.wait();
+      throw e;
+    }
+    return proc.wait();
+  }
+  // Runs one program without a shell and returns its trimmed stdout; throws
+  // on a non-zero exit like execSync did.
+  _runTool(argv, input) {
+    argv = argv.map(String);
+    const native = Proc();
+    if (!native) {
+      return require('child_process').execFileSync(argv[0], argv.slice(1), { input, encoding: 'utf8' }).trim();
+    }
+    const proc = native.run([argv], { stdin: input === undefined ? 'ignore' : 'pipe', stderr: 'pipe' });
+    if (input !== undefined) {
+      proc.write(String(input));
+      proc.end();
+    }
+    const out = [...proc.lines()];
+    const err = [...proc.lines('stderr')];
+    const { code } = proc.wait();
+    if (code !== 0) throw new Error(`Command failed: ${argv.join(' ')}${err.length ? '\n' + err.join('\n') : ''}`);
+    return out.join('\n').trim();
+  }
   _log(msg) {
     if (this.loggable) {
       console.log(msg);
@@ -12672,7 +13203,7 @@ Object.keys(this.fnopts).forEach((a) => {
   }
 }
 const env = new nova();
-module.exports = { runNovaCode, runREPLNovaCode, nova, env };
+module.exports = { runNovaCode, runREPLNovaCode, nova, env, generateConsoleUI };
 Object.assign(module.exports, {
   default: env,
 });
@@ -11,4 +11,15 @@ app.whenReady().then(() => {
     webPreferences: { nodeIntegration: false }
   });
   win.loadURL('data:text/html,' + encodeURIComponent(config.content || ''));
-});
\ No newline at end of file
+
+  // Retained windows (windowUI with an id) get their config rewritten in place.
+  fs.watchFile(configPath, { interval: 100 }, () => {
+    let next;
+    try { next = JSON.parse(fs.readFileSync(configPath, 'utf8')); } catch { return; }
+    if (next.title) win.setTitle(next.title);
+    if (next.content !== undefined) {
+      win.webContents.executeJavaScript(`document.body.innerHTML = ${JSON.stringify(next.content)};`).catch(() => {});
+    }
+  });
+  win.on('closed', () => fs.unwatchFile(configPath));
+});
@@ -0,0 +1,45 @@
+// 100k outstanding Nova `async` events: the timer wheel behind
+// env.scheduleAsync against the old setTimeout-per-event queue that was
+// scanned and spliced on every expiry.
+// usage: node bench.js [events] [maxDelayMs]
+const { env } = require('../../core/nova.js');
+
+const n = Number(process.argv[2]) || 100000;
+const maxDelay = Number(process.argv[3]) || 1000;
+const delays = Array.from({ length: n }, (_, i) => (i * 7919) % maxDelay);
+
+function run(label, schedule, done) {
+  let fired = 0;
+  const t0 = process.hrtime.bigint();
+  for (const d of delays) schedule(() => { if (++fired === n) finish(); }, d);
+  const scheduled = Number(process.hrtime.bigint() - t0) / 1e6;
+  const finish = () => {
+    const total = Number(process.hrtime.bigint() - t0) / 1e6;
+    const cpu = process.cpuUsage(cpu0);
+    console.log(`${label.padEnd(8)} events=${n} schedule=${scheduled.toFixed(1)}ms total=${total.toFixed(0)}ms cpu=${((cpu.user + cpu.system) / 1000).toFixed(0)}ms`);
+    done();
+  };
+  const cpu0 = process.cpuUsage();
+}
+
+// The previous implementation, kept here for comparison.
+function legacy() {
+  const queue = [];
+  const process_ = () => setTimeout(() => {
+    let i = 0;
+    while (i < queue.length) {
+      const event = queue[i];
+      if (event.ready) { event.callback(); queue.splice(i, 1); } else i++;
+    }
+  }, 0);
+  return (callback, delay) => {
+    const event = { callback, ready: false };
+    setTimeout(() => { event.ready = true; process_(); }, delay);
+    queue.push(event);
+  };
+}
+
+run('wheel', (cb, d) => env.scheduleAsync(cb, d), () => {
+  if (process.argv.includes('--no-legacy')) return;
+  run('legacy', legacy(), () => {});
+});
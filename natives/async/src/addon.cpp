@@ -1,24 +1,26 @@
 #include <napi.h>
-#include <condition_variable>
-#include <mutex>
-
-struct AwaitData {
-    std::mutex mtx;
-    std::condition_variable cv;
-    bool done = false;
-    Napi::Reference<Napi::Value> result;
-    bool isError = false;
-};
+#include <uv.h>
+#include <chrono>
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#ifndef _WIN32
+#include <poll.h>
+#endif
 
-// AwaitBlock implementation
-Napi::Value AwaitBlock(const Napi::CallbackInfo& info) {
+#include "await.h"
+
+// Resolves the awaitable from info[first]: a Promise, a function returning one
+// (called with the remaining arguments), or a plain value.
+static Napi::Value awaitArgs(const Napi::CallbackInfo& info, size_t first, double timeoutMs) {
     Napi::Env env = info.Env();
-    if (info.Length() < 1) {
+    if (info.Length() <= first) {
         Napi::TypeError::New(env, "Need at least one argument").ThrowAsJavaScriptException();
         return env.Null();
     }
 
-    Napi::Value input = info[0];
+    Napi::Value input = info[first];
     Napi::Value promiseVal;
 
     if (input.IsPromise()) {
@@ -28,11 +30,11 @@ Napi::Value AwaitBlock(const Napi::CallbackInfo& info) {
         // Case 2: a function -> call it with args
         Napi::Function fn = input.As<Napi::Function>();
         std::vector<napi_value> args;
-        for (size_t i = 1; i < info.Length(); i++) {
+        for (size_t i = first + 1; i < info.Length(); i++) {
             args.push_back(info[i]);
         }
         promiseVal = fn.Call(env.Global(), args);
-        if (!promiseVal.IsPromise()) {
+        if (env.IsExceptionPending() || !promiseVal.IsPromise()) {
             // If function returned non-promise, just return
             return promiseVal;
         }
@@ -41,49 +43,273 @@ Napi::Value AwaitBlock(const Napi::CallbackInfo& info) {
         return input;
     }
 
-    // Now we have a Promise
-    Napi::Promise promise = promiseVal.As<Napi::Promise>();
-    auto* data = new AwaitData();
-
-    // Attach then/catch
-    promise.Then(
-        Napi::Function::New(env, [data](const Napi::CallbackInfo& cbInfo) {
-            std::unique_lock<std::mutex> lock(data->mtx);
-            data->result = Napi::Persistent(cbInfo[0]);
-            data->done = true;
-            data->cv.notify_one();
-            return cbInfo.Env().Undefined();
-        }),
-        Napi::Function::New(env, [data](const Napi::CallbackInfo& cbInfo) {
-            std::unique_lock<std::mutex> lock(data->mtx);
-            data->result = Napi::Persistent(cbInfo[0]);
-            data->isError = true;
-            data->done = true;
-            data->cv.notify_one();
-            return cbInfo.Env().Undefined();
-        })
-    );
-
-    // Block until promise resolves
-    std::unique_lock<std::mutex> lock(data->mtx);
-    while (!data->done) {
-        data->cv.wait(lock);
-    }
-
-    Napi::Value res = data->result.Value();
-    bool isErr = data->isError;
-    delete data;
-
-    if (isErr) {
-        Napi::Error::New(env, res.ToString()).ThrowAsJavaScriptException();
+    return awaitPromise(env, promiseVal.As<Napi::Promise>(), timeoutMs);
+}
+
+// awaitBlock(promise | fn, ...args)
+Napi::Value AwaitBlock(const Napi::CallbackInfo& info) {
+    return awaitArgs(info, 0, -1);
+}
+
+// awaitFor(timeoutMs, promise | fn, ...args)
+Napi::Value AwaitFor(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 2 || !info[0].IsNumber()) {
+        Napi::TypeError::New(env, "Expected (timeoutMs, promise | fn, ...args)").ThrowAsJavaScriptException();
         return env.Null();
     }
-
-    return res;
+    return awaitArgs(info, 1, info[0].As<Napi::Number>().DoubleValue());
 }
 
+// ---------- timer wheel ----------
+//
+// Hierarchical timing wheel: 4 levels of 256 slots at 1ms resolution, so a
+// timer lands in the level matching how far away it is and gets cascaded
+// down as its deadline approaches. Insert and cancel are O(1) (intrusive
+// lists), and everything that expires on a tick is handed to JS as one
+// batch. A single uv timer is armed for the next interesting tick and only
+// keeps the loop alive while timers are pending.
+
+static const int kLevels = 4;
+static const int kSlotBits = 8;
+static const uint64_t kSlots = 1u << kSlotBits;
+static const uint64_t kSlotMask = kSlots - 1;
+static const uint64_t kMaxDelay = (1ull << (kLevels * kSlotBits)) - 1;
+
+struct TimerNode {
+    uint32_t id;
+    uint64_t expires;
+    TimerNode* prev = nullptr;
+    TimerNode* next = nullptr;
+    int level = 0;
+    uint32_t slot = 0;
+};
+
+class TimerWheel : public Napi::ObjectWrap<TimerWheel> {
+public:
+    static Napi::Function Define(Napi::Env env) {
+        return DefineClass(env, "TimerWheel", {
+            InstanceMethod("add", &TimerWheel::Add),
+            InstanceMethod("cancel", &TimerWheel::Cancel),
+            InstanceMethod("flush", &TimerWheel::Flush),
+            InstanceMethod("size", &TimerWheel::Size),
+        });
+    }
+
+    // new TimerWheel(onExpire): onExpire(Uint32Array ids) gets each batch.
+    TimerWheel(const Napi::CallbackInfo& info) : Napi::ObjectWrap<TimerWheel>(info) {
+        Napi::Env env = info.Env();
+        if (info.Length() < 1 || !info[0].IsFunction()) {
+            Napi::TypeError::New(env, "Expected an expiry callback").ThrowAsJavaScriptException();
+            return;
+        }
+        onExpire = Napi::Persistent(info[0].As<Napi::Function>());
+        napi_get_uv_event_loop(env, &loop);
+        timer = new uv_timer_t;
+        uv_timer_init(loop, timer);
+        timer->data = this;
+        current = uv_now(loop);
+    }
+
+    ~TimerWheel() {
+        for (auto& kv : nodes) delete kv.second;
+        if (timer) {
+            uv_timer_stop(timer);
+            timer->data = nullptr;
+            uv_close(reinterpret_cast<uv_handle_t*>(timer), [](uv_handle_t* h) { delete reinterpret_cast<uv_timer_t*>(h); });
+        }
+    }
+
+private:
+    Napi::FunctionReference onExpire;
+    uv_loop_t* loop = nullptr;
+    uv_timer_t* timer = nullptr;
+    TimerNode* slots[kLevels][kSlots] = {};
+    size_t levelCount[kLevels] = {};
+    std::unordered_map<uint32_t, TimerNode*> nodes;
+    uint64_t current = 0;           // last tick (ms, uv_now clock) processed
+    uint32_t nextId = 1;
+    std::vector<uint32_t> expired;
+
+    void link(TimerNode* n) {
+        uint64_t delta = n->expires > current ? n->expires - current : 0;
+        int level = 0;
+        while (level < kLevels - 1 && delta >= (1ull << ((level + 1) * kSlotBits))) level++;
+        // Level 0 holds the exact tick; above that, the tick's digit at this level.
+        uint64_t when = n->expires > current ? n->expires : current + 1;
+        n->level = level;
+        n->slot = (uint32_t)((when >> (level * kSlotBits)) & kSlotMask);
+        n->prev = nullptr;
+        n->next = slots[level][n->slot];
+        if (n->next) n->next->prev = n;
+        slots[level][n->slot] = n;
+        levelCount[level]++;
+    }
+
+    void unlink(TimerNode* n) {
+        if (n->prev) n->prev->next = n->next;
+        else slots[n->level][n->slot] = n->next;
+        if (n->next) n->next->prev = n->prev;
+        levelCount[n->level]--;
+    }
+
+    void cascade(int level) {
+        uint32_t slot = (uint32_t)((current >> (level * kSlotBits)) & kSlotMask);
+        TimerNode* n = slots[level][slot];
+        slots[level][slot] = nullptr;
+        while (n) {
+            TimerNode* next = n->next;
+            levelCount[level]--;
+            link(n);
+            n = next;
+        }
+    }
+
+    void expireSlot() {
+        uint32_t slot = (uint32_t)(current & kSlotMask);
+        TimerNode* n = slots[0][slot];
+        slots[0][slot] = nullptr;
+        while (n) {
+            TimerNode* next = n->next;
+            levelCount[0]--;
+            if (n->expires <= current) {
+                expired.push_back(n->id);
+                nodes.erase(n->id);
+                delete n;
+            } else {
+                link(n);   // a lap early
+            }
+            n = next;
+        }
+    }
+
+    // Moves the wheel up to `now`, collecting expired ids. Empty stretches
+    // are skipped a whole slot-width at a time.
+    void advance(uint64_t now) {
+        while (current < now) {
+            if (nodes.empty()) { current = now; break; }
+            int lowest = 0;
+            while (lowest < kLevels && levelCount[lowest] == 0) lowest++;
+            uint64_t next = current + 1;
+            if (lowest > 0) {
+                uint64_t width = 1ull << (lowest * kSlotBits);
+                next = (current / width + 1) * width;
+                if (next > now) { current = now; break; }
+            }
+            current = next;
+            for (int level = kLevels - 1; level > 0; level--) {
+                if ((current & ((1ull << (level * kSlotBits)) - 1)) == 0) cascade(level);
+            }
+            expireSlot();
+        }
+    }
+
+    // Earliest tick worth waking up for: an exact level-0 deadline or the
+    // next cascade point of the lowest non-empty upper level.
+    uint64_t nextWake() const {
+        uint64_t wake = current + kSlots;
+        for (int level = 1; level < kLevels; level++) {
+            if (levelCount[level]) {
+                uint64_t width = 1ull << (level * kSlotBits);
+                wake = (current / width + 1) * width;
+                break;
+            }
+        }
+        if (levelCount[0]) {
+            for (uint64_t t = current + 1; t < wake; t++) {
+                for (TimerNode* n = slots[0][t & kSlotMask]; n; n = n->next)
+                    if (n->expires <= t) return t;
+            }
+        }
+        return wake;
+    }
+
+    void arm() {
+        if (nodes.empty()) { uv_timer_stop(timer); return; }
+        uint64_t wake = nextWake();
+        uv_update_time(loop);
+        uint64_t now = uv_now(loop);
+        uv_timer_start(timer, OnTimer, wake > now ? wake - now : 0, 0);
+    }
+
+    static void OnTimer(uv_timer_t* handle) {
+        TimerWheel* self = static_cast<TimerWheel*>(handle->data);
+        if (!self) return;
+        Napi::Env env = self->Env();
+        Napi::HandleScope scope(env);
+        self->advance(uv_now(self->loop));
+        self->deliver(env);
+        self->arm();
+    }
+
+    void deliver(Napi::Env env) {
+        if (expired.empty()) return;
+        Napi::Uint32Array ids = Napi::Uint32Array::New(env, expired.size());
+        std::copy(expired.begin(), expired.end(), ids.Data());
+        expired.clear();
+        // MakeCallback so nextTicks / microtasks queued by the callbacks run.
+        onExpire.MakeCallback(Value(), { ids });
+    }
+
+    // add(delayMs) -> id
+    Napi::Value Add(const Napi::CallbackInfo& info) {
+        Napi::Env env = info.Env();
+        double delay = info.Length() > 0 && info[0].IsNumber() ? info[0].As<Napi::Number>().DoubleValue() : 0;
+        if (!(delay >= 0)) delay = 0;
+        uv_update_time(loop);                    // uv_now is cached per loop turn
+        uint64_t now = uv_now(loop);
+        if (nodes.empty()) current = now;        // nothing to catch up on
+        auto* n = new TimerNode();
+        n->id = nextId++;
+        if (nextId == 0) nextId = 1;
+        n->expires = now + (uint64_t)(delay > (double)kMaxDelay ? kMaxDelay : delay);
+        if (n->expires <= current) n->expires = current + 1;
+        nodes[n->id] = n;
+        link(n);
+        arm();
+        return Napi::Number::New(env, n->id);
+    }
+
+    // cancel(id) -> whether it was still pending
+    Napi::Value Cancel(const Napi::CallbackInfo& info) {
+        Napi::Env env = info.Env();
+        uint32_t id = info.Length() > 0 && info[0].IsNumber() ? info[0].As<Napi::Number>().Uint32Value() : 0;
+        auto it = nodes.find(id);
+        if (it == nodes.end()) return Napi::Boolean::New(env, false);
+        unlink(it->second);
+        delete it->second;
+        nodes.erase(it);
+        arm();
+        return Napi::Boolean::New(env, true);
+    }
+
+    // flush(): expires every pending timer now, as one batch.
+    Napi::Value Flush(const Napi::CallbackInfo& info) {
+        Napi::Env env = info.Env();
+        for (auto& kv : nodes) {
+            expired.push_back(kv.first);
+            delete kv.second;
+        }
+        nodes.clear();
+        for (int level = 0; level < kLevels; level++) {
+            std::fill(std::begin(slots[level]), std::end(slots[level]), nullptr);
+            levelCount[level] = 0;
+        }
+        std::sort(expired.begin(), expired.end());
+        uv_timer_stop(timer);
+        deliver(env);
+        return env.Undefined();
+    }
+
+    Napi::Value Size(const Napi::CallbackInfo& info) {
+        return Napi::Number::New(info.Env(), (double)nodes.size());
+    }
+};
+
 Napi::Object Init(Napi::Env env, Napi::Object exports) {
     exports.Set("awaitBlock", Napi::Function::New(env, AwaitBlock));
+    exports.Set("awaitFor", Napi::Function::New(env, AwaitFor));
+    exports.Set("TimerWheel", TimerWheel::Define(env));
     return exports;
 }
 
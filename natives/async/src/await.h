@@ -0,0 +1,139 @@
+#pragma once
+#include <napi.h>
+#include <uv.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#ifndef _WIN32
+#include <poll.h>
+#endif
+
+// The promise can only settle on this thread, so instead of parking on a
+// condition variable we keep running the event loop (and the nextTick /
+// microtask queues) from inside the call until it does. Waiting for I/O
+// sleeps in the loop's backend, so an idle wait costs no CPU.
+//
+// That can't work inside a microtask (a promise reaction, or an async
+// function after its first await): V8 doesn't run microtasks re-entrantly,
+// so the awaited promise may settle but its reaction never runs here. Such
+// calls throw "cannot block inside a microtask" up front, and nesting is
+// only supported from ordinary callbacks (timers, I/O, the main script).
+//
+// Shared with the utils addon's awaitSync; `name` prefixes the errors.
+
+struct AwaitData {
+    bool done = false;
+    bool isError = false;
+    Napi::ObjectReference holder;   // { value }: references to primitives are not allowed
+};
+
+static int awaitDepth = 0;   // per addon that includes this
+static const int kMaxAwaitDepth = 64;
+
+// Runs process._tickCallback(): drains nextTicks and the microtask queue.
+static inline bool drainTicks(Napi::Env env) {
+    Napi::Object process = env.Global().Get("process").As<Napi::Object>();
+    Napi::Value tick = process.Get("_tickCallback");
+    if (!tick.IsFunction()) return true;
+    tick.As<Napi::Function>().Call(process, {});
+    return !env.IsExceptionPending();
+}
+
+// One bounded loop iteration: sleep until the loop has work or timeoutMs passes.
+static inline void pumpOnce(uv_loop_t* loop, int timeoutMs) {
+#ifdef _WIN32
+    (void)timeoutMs;
+    uv_run(loop, UV_RUN_ONCE);
+#else
+    int backend = uv_backend_timeout(loop);
+    int wait = backend;
+    if (timeoutMs >= 0 && (backend < 0 || timeoutMs < backend)) wait = timeoutMs;
+    if (wait != 0) {
+        struct pollfd pfd = { uv_backend_fd(loop), POLLIN, 0 };
+        poll(&pfd, 1, wait);
+    }
+    uv_run(loop, UV_RUN_NOWAIT);
+#endif
+}
+
+// Whether microtasks run when the queues are drained from here: false inside
+// a microtask checkpoint. Exceptions from the drain are left pending.
+static inline bool microtasksRun(Napi::Env env) {
+    auto ran = std::make_shared<bool>(false);
+    Napi::Function queue = env.Global().Get("queueMicrotask").As<Napi::Function>();
+    queue.Call({ Napi::Function::New(env, [ran](const Napi::CallbackInfo& cbInfo) {
+        *ran = true;
+        return cbInfo.Env().Undefined();
+    }) });
+    if (env.IsExceptionPending() || !drainTicks(env)) return false;
+    return *ran;
+}
+
+static inline Napi::Value awaitPromise(Napi::Env env, Napi::Promise promise, double timeoutMs, const char* name = "awaitBlock") {
+    if (awaitDepth >= kMaxAwaitDepth) {
+        Napi::Error::New(env, std::string(name) + " nested too deeply").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    uv_loop_t* loop = nullptr;
+    if (napi_get_uv_event_loop(env, &loop) != napi_ok || !loop) {
+        Napi::Error::New(env, std::string(name) + ": no event loop available").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    if (!microtasksRun(env)) {
+        if (!env.IsExceptionPending())
+            Napi::Error::New(env, std::string(name) + " cannot block inside a microtask (a promise reaction or an async function after await)").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    // Shared with the reactions: they may still fire after a timeout returns.
+    auto data = std::make_shared<AwaitData>();
+    data->holder = Napi::Persistent(Napi::Object::New(env));
+    promise.Then(
+        Napi::Function::New(env, [data](const Napi::CallbackInfo& cbInfo) {
+            data->holder.Value().Set("value", cbInfo[0]);
+            data->done = true;
+            return cbInfo.Env().Undefined();
+        }),
+        Napi::Function::New(env, [data](const Napi::CallbackInfo& cbInfo) {
+            data->holder.Value().Set("value", cbInfo[0]);
+            data->isError = true;
+            data->done = true;
+            return cbInfo.Env().Undefined();
+        })
+    );
+
+    auto start = std::chrono::steady_clock::now();
+    awaitDepth++;
+    while (!data->done) {
+        if (!drainTicks(env)) { awaitDepth--; return env.Null(); }
+        if (data->done) break;
+
+        int remaining = -1;
+        if (timeoutMs >= 0) {
+            double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            if (elapsed >= timeoutMs) {
+                awaitDepth--;
+                Napi::Error::New(env, std::string(name) + " timed out").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+            remaining = (int)(timeoutMs - elapsed) + 1;
+        }
+        if (!uv_loop_alive(loop)) {
+            awaitDepth--;
+            Napi::Error::New(env, std::string(name) + ": promise can never settle, the event loop is idle").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        pumpOnce(loop, remaining);
+        if (env.IsExceptionPending()) { awaitDepth--; return env.Null(); }
+    }
+    awaitDepth--;
+
+    Napi::Value res = data->holder.Value().Get("value");
+    if (data->isError) {
+        napi_throw(env, res);
+        return env.Null();
+    }
+    return res;
+}
@@ -0,0 +1,46 @@
+// Times runBF (interpreter, and the JIT where there is one) on BF programs
+// and checks the output against a baseline build of the addon (e.g. the
+// plain character interpreter before the IR).
+// usage: node bench.js [prog.b ...] [--baseline path/to/old.node] > /dev/null
+// (the report goes to stderr; the old addon always echoes to stdout).
+// Without files it runs the small built-in programs below; pass real
+// workloads such as mandelbrot.b / hanoi.b for meaningful numbers.
+const fs = require('fs');
+const path = require('path');
+const bf = require('./index.js');
+
+const args = process.argv.slice(2);
+const at = args.indexOf('--baseline');
+const baseline = at >= 0 ? require(path.resolve(args.splice(at, 2)[1])) : null;
+
+const builtin = {
+  // Daniel Cristofani's Sierpinski triangle and squares
+  'sierpinski': '++++++++[>+>++++<<-]>++>>+<[-[>>+<<-]+>>]>+[-<<<[->[+[-]+>++>>>-<<]<[<]>>++++++[<<+++++>>-]+<<++.[-]<<]>.>+[>>]>+]',
+  'squares': '++++[>+++++<-]>[<+++++>-]+<+[>[>+>+<<-]++>>[<<+>>-]>>>[-]++>[-]+>>>+[[-]++++++>>>]<<<[[<++++++++<++>>-]+<.<[>----<-]<]<<[>>>>>[>>>[-]+++++++++<[>-<-]+++++++++>[-[<->-]+[<<<]]<[>+<-]>]<<-]<<-]',
+  // seven nested counting loops
+  'nested': '>++[<+++++++++++++>-]<[[>+>+<<-]>[<+>-]++++++++[>++++++++<-]>.[-]<<>++++++++++[>++++++++++[>++++++++++[>++++++++++[>++++++++++[>++++++++++[>++++++++++[-]<-]<-]<-]<-]<-]<-]<-]++++++++++.',
+};
+const programs = args.length
+  ? args.map((f) => [path.basename(f), fs.readFileSync(f, 'utf8')])
+  : Object.entries(builtin);
+
+function time(run) {
+  const t0 = process.hrtime.bigint();
+  const out = run();
+  return [out, Number(process.hrtime.bigint() - t0) / 1e6];
+}
+
+for (const [name, src] of programs) {
+  const [out, ms] = time(() => bf.runBF(src, '', { print: false }));
+  let line = `${name.padEnd(14)} ${ms.toFixed(1).padStart(9)} ms  ${out.length} bytes out`;
+  if (bf.jit) {
+    bf.runBF(src, '', { print: false, jit: true });  // compile outside the timing
+    const [jitOut, jitMs] = time(() => bf.runBF(src, '', { print: false, jit: true }));
+    line += `   jit ${jitMs.toFixed(1)} ms${jitOut === out ? '' : ' (OUTPUT DIFFERS)'}`;
+  }
+  if (baseline) {
+    const [old, oldMs] = time(() => baseline.runBF(src));
+    line += `   baseline ${oldMs.toFixed(1)} ms (x${(oldMs / ms).toFixed(1)})  ${old === out ? 'same output' : 'OUTPUT DIFFERS'}`;
+  }
+  console.error(line);
+}
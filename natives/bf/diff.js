@@ -0,0 +1,81 @@
+// Differential check of the two runBF engines: every program runs through
+// the IR interpreter and the JIT, and output bytes (or the error) must match.
+// usage: node diff.js [prog.b ...] [--random N] [--seed S]
+// Random programs only use counted loops whose bodies never touch their
+// counter, so they always terminate; top-level scans, input and small tapes
+// exercise growth and the error paths.
+const fs = require('fs');
+const path = require('path');
+const bf = require('./index.js');
+
+const args = process.argv.slice(2);
+const flag = (name, def) => {
+  const at = args.indexOf(name);
+  return at >= 0 ? Number(args.splice(at, 2)[1]) : def;
+};
+const count = flag('--random', 2000);
+let seed = flag('--seed', Date.now() % 100000) || 1;
+
+if (!bf.jit) console.error('note: no JIT on this platform, both runs use the interpreter');
+
+// xorshift32; the low bits of a plain LCG cycle too quickly for % n
+const rnd = (n) => {
+  seed ^= seed << 13; seed ^= seed >>> 17; seed ^= seed << 5;
+  return (seed >>> 0) % n;
+};
+
+function gen(depth) {
+  let s = '', p = 0;
+  const len = 3 + rnd(12);
+  for (let i = 0; i < len; i++) {
+    const r = rnd(12);
+    if (r < 3) s += '+'.repeat(1 + rnd(5));
+    else if (r < 5) s += '-'.repeat(1 + rnd(3));
+    else if (r < 6) { const k = 1 + rnd(40); s += '>'.repeat(k); p += k; }
+    else if (r < 7 && p > 0) { const k = 1 + rnd(p); s += '<'.repeat(k); p -= k; }
+    else if (r < 8) s += '.';
+    else if (r < 9) s += ',';
+    else if (r < 10 && depth < 2) {
+      // the body starts one cell right and comes back before the decrement
+      s += '[>' + gen(depth + 1) + '<' + (rnd(8) ? '-' : '+') + ']';
+    } else if (r < 11) s += ['[-]', '[->+<]', '[->++>+++<<]', '[-<+>]'][rnd(depth ? 3 : 4)];
+    else if (depth === 0) s += ['[>]', '[<]', '[>>]', '>[-]<[<]>'][rnd(4)];
+  }
+  return s + '<'.repeat(p);
+}
+
+function run(src, input, opts) {
+  try {
+    return { out: bf.runBF(src, input, { print: false, buffer: true, ...opts }) };
+  } catch (e) {
+    return { error: e.message };
+  }
+}
+
+function check(name, src, input = '', opts = {}) {
+  const a = run(src, input, { ...opts, jit: false });
+  const b = run(src, input, { ...opts, jit: true });
+  const same = a.error !== undefined ? a.error === b.error : b.out !== undefined && a.out.equals(b.out);
+  if (!same) {
+    console.log(`MISMATCH ${name}`);
+    console.log(`  program: ${src.length > 300 ? src.slice(0, 300) + '...' : src}`);
+    console.log(`  interpreter: ${a.error ?? a.out.toString('hex').slice(0, 120)}`);
+    console.log(`  jit:         ${b.error ?? b.out.toString('hex').slice(0, 120)}`);
+  }
+  return same;
+}
+
+let failed = 0, total = 0;
+for (const f of args) {
+  total++;
+  if (!check(path.basename(f), fs.readFileSync(f, 'utf8'))) failed++;
+}
+const startSeed = seed;
+for (let i = 0; i < count; i++) {
+  const src = gen(0);
+  const input = Buffer.from(Array.from({ length: rnd(6) }, () => rnd(256)));
+  total++;
+  if (!check(`random #${i} (seed ${startSeed})`, src, input, rnd(4) ? {} : { tapeSize: 1 + rnd(64) })) failed++;
+}
+console.log(`${total - failed}/${total} programs identical`);
+process.exitCode = failed ? 1 : 0;
@@ -1,62 +1,515 @@
 #include <napi.h>
-#include <iostream>
-#include <vector>
-#include <stack>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <unordered_map>
+#include <vector>
+#if defined(__x86_64__) && (defined(__linux__) || defined(__APPLE__))
+#include <sys/mman.h>
+#include <unistd.h>
+#define NOVA_BF_JIT 1
+#endif
+
+// Brainfuck interpreter that prints AND returns output.
+//
+// The source is compiled once into a small IR before it runs:
+//   - runs of + - > < are folded, and pointer moves are sunk into the
+//     offsets of the ops that follow, so ">+>+<<" is two ADDs and no MOVE;
+//   - brackets carry their partner's index, so a skipped loop is one jump;
+//   - loops whose body only adds at fixed offsets and steps the current cell
+//     by -1/+1 ("[-]", "[->+<]", "[->++>+++<<]") become MUL ops plus a CLEAR;
+//   - "[>]" / "[<]" become a SCAN (memchr / memrchr for a step of one).
+// The tape grows to the right on demand and moving left of cell 0 is an
+// error. Output is buffered and written to stdout in large chunks.
+//
+// On x86-64 the same IR can also be turned into machine code ({ jit: true }).
+// Compiled programs (IR and machine code) are cached by source.
+
+enum Op : uint8_t { ADD, MOVE, OUT, IN, OPEN, CLOSE, CLEAR, MUL, SCAN };
+
+struct Ins {
+    Op op;
+    int32_t a;      // ADD: delta, MOVE/SCAN: step, MUL: factor, OPEN/CLOSE: jump target
+    int32_t off;    // cell offset from the pointer
+    int32_t src;    // MUL: offset of the loop counter cell
+};
+
+struct Program {
+    std::vector<Ins> code;
+    int32_t reach = 0;  // largest |offset| used; the tape keeps that much slack on both sides
+};
 
-// Brainfuck interpreter that prints AND returns output
-std::string runBF(const std::string& code, const std::string& input = "") {
-    std::vector<unsigned char> tape(30000, 0);
-    size_t ptr = 0;
-    size_t inputPtr = 0;
-    std::stack<size_t> loopStack;
-    std::string output;
-
-    for (size_t i = 0; i < code.size(); i++) {
-        char cmd = code[i];
-        switch (cmd) {
-            case '>': ptr++; break;
-            case '<': ptr--; break;
-            case '+': tape[ptr]++; break;
-            case '-': tape[ptr]--; break;
-            case '.': {
-                char c = static_cast<char>(tape[ptr]);
-                std::cout << c;              // print live
-                output.push_back(c);         // collect for return
+static Program compileBF(const std::string& src) {
+    Program prog;
+    std::vector<Ins>& code = prog.code;
+    struct Open {
+        size_t at;
+        int32_t moved;  // offset flushed into a MOVE right before the OPEN
+    };
+    std::vector<Open> open;
+    int32_t off = 0;
+
+    auto emit = [&](Op op, int32_t a, int32_t at, int32_t src = 0) {
+        prog.reach = std::max({ prog.reach, at, -at, src, -src });
+        code.push_back({ op, a, at, src });
+    };
+    auto flushMove = [&] {
+        if (off) code.push_back({ MOVE, off, 0, 0 });
+        off = 0;
+    };
+
+    for (size_t i = 0; i < src.size(); i++) {
+        switch (src[i]) {
+        case '>': off++; break;
+        case '<': off--; break;
+        case '+':
+        case '-': {
+            int32_t d = src[i] == '+' ? 1 : -1;
+            if (!code.empty() && code.back().op == ADD && code.back().off == off) {
+                code.back().a += d;
+                if ((code.back().a & 0xff) == 0) code.pop_back();
+            } else {
+                emit(ADD, d, off);
+            }
+            break;
+        }
+        case '.': emit(OUT, 0, off); break;
+        case ',': emit(IN, 0, off); break;
+        case '[':
+            open.push_back({ code.size() + (off ? 1 : 0), off });
+            flushMove();
+            code.push_back({ OPEN, 0, 0, 0 });
+            break;
+        case ']': {
+            if (open.empty()) throw std::runtime_error("unmatched ']' at " + std::to_string(i));
+            size_t start = open.back().at;
+            int32_t moved = open.back().moved;
+            open.pop_back();
+            int32_t net = off;
+            flushMove();
+
+            // Body is [start + 1, end): look for the idioms before emitting CLOSE.
+            size_t first = start + 1, end = code.size();
+            bool onlyAdds = end > first;
+            int32_t step = 0;
+            for (size_t k = first; k < end && onlyAdds; k++) {
+                onlyAdds = code[k].op == ADD;
+                if (code[k].off == 0) step += code[k].a;
+            }
+            if (onlyAdds && net == 0 && ((step & 0xff) == 0xff || (step & 0xff) == 1)) {
+                // The loop runs cell (or 256 - cell) times: each target gains factor * that.
+                // With no jump left, the move in front of it goes back to being an offset.
+                int32_t sign = (step & 0xff) == 0xff ? 1 : -1;
+                std::vector<Ins> body(code.begin() + first, code.end());
+                code.resize(moved ? start - 1 : start);
+                for (const Ins& b : body)
+                    if (b.off != 0) emit(MUL, b.a * sign, moved + b.off, moved);
+                emit(CLEAR, 0, moved);
+                off = moved;
                 break;
             }
-            case ',':
-                if (inputPtr < input.size()) {
-                    tape[ptr] = input[inputPtr++];
-                } else {
-                    tape[ptr] = 0;
-                }
+            if (end == first + 1 && code[first].op == MOVE) {
+                int32_t s = code[first].a;
+                code.resize(start);
+                code.push_back({ SCAN, s, 0, 0 });
                 break;
-case '[':
-    if (tape[ptr] == 0) {
-        int loop = 1;
-        while (loop > 0 && ++i < code.size()) {
-            if (code[i] == '[') loop++;
-            else if (code[i] == ']') loop--;
+            }
+            code[start].a = static_cast<int32_t>(code.size() + 1);
+            code.push_back({ CLOSE, static_cast<int32_t>(start + 1), 0, 0 });
+            break;
+        }
+        default: break;  // everything else is a comment
+        }
+    }
+    if (!open.empty()) throw std::runtime_error("unmatched '[' (" + std::to_string(open.size()) + " open)");
+    flushMove();
+    return prog;
+}
+
+struct RunOptions {
+    bool print = true;
+    size_t tapeSize = 30000;
+    bool jit = false;
+};
+
+// Collects output and hands it to stdout in big writes instead of one
+// stream insertion per byte.
+class Sink {
+public:
+    explicit Sink(bool print) : print(print) {}
+    ~Sink() { flush(); }
+
+    void put(char c) {
+        out.push_back(c);
+        if (print && out.size() - flushed >= kFlushAt) flush();
+    }
+    void flush() {
+        if (!print || flushed == out.size()) return;
+        fwrite(out.data() + flushed, 1, out.size() - flushed, stdout);
+        fflush(stdout);
+        flushed = out.size();
+    }
+    std::string& str() { return out; }
+
+private:
+    static const size_t kFlushAt = 64 * 1024;
+    bool print;
+    std::string out;
+    size_t flushed = 0;
+};
+
+class Tape {
+public:
+    Tape(size_t size, int32_t reach) : slack(static_cast<size_t>(reach) + 16), cells(size + 2 * slack, 0) {}
+
+    uint8_t* base() { return cells.data() + slack; }
+    size_t size() const { return cells.size() - 2 * slack; }
+
+    // Called with the pointer after a move; keeps [-slack, size + slack) mapped.
+    uint8_t* ensure(ptrdiff_t pos) {
+        if (pos < 0) throw std::runtime_error("tape pointer moved left of cell 0");
+        size_t need = static_cast<size_t>(pos) + 1;
+        if (need > size()) {
+            size_t grown = size() * 2;
+            while (grown < need) grown *= 2;
+            cells.resize(grown + 2 * slack, 0);
+        }
+        return base();
+    }
+
+private:
+    size_t slack;
+    std::vector<uint8_t> cells;
+};
+
+static std::string runIR(const Program& prog, const std::string& input, const RunOptions& opts) {
+    Tape tape(opts.tapeSize ? opts.tapeSize : 1, prog.reach);
+    Sink sink(opts.print);
+    uint8_t* t = tape.base();
+    size_t size = tape.size();  // kept in a local so the hot path has no calls
+    ptrdiff_t p = 0;
+    size_t in = 0;
+    const Ins* const code = prog.code.data();
+    const Ins* const end = code + prog.code.size();
+
+    for (const Ins* ip = code; ip < end; ip++) {
+        const Ins& ins = *ip;
+        switch (ins.op) {
+        case ADD: t[p + ins.off] += static_cast<uint8_t>(ins.a); break;
+        case MOVE:
+            p += ins.a;
+            if (static_cast<size_t>(p) >= size) { t = tape.ensure(p); size = tape.size(); }
+            break;
+        case OUT: sink.put(static_cast<char>(t[p + ins.off])); break;
+        case IN:
+            t[p + ins.off] = in < input.size() ? static_cast<uint8_t>(input[in++]) : 0;
+            break;
+        case OPEN: if (!t[p]) ip = code + ins.a - 1; break;
+        case CLOSE: if (t[p]) ip = code + ins.a - 1; break;
+        case CLEAR: t[p + ins.off] = 0; break;
+        case MUL: t[p + ins.off] += static_cast<uint8_t>(t[p + ins.src] * ins.a); break;
+        case SCAN:
+            if (ins.a == 1) {
+                for (;;) {
+                    const void* z = memchr(t + p, 0, size - p);
+                    if (z) { p = static_cast<const uint8_t*>(z) - t; break; }
+                    p = size;
+                    t = tape.ensure(p);
+                    size = tape.size();
+                }
+            } else if (ins.a == -1) {
+#if defined(__GLIBC__) || defined(__ANDROID__)
+                const void* z = memrchr(t, 0, p + 1);
+                if (!z) t = tape.ensure(-1);
+                p = static_cast<const uint8_t*>(z) - t;
+#else
+                while (p >= 0 && t[p]) p--;
+                if (p < 0) t = tape.ensure(p);
+#endif
+            } else {
+                while (t[p]) {
+                    p += ins.a;
+                    if (static_cast<size_t>(p) >= size) { t = tape.ensure(p); size = tape.size(); }
+                }
+            }
+            break;
+        }
+    }
+    sink.flush();
+    return std::move(sink.str());
+}
+
+#ifdef NOVA_BF_JIT
+// ---------- x86-64 JIT ----------
+// One straight-line function per program. Registers: rbx = current cell,
+// r12 = JitCtx*, r14 = tape base. Cell ops use [rbx + offset] directly (the
+// tape slack covers every offset); a MOVE is an add to rbx plus an unsigned
+// range check against the tape, and the rare out-of-range case calls a
+// shared stub that grows the tape or bails out with an error. Output, input
+// and scans call back into C++. Code is written into RW pages which are then
+// flipped to RX, never both at once.
+
+struct JitCtx {
+    uint8_t* base;          // [r12 + 0], reloaded after the tape grows
+    size_t size;            // [r12 + 8]
+    Tape* tape;
+    Sink* sink;
+    const std::string* input;
+    size_t in;
+    const char* error;
+};
+static_assert(offsetof(JitCtx, base) == 0 && offsetof(JitCtx, size) == 8, "JIT code hardcodes these offsets");
+
+static uint8_t* jitGrow(JitCtx* c, uint8_t* cell) {
+    ptrdiff_t p = cell - c->base;
+    try {
+        c->base = c->tape->ensure(p);
+    } catch (const std::exception&) {
+        c->error = "tape pointer moved left of cell 0";
+        return nullptr;
+    }
+    c->size = c->tape->size();
+    return c->base + p;
+}
+
+static int jitPut(JitCtx* c, int ch) {
+    try {
+        c->sink->put(static_cast<char>(ch));
+        return 1;
+    } catch (const std::exception&) {
+        c->error = "out of memory";
+        return 0;
+    }
+}
+
+static int jitGet(JitCtx* c) {
+    return c->in < c->input->size() ? static_cast<uint8_t>((*c->input)[c->in++]) : 0;
+}
+
+// Same semantics as the interpreter's SCAN, including growth and underflow.
+static uint8_t* jitScan(JitCtx* c, uint8_t* cell, int64_t step) {
+    ptrdiff_t p = cell - c->base;
+    while (c->base[p]) {
+        if (step == 1) {
+            const void* z = memchr(c->base + p, 0, c->size - p);
+            if (z) return static_cast<uint8_t*>(const_cast<void*>(z));
+            p = c->size;
+        } else {
+            p += step;
+        }
+        if (p < 0 || static_cast<size_t>(p) >= c->size) {
+            if (!jitGrow(c, c->base + p)) return nullptr;
+        }
+    }
+    return c->base + p;
+}
+
+class JitCode {
+public:
+    using Entry = int (*)(JitCtx*, uint8_t*);
+
+    explicit JitCode(const Program& prog) {
+        emitProgram(prog);
+        size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        size = (buf.size() + page - 1) / page * page;
+        void* mem = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mem == MAP_FAILED) throw std::runtime_error("jit: mmap failed");
+        memcpy(mem, buf.data(), buf.size());
+        if (mprotect(mem, size, PROT_READ | PROT_EXEC) != 0) {
+            munmap(mem, size);
+            throw std::runtime_error("jit: mprotect failed");
         }
-    } else {
-        loopStack.push(i); // only push if not skipping
+        code = mem;
+        buf = std::vector<uint8_t>();
     }
-    break;
+    ~JitCode() { if (code) munmap(code, size); }
+    JitCode(const JitCode&) = delete;
+    JitCode& operator=(const JitCode&) = delete;
 
-case ']':
-    if (tape[ptr] != 0) {
-        i = loopStack.top(); // jump back
-    } else {
-        loopStack.pop(); // done with this loop
+    Entry entry() const { return reinterpret_cast<Entry>(code); }
+
+private:
+    std::vector<uint8_t> buf;
+    void* code = nullptr;
+    size_t size = 0;
+    std::vector<size_t> toStub, toFail;  // rel32 fields to patch
+
+    void b(std::initializer_list<uint8_t> bytes) { buf.insert(buf.end(), bytes); }
+    void i32(int32_t v) { for (int k = 0; k < 4; k++) buf.push_back(static_cast<uint8_t>(v >> (8 * k))); }
+    void i64(uint64_t v) { for (int k = 0; k < 8; k++) buf.push_back(static_cast<uint8_t>(v >> (8 * k))); }
+    size_t here() const { return buf.size(); }
+    void patch(size_t at, size_t target) {
+        int32_t rel = static_cast<int32_t>(static_cast<ptrdiff_t>(target) - static_cast<ptrdiff_t>(at + 4));
+        memcpy(&buf[at], &rel, 4);
     }
-    break;
+
+    // [rbx + off] as a ModRM with the given reg field
+    void cell(uint8_t reg, int32_t off) {
+        if (off >= -128 && off <= 127) { b({ static_cast<uint8_t>(0x43 | reg << 3), static_cast<uint8_t>(off) }); }
+        else { b({ static_cast<uint8_t>(0x83 | reg << 3) }); i32(off); }
+    }
+    void callHelper(const void* fn) {
+        b({ 0x48, 0xB8 }); i64(reinterpret_cast<uint64_t>(fn));   // mov rax, fn
+        b({ 0xFF, 0xD0 });                                         // call rax
+    }
+    void jmp(size_t target) { b({ 0xE9 }); i32(0); patch(here() - 4, target); }
+    void jzFail() { b({ 0x0F, 0x84 }); toFail.push_back(here()); i32(0); }
+    void checkRange() {
+        b({ 0x48, 0x89, 0xD8 });                 // mov rax, rbx
+        b({ 0x4C, 0x29, 0xF0 });                 // sub rax, r14
+        b({ 0x49, 0x3B, 0x44, 0x24, 0x08 });     // cmp rax, [r12 + 8]
+        b({ 0x72, 0x05 });                       // jb +5
+        b({ 0xE8 }); toStub.push_back(here()); i32(0);  // call stub
+    }
+
+    void emitProgram(const Program& prog) {
+        b({ 0x53, 0x41, 0x54, 0x41, 0x56 });     // push rbx; push r12; push r14
+        b({ 0x49, 0x89, 0xFC });                 // mov r12, rdi
+        b({ 0x48, 0x89, 0xF3 });                 // mov rbx, rsi
+        b({ 0x4D, 0x8B, 0x34, 0x24 });           // mov r14, [r12]
+
+        std::vector<size_t> open;
+        for (const Ins& ins : prog.code) {
+            switch (ins.op) {
+            case ADD:
+                b({ 0x80 }); cell(0, ins.off); b({ static_cast<uint8_t>(ins.a) });  // add byte [rbx+off], a
+                break;
+            case CLEAR:
+                b({ 0xC6 }); cell(0, ins.off); b({ 0 });                            // mov byte [rbx+off], 0
+                break;
+            case MUL: {
+                b({ 0x0F, 0xB6 }); cell(0, ins.src);                                 // movzx eax, byte [rbx+src]
+                int32_t f = static_cast<int8_t>(ins.a & 0xff);
+                if (f == -1) { b({ 0x28 }); cell(0, ins.off); break; }               // sub [rbx+off], al
+                if (f != 1) { b({ 0x69, 0xC0 }); i32(f); }                           // imul eax, eax, f
+                b({ 0x00 }); cell(0, ins.off);                                       // add [rbx+off], al
+                break;
+            }
+            case MOVE:
+                b({ 0x48, 0x81, 0xC3 }); i32(ins.a);                                 // add rbx, a
+                checkRange();
+                break;
+            case OUT:
+                b({ 0x4C, 0x89, 0xE7 });                                             // mov rdi, r12
+                b({ 0x0F, 0xB6 }); cell(6, ins.off);                                 // movzx esi, byte [rbx+off]
+                callHelper(reinterpret_cast<const void*>(&jitPut));
+                b({ 0x85, 0xC0 });                                                   // test eax, eax
+                jzFail();
+                break;
+            case IN:
+                b({ 0x4C, 0x89, 0xE7 });                                             // mov rdi, r12
+                callHelper(reinterpret_cast<const void*>(&jitGet));
+                b({ 0x88 }); cell(0, ins.off);                                       // mov [rbx+off], al
+                break;
+            case SCAN:
+                b({ 0x4C, 0x89, 0xE7 });                                             // mov rdi, r12
+                b({ 0x48, 0x89, 0xDE });                                             // mov rsi, rbx
+                b({ 0x48, 0xC7, 0xC2 }); i32(ins.a);                                 // mov rdx, step
+                callHelper(reinterpret_cast<const void*>(&jitScan));
+                b({ 0x48, 0x85, 0xC0 });                                             // test rax, rax
+                jzFail();
+                b({ 0x48, 0x89, 0xC3 });                                             // mov rbx, rax
+                b({ 0x4D, 0x8B, 0x34, 0x24 });                                       // mov r14, [r12]
+                break;
+            case OPEN:
+                b({ 0x80, 0x3B, 0x00 });                                             // cmp byte [rbx], 0
+                b({ 0x0F, 0x84 }); open.push_back(here()); i32(0);                   // je past CLOSE
+                break;
+            case CLOSE: {
+                size_t je = open.back();
+                open.pop_back();
+                b({ 0x80, 0x3B, 0x00 });                                             // cmp byte [rbx], 0
+                b({ 0x0F, 0x85 }); size_t jne = here(); i32(0);                      // jne past OPEN
+                patch(jne, je + 4);
+                patch(je, here());
+                break;
+            }
+            }
         }
+
+        b({ 0x31, 0xC0 });                       // xor eax, eax
+        size_t epilogue = here();
+        b({ 0x41, 0x5E, 0x41, 0x5C, 0x5B, 0xC3 }); // pop r14; pop r12; pop rbx; ret
+
+        size_t fail = here();
+        b({ 0xB8 }); i32(1);                     // mov eax, 1
+        jmp(epilogue);
+
+        // Out-of-range MOVE: called with one return address on the stack.
+        size_t stub = here();
+        b({ 0x48, 0x83, 0xEC, 0x08 });           // sub rsp, 8 (align for the call)
+        b({ 0x4C, 0x89, 0xE7 });                 // mov rdi, r12
+        b({ 0x48, 0x89, 0xDE });                 // mov rsi, rbx
+        callHelper(reinterpret_cast<const void*>(&jitGrow));
+        b({ 0x48, 0x83, 0xC4, 0x08 });           // add rsp, 8
+        b({ 0x48, 0x85, 0xC0 });                 // test rax, rax
+        b({ 0x74, 0x08 });                       // jz +8
+        b({ 0x48, 0x89, 0xC3 });                 // mov rbx, rax
+        b({ 0x4D, 0x8B, 0x34, 0x24 });           // mov r14, [r12]
+        b({ 0xC3 });                             // ret
+        b({ 0x48, 0x83, 0xC4, 0x08 });           // add rsp, 8 (drop the return address)
+        jmp(fail);
+
+        for (size_t at : toStub) patch(at, stub);
+        for (size_t at : toFail) patch(at, fail);
     }
-    std::cout.flush(); // make sure it appears immediately
-    return output;
+};
+
+static std::string runJIT(const JitCode& jit, const Program& prog, const std::string& input, const RunOptions& opts) {
+    Tape tape(opts.tapeSize ? opts.tapeSize : 1, prog.reach);
+    Sink sink(opts.print);
+    JitCtx ctx{ tape.base(), tape.size(), &tape, &sink, &input, 0, nullptr };
+    if (jit.entry()(&ctx, ctx.base) != 0) throw std::runtime_error(ctx.error ? ctx.error : "jit: failed");
+    sink.flush();
+    return std::move(sink.str());
 }
+#endif
+
+// Compiled programs keyed by source, oldest dropped first.
+struct Compiled {
+    Program prog;
+#ifdef NOVA_BF_JIT
+    std::unique_ptr<JitCode> jit;   // built on the first { jit: true } run
+#endif
+};
 
+static std::shared_ptr<Compiled> compiled(const std::string& code) {
+    static const size_t kMaxPrograms = 32;
+    static std::unordered_map<std::string, std::shared_ptr<Compiled>> cache;
+    static std::deque<std::string> order;
+    auto it = cache.find(code);
+    if (it != cache.end()) return it->second;
+    auto c = std::make_shared<Compiled>();
+    c->prog = compileBF(code);
+    if (cache.size() >= kMaxPrograms) {
+        cache.erase(order.front());
+        order.pop_front();
+    }
+    cache.emplace(code, c);
+    order.push_back(code);
+    return c;
+}
+
+std::string runBF(const std::string& code, const std::string& input = "", const RunOptions& opts = RunOptions()) {
+    std::shared_ptr<Compiled> c = compiled(code);
+#ifdef NOVA_BF_JIT
+    if (opts.jit) {
+        if (!c->jit) c->jit.reset(new JitCode(c->prog));
+        return runJIT(*c->jit, c->prog, input, opts);
+    }
+#endif
+    return runIR(c->prog, input, opts);
+}
+
+// runBF(code, input = "", { print = true, tapeSize = 30000, jit = false, buffer = false })
+// jit falls back to the interpreter where there is no JIT (see bf.jit);
+// buffer returns the raw output bytes instead of a UTF-8 decoded string.
 Napi::Value WrapperRunBF(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
 
@@ -66,13 +519,41 @@ Napi::Value WrapperRunBF(const Napi::CallbackInfo& info) {
     }
 
     std::string code = info[0].As<Napi::String>().Utf8Value();
-    std::string result = runBF(code);
+    std::string input;
+    if (info.Length() > 1 && info[1].IsString()) input = info[1].As<Napi::String>().Utf8Value();
+    else if (info.Length() > 1 && info[1].IsBuffer()) {
+        auto buf = info[1].As<Napi::Buffer<char>>();
+        input.assign(buf.Data(), buf.Length());
+    }
+    RunOptions opts;
+    bool asBuffer = false;
+    if (info.Length() > 2 && info[2].IsObject()) {
+        Napi::Object o = info[2].As<Napi::Object>();
+        if (o.Get("print").IsBoolean()) opts.print = o.Get("print").As<Napi::Boolean>();
+        if (o.Get("tapeSize").IsNumber()) opts.tapeSize = static_cast<size_t>(o.Get("tapeSize").As<Napi::Number>().Int64Value());
+        if (o.Get("jit").IsBoolean()) opts.jit = o.Get("jit").As<Napi::Boolean>();
+        if (o.Get("buffer").IsBoolean()) asBuffer = o.Get("buffer").As<Napi::Boolean>();
+    }
+
+    std::string result;
+    try {
+        result = runBF(code, input, opts);
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, std::string("bf: ") + e.what()).ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
 
+    if (asBuffer) return Napi::Buffer<char>::Copy(env, result.data(), result.size());
     return Napi::String::New(env, result);
 }
 
 Napi::Object Init(Napi::Env env, Napi::Object exports) {
     exports.Set("runBF", Napi::Function::New(env, WrapperRunBF));
+#ifdef NOVA_BF_JIT
+    exports.Set("jit", Napi::Boolean::New(env, true));
+#else
+    exports.Set("jit", Napi::Boolean::New(env, false));
+#endif
     return exports;
 }
 
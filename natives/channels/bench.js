@@ -0,0 +1,35 @@
+// Throughput of a channel between the main thread and one worker.
+// usage: node bench.js [records] [spsc|mpmc] [batch]
+const { Worker } = require('worker_threads');
+const ch = require('./index.js');
+
+const n = Number(process.argv[2]) || 5e6;
+const mode = process.argv[3] || 'spsc';
+const batch = Number(process.argv[4]) || 256;
+
+const c = ch.create({ mode, capacity: 4096, slotSize: 8 });
+const worker = new Worker(`
+const { workerData } = require('worker_threads');
+const c = require(workerData.dir).attach(workerData.buffer);
+const out = new Float64Array(${batch});
+let sent = 0;
+while (sent < ${n}) {
+  const k = Math.min(out.length, ${n} - sent);
+  for (let i = 0; i < k; i++) out[i] = sent + i;
+  sent += ${batch > 1} ? c.sendBatch(out.subarray(0, k)) : (c.send(out.subarray(0, 1)), 1);
+}
+c.close();
+`, { eval: true, workerData: { buffer: c.buffer, dir: __dirname } });
+
+const into = new Float64Array(batch);
+let got = 0, sum = 0;
+const t0 = process.hrtime.bigint();
+for (;;) {
+  const k = c.recvBatch(into);
+  if (!k) break;
+  for (let i = 0; i < k; i++) sum += into[i];
+  got += k;
+}
+const ms = Number(process.hrtime.bigint() - t0) / 1e6;
+console.log(`mode=${mode} batch=${batch} records=${got} ok=${sum === (n - 1) * n / 2} ${ms.toFixed(0)}ms ${(got / ms / 1000).toFixed(2)}M records/s`);
+worker.terminate();
@@ -0,0 +1,20 @@
+const addon = require('bindings')('channels');
+
+// create({ mode: 'spsc' | 'mpmc', capacity, slotSize }) -> Channel over a new
+// SharedArrayBuffer. Post `channel.buffer` to a worker and attach() it there.
+addon.create = (opts = {}) => {
+  const capacity = opts.capacity ?? 1024;
+  const slotSize = opts.slotSize ?? 64;
+  const buffer = new SharedArrayBuffer(addon.bytesFor(capacity, slotSize));
+  const ch = new addon.Channel(new Uint8Array(buffer), { ...opts, capacity, slotSize });
+  ch.buffer = buffer;
+  return ch;
+};
+
+addon.attach = (buffer) => {
+  const ch = new addon.Channel(new Uint8Array(buffer));
+  ch.buffer = buffer;
+  return ch;
+};
+
+module.exports = addon
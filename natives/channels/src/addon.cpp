@@ -0,0 +1,703 @@
+#include <napi.h>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Bounded ring buffers living in shared memory: a SharedArrayBuffer when the
+// peers are worker threads, a POSIX shm segment when they are separate
+// processes. Everything the two ends agree on is in the header, so either
+// side can attach to memory the other one created.
+//
+//   SPSC: one producer, one consumer; head/tail are plain counters.
+//   MPMC: Vyukov's bounded queue; every slot carries a sequence number that
+//         says whose turn it is, so producers and consumers only CAS on the
+//         shared index and never lock.
+//
+// Blocking is done with futexes on two signal words (data / space) that are
+// bumped after every publish. Waiters register first, so a sender only pays
+// for the wake syscall when somebody is actually asleep.
+
+static const uint32_t kMagic = 0x4e564348;   // "NVCH"
+static const uint32_t kVersion = 1;
+static const uint32_t kSpsc = 0, kMpmc = 1;
+static const size_t kLine = 64;
+static const int kSpins = 64;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "need lock-free 64-bit atomics");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "need lock-free 32-bit atomics");
+
+struct alignas(kLine) Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t mode;
+    uint32_t capacity;          // slots, power of two
+    uint32_t slotSize;          // max payload bytes per slot
+    uint32_t stride;            // bytes per slot including its header
+    std::atomic<uint32_t> ready;
+    std::atomic<uint32_t> closed;
+    alignas(kLine) std::atomic<uint64_t> tail;          // next slot to write
+    alignas(kLine) std::atomic<uint64_t> head;          // next slot to read
+    alignas(kLine) std::atomic<uint32_t> dataSignal;
+    std::atomic<uint32_t> consumersWaiting;
+    alignas(kLine) std::atomic<uint32_t> spaceSignal;
+    std::atomic<uint32_t> producersWaiting;
+};
+
+struct Slot {
+    std::atomic<uint64_t> seq;  // MPMC turn counter, unused by SPSC
+    uint32_t length;
+    uint32_t pad;
+    // payload follows
+};
+
+static size_t roundUp(size_t v, size_t to) { return (v + to - 1) / to * to; }
+static size_t strideFor(uint32_t slotSize) { return sizeof(Slot) + roundUp(slotSize, 8); }
+static size_t bytesFor(uint32_t capacity, uint32_t slotSize) {
+    return roundUp(sizeof(Header), kLine) + (size_t)capacity * strideFor(slotSize);
+}
+
+// ---------- futex wait / wake ----------
+
+static void futexWait(std::atomic<uint32_t>* word, uint32_t expected, int timeoutMs) {
+#ifdef __linux__
+    struct timespec ts, *tp = nullptr;
+    if (timeoutMs >= 0) {
+        ts.tv_sec = timeoutMs / 1000;
+        ts.tv_nsec = (long)(timeoutMs % 1000) * 1000000L;
+        tp = &ts;
+    }
+    // Not FUTEX_PRIVATE: the word may be mapped into another process.
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected, tp, nullptr, 0);
+#else
+    if (word->load() == expected) std::this_thread::sleep_for(std::chrono::microseconds(50));
+    (void)timeoutMs;
+#endif
+}
+
+static void futexWake(std::atomic<uint32_t>* word, int count) {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, count, nullptr, nullptr, 0);
+#else
+    (void)word; (void)count;
+#endif
+}
+
+static inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// ---------- ring ----------
+
+class Ring {
+public:
+    Header* h = nullptr;
+    uint8_t* slots = nullptr;
+    uint64_t mask = 0;
+
+    void attach(void* base) {
+        h = reinterpret_cast<Header*>(base);
+        slots = reinterpret_cast<uint8_t*>(base) + roundUp(sizeof(Header), kLine);
+        mask = h->capacity - 1;
+    }
+
+    static void init(void* base, uint32_t mode, uint32_t capacity, uint32_t slotSize) {
+        Header* h = new (base) Header();
+        h->magic = kMagic;
+        h->version = kVersion;
+        h->mode = mode;
+        h->capacity = capacity;
+        h->slotSize = slotSize;
+        h->stride = (uint32_t)strideFor(slotSize);
+        h->tail.store(0);
+        h->head.store(0);
+        h->closed.store(0);
+        uint8_t* slots = reinterpret_cast<uint8_t*>(base) + roundUp(sizeof(Header), kLine);
+        for (uint32_t i = 0; i < capacity; i++)
+            new (slots + (size_t)i * h->stride) Slot{ {i}, 0, 0 };
+        h->ready.store(1, std::memory_order_release);
+        futexWake(&h->ready, INT_MAX);
+    }
+
+    Slot* slot(uint64_t pos) const { return reinterpret_cast<Slot*>(slots + (pos & mask) * h->stride); }
+    static uint8_t* payload(Slot* s) { return reinterpret_cast<uint8_t*>(s) + sizeof(Slot); }
+
+    uint64_t size() const {
+        uint64_t t = h->tail.load(std::memory_order_acquire), hd = h->head.load(std::memory_order_acquire);
+        return t > hd ? t - hd : 0;
+    }
+
+    // Writes up to n records of `len` bytes each (records packed back to back
+    // in src); returns how many went in.
+    size_t tryPush(const uint8_t* src, size_t n, uint32_t len, size_t srcStride) {
+        if (n == 0) return 0;
+        if (h->mode == kSpsc) {
+            uint64_t t = h->tail.load(std::memory_order_relaxed);
+            uint64_t free = h->capacity - (t - h->head.load(std::memory_order_acquire));
+            size_t k = n < free ? n : (size_t)free;
+            for (size_t i = 0; i < k; i++) {
+                Slot* s = slot(t + i);
+                s->length = len;
+                memcpy(payload(s), src + i * srcStride, len);
+            }
+            if (k) h->tail.store(t + k, std::memory_order_release);
+            return k;
+        }
+        size_t done = 0;
+        while (done < n) {
+            uint64_t pos = h->tail.load(std::memory_order_relaxed);
+            Slot* s;
+            for (;;) {
+                s = slot(pos);
+                int64_t diff = (int64_t)s->seq.load(std::memory_order_acquire) - (int64_t)pos;
+                if (diff == 0) {
+                    if (h->tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else if (diff < 0) {
+                    return done;   // full
+                } else {
+                    pos = h->tail.load(std::memory_order_relaxed);
+                }
+            }
+            s->length = len;
+            memcpy(payload(s), src + done * srcStride, len);
+            s->seq.store(pos + 1, std::memory_order_release);
+            done++;
+        }
+        return done;
+    }
+
+    // Reads up to n records into dst (each record gets dstStride bytes);
+    // lengths[i] receives the payload size if given.
+    size_t tryPop(uint8_t* dst, size_t n, size_t dstStride, uint32_t* lengths) {
+        if (n == 0) return 0;
+        if (h->mode == kSpsc) {
+            uint64_t hd = h->head.load(std::memory_order_relaxed);
+            uint64_t avail = h->tail.load(std::memory_order_acquire) - hd;
+            size_t k = n < avail ? n : (size_t)avail;
+            for (size_t i = 0; i < k; i++) {
+                Slot* s = slot(hd + i);
+                uint32_t len = s->length < dstStride ? s->length : (uint32_t)dstStride;
+                memcpy(dst + i * dstStride, payload(s), len);
+                if (lengths) lengths[i] = len;
+            }
+            if (k) h->head.store(hd + k, std::memory_order_release);
+            return k;
+        }
+        size_t done = 0;
+        while (done < n) {
+            uint64_t pos = h->head.load(std::memory_order_relaxed);
+            Slot* s;
+            for (;;) {
+                s = slot(pos);
+                int64_t diff = (int64_t)s->seq.load(std::memory_order_acquire) - (int64_t)(pos + 1);
+                if (diff == 0) {
+                    if (h->head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else if (diff < 0) {
+                    return done;   // empty
+                } else {
+                    pos = h->head.load(std::memory_order_relaxed);
+                }
+            }
+            uint32_t len = s->length < dstStride ? s->length : (uint32_t)dstStride;
+            memcpy(dst + done * dstStride, payload(s), len);
+            if (lengths) lengths[done] = len;
+            s->seq.store(pos + mask + 1, std::memory_order_release);
+            done++;
+        }
+        return done;
+    }
+
+    void notify(std::atomic<uint32_t>& signal, std::atomic<uint32_t>& waiters, int count) {
+        signal.fetch_add(1, std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_seq_cst)) futexWake(&signal, count);
+    }
+
+    // Retries op() until it makes progress, the ring is closed or the
+    // deadline passes. Spins briefly, then sleeps on the signal word.
+    template <typename Op>
+    size_t blocking(Op op, std::atomic<uint32_t>& signal, std::atomic<uint32_t>& waiters, double timeoutMs) {
+        size_t got = op();
+        if (got || timeoutMs == 0) return got;
+        for (int i = 0; i < kSpins; i++) {
+            cpuRelax();
+            if ((got = op())) return got;
+        }
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double, std::milli>(timeoutMs);
+        for (;;) {
+            uint32_t seen = signal.load(std::memory_order_seq_cst);
+            waiters.fetch_add(1, std::memory_order_seq_cst);
+            if ((got = op()) || h->closed.load()) {
+                waiters.fetch_sub(1, std::memory_order_seq_cst);
+                return got;
+            }
+            int wait = -1;
+            if (timeoutMs > 0) {
+                double left = std::chrono::duration<double, std::milli>(deadline - std::chrono::steady_clock::now()).count();
+                if (left <= 0) { waiters.fetch_sub(1, std::memory_order_seq_cst); return 0; }
+                wait = (int)left + 1;
+            }
+            futexWait(&signal, seen, wait);
+            waiters.fetch_sub(1, std::memory_order_seq_cst);
+        }
+    }
+
+    size_t push(const uint8_t* src, size_t n, uint32_t len, size_t srcStride, double timeoutMs) {
+        size_t done = 0;
+        while (done < n) {
+            size_t k = blocking([&] { return tryPush(src + done * srcStride, n - done, len, srcStride); },
+                                h->spaceSignal, h->producersWaiting, timeoutMs);
+            if (!k) break;
+            done += k;
+            notify(h->dataSignal, h->consumersWaiting, k > 1 ? INT_MAX : 1);
+        }
+        return done;
+    }
+
+    size_t pop(uint8_t* dst, size_t n, size_t dstStride, uint32_t* lengths, double timeoutMs) {
+        size_t k = blocking([&] { return tryPop(dst, n, dstStride, lengths); },
+                            h->dataSignal, h->consumersWaiting, timeoutMs);
+        if (k) notify(h->spaceSignal, h->producersWaiting, k > 1 ? INT_MAX : 1);
+        return k;
+    }
+
+    void close() {
+        h->closed.store(1);
+        h->dataSignal.fetch_add(1);
+        h->spaceSignal.fetch_add(1);
+        futexWake(&h->dataSignal, INT_MAX);
+        futexWake(&h->spaceSignal, INT_MAX);
+    }
+};
+
+// ---------- JS binding ----------
+
+static bool isPowerOfTwo(uint32_t v) { return v && !(v & (v - 1)); }
+
+// Data pointer of a typed array. Goes through the raw call because
+// ArrayBuffer().Data() rejects views over a SharedArrayBuffer.
+static uint8_t* viewData(Napi::TypedArray ta) {
+    void* data = nullptr;
+    napi_get_typedarray_info(ta.Env(), ta, nullptr, nullptr, &data, nullptr, nullptr);
+    return static_cast<uint8_t*>(data);
+}
+
+// Bytes of a Buffer / TypedArray / DataView / string argument.
+static bool bytesOf(Napi::Value v, const uint8_t*& data, size_t& len, std::string& tmp) {
+    if (v.IsString()) {
+        tmp = v.As<Napi::String>().Utf8Value();
+        data = reinterpret_cast<const uint8_t*>(tmp.data());
+        len = tmp.size();
+        return true;
+    }
+    if (v.IsTypedArray()) {
+        Napi::TypedArray ta = v.As<Napi::TypedArray>();
+        data = viewData(ta);
+        len = ta.ByteLength();
+        return true;
+    }
+    if (v.IsDataView()) {
+        void* raw = nullptr;
+        napi_get_dataview_info(v.Env(), v, &len, &raw, nullptr, nullptr);
+        data = static_cast<const uint8_t*>(raw);
+        return true;
+    }
+    return false;
+}
+
+static double timeoutArg(const Napi::CallbackInfo& info, size_t i, double dflt) {
+    if (info.Length() > i && info[i].IsNumber()) {
+        double t = info[i].As<Napi::Number>().DoubleValue();
+        return t < 0 ? -1 : t;
+    }
+    return dflt;
+}
+
+class Channel : public Napi::ObjectWrap<Channel> {
+public:
+    static Napi::Function Define(Napi::Env env) {
+        return DefineClass(env, "Channel", {
+            InstanceMethod("send", &Channel::Send),
+            InstanceMethod("trySend", &Channel::TrySend),
+            InstanceMethod("recv", &Channel::Recv),
+            InstanceMethod("tryRecv", &Channel::TryRecv),
+            InstanceMethod("recvAsync", &Channel::RecvAsync),
+            InstanceMethod("sendBatch", &Channel::SendBatch),
+            InstanceMethod("recvBatch", &Channel::RecvBatch),
+            InstanceMethod("size", &Channel::Size),
+            InstanceMethod("close", &Channel::Close),
+            InstanceMethod("info", &Channel::Info),
+        });
+    }
+
+    // new Channel(Uint8Array over shared memory[, { mode, capacity, slotSize }])
+    // With options the memory is initialised, without it an existing ring is attached.
+    Channel(const Napi::CallbackInfo& info) : Napi::ObjectWrap<Channel>(info) {
+        Napi::Env env = info.Env();
+        if (info.Length() == 0) return;   // filled in by openShared()
+        if (!info[0].IsTypedArray()) {
+            Napi::TypeError::New(env, "Expected a Uint8Array over a SharedArrayBuffer").ThrowAsJavaScriptException();
+            return;
+        }
+        Napi::TypedArray view = info[0].As<Napi::TypedArray>();
+        uint8_t* base = viewData(view);
+        size_t len = view.ByteLength();
+        if (reinterpret_cast<uintptr_t>(base) % 8) {
+            Napi::Error::New(env, "Channel memory must be 8-byte aligned").ThrowAsJavaScriptException();
+            return;
+        }
+        backing = Napi::Persistent(view.As<Napi::Object>());
+        if (info.Length() > 1 && info[1].IsObject()) {
+            if (!initFromOptions(env, info[1].As<Napi::Object>(), base, len)) return;
+        } else if (!checkAttached(env, base, len)) {
+            return;
+        }
+        ring.attach(base);
+    }
+
+    ~Channel() { unmap(); }
+
+    // Used by openShared() to hand over an mmap'ed region.
+    void adoptMapping(void* base, size_t len) { mapped = base; mappedLen = len; ring.attach(base); }
+
+    bool initFromOptions(Napi::Env env, Napi::Object opts, void* base, size_t len) {
+        uint32_t mode = kSpsc, capacity = 1024, slotSize = 64;
+        if (!parseOptions(env, opts, mode, capacity, slotSize)) return false;
+        if (bytesFor(capacity, slotSize) > len) {
+            Napi::RangeError::New(env, "Buffer too small for this channel, see bytesFor()").ThrowAsJavaScriptException();
+            return false;
+        }
+        Ring::init(base, mode, capacity, slotSize);
+        return true;
+    }
+
+    static bool parseOptions(Napi::Env env, Napi::Object opts, uint32_t& mode, uint32_t& capacity, uint32_t& slotSize) {
+        if (opts.Has("mode")) {
+            std::string m = opts.Get("mode").ToString().Utf8Value();
+            if (m == "spsc") mode = kSpsc;
+            else if (m == "mpmc") mode = kMpmc;
+            else {
+                Napi::TypeError::New(env, "mode must be 'spsc' or 'mpmc'").ThrowAsJavaScriptException();
+                return false;
+            }
+        }
+        if (opts.Has("capacity")) capacity = opts.Get("capacity").ToNumber().Uint32Value();
+        if (opts.Has("slotSize")) slotSize = opts.Get("slotSize").ToNumber().Uint32Value();
+        if (!isPowerOfTwo(capacity) || slotSize == 0) {
+            Napi::RangeError::New(env, "capacity must be a power of two and slotSize > 0").ThrowAsJavaScriptException();
+            return false;
+        }
+        return true;
+    }
+
+    static bool checkAttached(Napi::Env env, void* base, size_t len) {
+        Header* h = reinterpret_cast<Header*>(base);
+        if (len < sizeof(Header) || h->magic != kMagic || h->version != kVersion || !h->ready.load(std::memory_order_acquire)) {
+            Napi::Error::New(env, "Memory does not hold an initialised channel").ThrowAsJavaScriptException();
+            return false;
+        }
+        if (bytesFor(h->capacity, h->slotSize) > len) {
+            Napi::RangeError::New(env, "Channel header does not match the buffer size").ThrowAsJavaScriptException();
+            return false;
+        }
+        return true;
+    }
+
+private:
+    Ring ring;
+    Napi::ObjectReference backing;
+    void* mapped = nullptr;
+    size_t mappedLen = 0;
+
+    void unmap() {
+#ifndef _WIN32
+        if (mapped) munmap(mapped, mappedLen);
+#endif
+        mapped = nullptr;
+    }
+
+    bool usable(Napi::Env env) {
+        if (!ring.h) {
+            Napi::Error::New(env, "Channel is not attached").ThrowAsJavaScriptException();
+            return false;
+        }
+        return true;
+    }
+
+    Napi::Value sendImpl(const Napi::CallbackInfo& info, double timeoutMs) {
+        Napi::Env env = info.Env();
+        if (!usable(env)) return env.Null();
+        const uint8_t* data; size_t len; std::string tmp;
+        if (info.Length() < 1 || !bytesOf(info[0], data, len, tmp)) {
+            Napi::TypeError::New(env, "send expects a string, Buffer or TypedArray").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        if (len > ring.h->slotSize) {
+            Napi::RangeError::New(env, "Message larger than the channel's slotSize").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        if (ring.h->closed.load()) {
+            Napi::Error::New(env, "Channel is closed").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        return Napi::Boolean::New(env, ring.push(data, 1, (uint32_t)len, len, timeoutMs) == 1);
+    }
+
+    Napi::Value recvImpl(const Napi::CallbackInfo& info, double timeoutMs) {
+        Napi::Env env = info.Env();
+        if (!usable(env)) return env.Null();
+        Napi::Buffer<uint8_t> out = Napi::Buffer<uint8_t>::New(env, ring.h->slotSize);
+        uint32_t len = 0;
+        if (!ring.pop(out.Data(), 1, ring.h->slotSize, &len, timeoutMs)) return env.Null();
+        return Napi::Buffer<uint8_t>::Copy(env, out.Data(), len);
+    }
+
+    // send(data[, timeoutMs]) -> true, or false on timeout
+    Napi::Value Send(const Napi::CallbackInfo& info) { return sendImpl(info, timeoutArg(info, 1, -1)); }
+    Napi::Value TrySend(const Napi::CallbackInfo& info) { return sendImpl(info, 0); }
+    // recv([timeoutMs]) -> Buffer, or null on timeout / closed and drained
+    Napi::Value Recv(const Napi::CallbackInfo& info) { return recvImpl(info, timeoutArg(info, 0, -1)); }
+    Napi::Value TryRecv(const Napi::CallbackInfo& info) { return recvImpl(info, 0); }
+
+    // sendBatch(typedArray[, timeoutMs]) -> records sent.
+    // The array is cut into slotSize-byte records.
+    Napi::Value SendBatch(const Napi::CallbackInfo& info) {
+        Napi::Env env = info.Env();
+        if (!usable(env)) return env.Null();
+        const uint8_t* data; size_t len; std::string tmp;
+        if (info.Length() < 1 || info[0].IsString() || !bytesOf(info[0], data, len, tmp)) {
+            Napi::TypeError::New(env, "sendBatch expects a Buffer or TypedArray").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        uint32_t rec = ring.h->slotSize;
+        if (len % rec) {
+            Napi::RangeError::New(env, "Batch length must be a multiple of slotSize").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        if (ring.h->closed.load()) {
+            Napi::Error::New(env, "Channel is closed").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        size_t sent = ring.push(data, len / rec, rec, rec, timeoutArg(info, 1, -1));
+        return Napi::Number::New(env, (double)sent);
+    }
+
+    // recvBatch(typedArray[, timeoutMs]) -> records received.
+    // Waits for at least one record, then takes whatever else is ready.
+    Napi::Value RecvBatch(const Napi::CallbackInfo& info) {
+        Napi::Env env = info.Env();
+        if (!usable(env)) return env.Null();
+        if (info.Length() < 1 || !info[0].IsTypedArray()) {
+            Napi::TypeError::New(env, "recvBatch expects a TypedArray").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        Napi::TypedArray ta = info[0].As<Napi::TypedArray>();
+        uint8_t* dst = viewData(ta);
+        uint32_t rec = ring.h->slotSize;
+        size_t room = ta.ByteLength() / rec;
+        if (room == 0) {
+            // pop() of zero records would wait for one it can't take
+            Napi::RangeError::New(env, "recvBatch needs room for at least one record (slotSize bytes)").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        size_t got = ring.pop(dst, room, rec, nullptr, timeoutArg(info, 1, -1));
+        return Napi::Number::New(env, (double)got);
+    }
+
+    class RecvWorker : public Napi::AsyncWorker {
+    public:
+        RecvWorker(Napi::Env env, Channel* ch, Napi::Object self, double timeoutMs)
+            : Napi::AsyncWorker(env), deferred(Napi::Promise::Deferred::New(env)),
+              ch(ch), timeoutMs(timeoutMs), buf(ch->ring.h->slotSize) {
+            selfRef = Napi::Persistent(self);
+        }
+        void Execute() override {
+            got = ch->ring.pop(buf.data(), 1, buf.size(), &len, timeoutMs) == 1;
+        }
+        void OnOK() override {
+            if (got) deferred.Resolve(Napi::Buffer<uint8_t>::Copy(Env(), buf.data(), len));
+            else deferred.Resolve(Env().Null());
+        }
+        Napi::Promise::Deferred deferred;
+    private:
+        Channel* ch;
+        Napi::ObjectReference selfRef;   // keeps the channel (and its memory) alive
+        double timeoutMs;
+        std::vector<uint8_t> buf;
+        uint32_t len = 0;
+        bool got = false;
+    };
+
+    // recvAsync([timeoutMs]) -> Promise<Buffer|null>; waits off the main thread.
+    Napi::Value RecvAsync(const Napi::CallbackInfo& info) {
+        Napi::Env env = info.Env();
+        if (!usable(env)) return env.Null();
+        auto* w = new RecvWorker(env, this, info.This().As<Napi::Object>(), timeoutArg(info, 0, -1));
+        Napi::Promise p = w->deferred.Promise();
+        w->Queue();
+        return p;
+    }
+
+    Napi::Value Size(const Napi::CallbackInfo& info) {
+        Napi::Env env = info.Env();
+        if (!usable(env)) return env.Null();
+        return Napi::Number::New(env, (double)ring.size());
+    }
+
+    // Wakes every waiter; receivers drain what is left, then get null.
+    Napi::Value Close(const Napi::CallbackInfo& info) {
+        Napi::Env env = info.Env();
+        if (!usable(env)) return env.Null();
+        ring.close();
+        return env.Undefined();
+    }
+
+    Napi::Value Info(const Napi::CallbackInfo& info) {
+        Napi::Env env = info.Env();
+        if (!usable(env)) return env.Null();
+        Napi::Object o = Napi::Object::New(env);
+        o.Set("mode", ring.h->mode == kMpmc ? "mpmc" : "spsc");
+        o.Set("capacity", ring.h->capacity);
+        o.Set("slotSize", ring.h->slotSize);
+        o.Set("size", (double)ring.size());
+        o.Set("closed", ring.h->closed.load() != 0);
+        o.Set("shared", mapped != nullptr);
+        return o;
+    }
+};
+
+// bytesFor(capacity, slotSize) -> bytes of shared memory a channel needs
+Napi::Value BytesFor(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 2 || !info[0].IsNumber() || !info[1].IsNumber()) {
+        Napi::TypeError::New(env, "Expected (capacity, slotSize)").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    return Napi::Number::New(env, (double)bytesFor(info[0].As<Napi::Number>().Uint32Value(), info[1].As<Napi::Number>().Uint32Value()));
+}
+
+#ifndef _WIN32
+// openShared(name[, { mode, capacity, slotSize }]) -> Channel over a POSIX shm
+// segment. The first process to open the name creates and initialises it,
+// later ones attach (waiting for the creator to finish if needed).
+Napi::Value OpenShared(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "Expected a shared memory name").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    std::string name = info[0].As<Napi::String>().Utf8Value();
+    if (name.empty() || name[0] != '/') name = "/" + name;
+
+    uint32_t mode = kSpsc, capacity = 1024, slotSize = 64;
+    if (info.Length() > 1 && info[1].IsObject() &&
+        !Channel::parseOptions(env, info[1].As<Napi::Object>(), mode, capacity, slotSize)) return env.Null();
+
+    bool creator = true;
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0 && errno == EEXIST) {
+        creator = false;
+        fd = shm_open(name.c_str(), O_RDWR, 0600);
+    }
+    if (fd < 0) {
+        Napi::Error::New(env, std::string("shm_open failed: ") + strerror(errno)).ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    size_t len;
+    if (creator) {
+        len = bytesFor(capacity, slotSize);
+        if (ftruncate(fd, (off_t)len) != 0) {
+            int err = errno;
+            close(fd);
+            shm_unlink(name.c_str());
+            Napi::Error::New(env, std::string("ftruncate failed: ") + strerror(err)).ThrowAsJavaScriptException();
+            return env.Null();
+        }
+    } else {
+        // The creator may not have sized the segment yet.
+        struct stat st;
+        for (int i = 0;; i++) {
+            if (fstat(fd, &st) != 0) {
+                int err = errno;
+                close(fd);
+                Napi::Error::New(env, std::string("fstat failed: ") + strerror(err)).ThrowAsJavaScriptException();
+                return env.Null();
+            }
+            if (st.st_size != 0 || i == 1000) break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        len = (size_t)st.st_size;
+    }
+
+    void* base = len ? mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);
+    if (base == MAP_FAILED) {
+        Napi::Error::New(env, "mmap of the channel failed").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+
+    Header* h = reinterpret_cast<Header*>(base);
+    if (creator) {
+        Ring::init(base, mode, capacity, slotSize);
+    } else {
+        for (int i = 0; i < 1000 && !h->ready.load(std::memory_order_acquire); i++)
+            futexWait(&h->ready, 0, 1);
+        if (!Channel::checkAttached(env, base, len)) {
+            munmap(base, len);
+            return env.Null();
+        }
+    }
+
+    Napi::Object obj = env.GetInstanceData<Napi::FunctionReference>()->New({});
+    if (env.IsExceptionPending()) { munmap(base, len); return env.Null(); }
+    Channel::Unwrap(obj)->adoptMapping(base, len);
+    obj.Set("name", name);
+    return obj;
+}
+
+// unlinkShared(name): removes the name; mapped channels keep working.
+Napi::Value UnlinkShared(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "Expected a shared memory name").ThrowAsJavaScriptException();
+        return env.Null();
+    }
+    std::string name = info[0].As<Napi::String>().Utf8Value();
+    if (name.empty() || name[0] != '/') name = "/" + name;
+    return Napi::Boolean::New(env, shm_unlink(name.c_str()) == 0);
+}
+#endif
+
+Napi::Object Init(Napi::Env env, Napi::Object exports) {
+    Napi::Function channel = Channel::Define(env);
+    // Per environment: every worker thread loads its own copy of the class.
+    env.SetInstanceData(new Napi::FunctionReference(Napi::Persistent(channel)));
+    exports.Set("Channel", channel);
+    exports.Set("bytesFor", Napi::Function::New(env, BytesFor));
+#ifndef _WIN32
+    exports.Set("openShared", Napi::Function::New(env, OpenShared));
+    exports.Set("unlinkShared", Napi::Function::New(env, UnlinkShared));
+#endif
+    return exports;
+}
+
+NODE_API_MODULE(channels, Init)
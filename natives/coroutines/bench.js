@@ -0,0 +1,24 @@
+// Launches 100k concurrent native tasks through the coroutine scheduler.
+// usage: node bench.js [count] [sleepMs]
+const tasks = require('./index.js');
+
+const count = Number(process.argv[2]) || 100000;
+const ms = Number(process.argv[3]) || 10;
+
+const threads = () => require('fs').readFileSync('/proc/self/status', 'utf8').match(/Threads:\s+(\d+)/)[1];
+
+async function run(label, fn) {
+  const cpu = process.cpuUsage();
+  const t0 = process.hrtime.bigint();
+  const n = await fn();
+  const wall = Number(process.hrtime.bigint() - t0) / 1e6;
+  const used = process.cpuUsage(cpu);
+  console.log(`${label.padEnd(14)} tasks=${n} wall=${wall.toFixed(1)}ms cpu=${((used.user + used.system) / 1000).toFixed(1)}ms ` +
+    `rss=${(process.memoryUsage().rss / 1048576).toFixed(1)}MB threads=${threads()}`);
+}
+
+(async () => {
+  console.log('workers:', tasks.stats().workers);
+  await run('spawn (joined)', () => tasks.spawn(count, ms));
+  await run('sleep promises', async () => (await Promise.all(Array.from({ length: count }, () => tasks.sleep(ms)))).length);
+})();
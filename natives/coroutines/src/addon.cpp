@@ -2,52 +2,440 @@
 #include <coroutine>
 #include <thread>
 #include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <queue>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <atomic>
+#include <optional>
+#include <exception>
+#include <functional>
+#include <unordered_map>
+#include <memory>
 
+using Clock = std::chrono::steady_clock;
+
+// ---------- Scheduler ----------
+// A fixed pool of workers resumes ready coroutines; one timer thread moves
+// sleeping coroutines back to the ready queue when their deadline passes.
+// Thousands of suspended tasks therefore cost a coroutine frame each, not a thread.
+class Scheduler {
+public:
+    explicit Scheduler(unsigned workers) {
+        if (workers == 0) workers = 1;
+        for (unsigned i = 0; i < workers; i++) pool.emplace_back([this] { workerLoop(); });
+        timerThread = std::thread([this] { timerLoop(); });
+    }
+
+    ~Scheduler() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        cv.notify_all();
+        {
+            std::lock_guard<std::mutex> lock(timerMtx);
+            timerStopping = true;
+        }
+        timerCv.notify_all();
+        for (auto& t : pool) t.join();
+        timerThread.join();
+        // Frames still suspended at shutdown are owned by their root tasks and
+        // are left to process exit rather than destroyed piecemeal here.
+    }
+
+    void schedule(std::coroutine_handle<> h) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            ready.push_back(h);
+        }
+        cv.notify_one();
+    }
+
+    void scheduleAt(Clock::time_point when, std::coroutine_handle<> h) {
+        bool earliest;
+        {
+            std::lock_guard<std::mutex> lock(timerMtx);
+            earliest = timers.empty() || when < timers.top().when;
+            timers.push({ when, seq++, h });
+        }
+        if (earliest) timerCv.notify_one();
+    }
+
+    size_t workers() const { return pool.size(); }
+
+    size_t sleeping() {
+        std::lock_guard<std::mutex> lock(timerMtx);
+        return timers.size();
+    }
+
+private:
+    struct Timer {
+        Clock::time_point when;
+        uint64_t seq;
+        std::coroutine_handle<> handle;
+        bool operator>(const Timer& o) const { return when != o.when ? when > o.when : seq > o.seq; }
+    };
+
+    void workerLoop() {
+        for (;;) {
+            std::coroutine_handle<> h;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.wait(lock, [this] { return stopping || !ready.empty(); });
+                if (stopping) return;
+                h = ready.front();
+                ready.pop_front();
+            }
+            h.resume();
+        }
+    }
+
+    void timerLoop() {
+        std::unique_lock<std::mutex> lock(timerMtx);
+        while (!timerStopping) {
+            if (timers.empty()) {
+                timerCv.wait(lock);
+                continue;
+            }
+            auto next = timers.top().when;
+            if (Clock::now() < next) {
+                timerCv.wait_until(lock, next);
+                continue;
+            }
+            // Expire every due timer in one batch.
+            std::vector<std::coroutine_handle<>> due;
+            auto now = Clock::now();
+            while (!timers.empty() && timers.top().when <= now) {
+                due.push_back(timers.top().handle);
+                timers.pop();
+            }
+            lock.unlock();
+            {
+                std::lock_guard<std::mutex> rlock(mtx);
+                for (auto h : due) ready.push_back(h);
+            }
+            if (due.size() == 1) cv.notify_one();
+            else cv.notify_all();
+            lock.lock();
+        }
+    }
+
+    std::vector<std::thread> pool;
+    std::thread timerThread;
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<std::coroutine_handle<>> ready;
+    bool stopping = false;
+
+    std::mutex timerMtx;
+    std::condition_variable timerCv;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers;
+    uint64_t seq = 0;
+    bool timerStopping = false;
+};
+
+// One scheduler for the process, shared by every env (the main thread and
+// any worker_threads) that loads the addon; the last env to exit stops it.
+Scheduler* scheduler = nullptr;
+std::mutex schedulerMtx;
+unsigned schedulerUsers = 0;
+
+// ---------- Task ----------
+// Lazily started; awaiting a Task starts it and resumes the awaiter on completion.
+template <typename T>
 struct Task {
     struct promise_type {
-        int value;
+        std::optional<T> value;
+        std::exception_ptr error;
+        std::coroutine_handle<> continuation;
+
         Task get_return_object() {
             return Task{ std::coroutine_handle<promise_type>::from_promise(*this) };
         }
-        std::suspend_never initial_suspend() { return {}; }
-        std::suspend_never final_suspend() noexcept { return {}; }
-        void return_value(int v) { value = v; }
-        void unhandled_exception() { std::terminate(); }
+        std::suspend_always initial_suspend() { return {}; }
+
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+                auto next = h.promise().continuation;
+                return next ? next : std::noop_coroutine();
+            }
+            void await_resume() noexcept {}
+        };
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void return_value(T v) { value = std::move(v); }
+        void unhandled_exception() { error = std::current_exception(); }
     };
 
     std::coroutine_handle<promise_type> coro;
 
+    explicit Task(std::coroutine_handle<promise_type> h) : coro(h) {}
+    Task(Task&& o) noexcept : coro(o.coro) { o.coro = nullptr; }
+    Task(const Task&) = delete;
     ~Task() { if (coro) coro.destroy(); }
 
-    int get() { return coro.promise().value; }
+    bool await_ready() { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter) {
+        coro.promise().continuation = awaiter;
+        return coro;
+    }
+    T await_resume() {
+        if (coro.promise().error) std::rethrow_exception(coro.promise().error);
+        return std::move(*coro.promise().value);
+    }
+};
+
+// Fire-and-forget root frame: queued on the pool, frees itself when done.
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() { return { std::coroutine_handle<promise_type>::from_promise(*this) }; }
+        std::suspend_always initial_suspend() { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+    std::coroutine_handle<promise_type> coro;
+};
+
+// ---------- Awaitables ----------
+struct SleepAwaiter {
+    int ms;
+    bool await_ready() { return ms <= 0; }
+    void await_suspend(std::coroutine_handle<> h) {
+        scheduler->scheduleAt(Clock::now() + std::chrono::milliseconds(ms), h);
+    }
+    void await_resume() {}
 };
 
+SleepAwaiter sleepFor(int ms) { return SleepAwaiter{ ms }; }
+
+// Roots always run on a pool worker, so blocking file reads here occupy a
+// worker rather than the JS thread.
+Task<std::string> readFileTask(std::string path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("Cannot open " + path);
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    co_return ss.str();
+}
+
+Task<double> sleepTask(int ms) {
+    co_await sleepFor(ms);
+    co_return (double)ms;
+}
+
 // Example coroutine
-Task addAsync(int a, int b) {
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+Task<double> addAsync(double a, double b) {
+    co_await sleepFor(100);
     co_return a + b;
 }
 
-// Node wrapper
+// ---------- Bridge back to JS ----------
+// Completions are queued from workers; the first one after a drain wakes the
+// JS thread through the ThreadSafeFunction, which settles the whole batch.
+struct Completion {
+    uint64_t id;
+    bool isString = false;
+    double num = 0;
+    std::string str;
+    std::string error;
+};
+
+// One per env, kept as its instance data. Tasks hold a reference too, so a
+// task that finishes after its env has exited finds the bridge closed and
+// drops its result instead of calling into a dead env.
+struct Bridge {
+    Napi::ThreadSafeFunction tsfn;
+    std::mutex mtx;
+    std::vector<Completion> done;
+    bool signalled = false;
+    bool closed = false;
+
+    // JS thread only
+    std::unordered_map<uint64_t, Napi::Promise::Deferred> pending;
+    uint64_t nextId = 1;
+};
+
+using BridgeRef = std::shared_ptr<Bridge>;
+
+BridgeRef bridgeOf(Napi::Env env) { return *env.GetInstanceData<BridgeRef>(); }
+
+void settle(Napi::Env env, Bridge& bridge) {
+    std::vector<Completion> batch;
+    {
+        std::lock_guard<std::mutex> lock(bridge.mtx);
+        batch.swap(bridge.done);
+        bridge.signalled = false;
+    }
+    Napi::HandleScope scope(env);
+    for (auto& c : batch) {
+        auto it = bridge.pending.find(c.id);
+        if (it == bridge.pending.end()) continue;
+        if (!c.error.empty()) it->second.Reject(Napi::Error::New(env, c.error).Value());
+        else if (c.isString) it->second.Resolve(Napi::String::New(env, c.str));
+        else it->second.Resolve(Napi::Number::New(env, c.num));
+        bridge.pending.erase(it);
+    }
+    if (bridge.pending.empty()) bridge.tsfn.Unref(env);
+}
+
+void complete(const BridgeRef& bridge, Completion c) {
+    std::lock_guard<std::mutex> lock(bridge->mtx);
+    if (bridge->closed) return;
+    bridge->done.push_back(std::move(c));
+    if (bridge->signalled) return;
+    bridge->signalled = true;
+    // still under the lock, so the env's cleanup hook cannot close the
+    // tsfn between the check above and this call
+    bridge->tsfn.NonBlockingCall([bridge](Napi::Env env, Napi::Function) { settle(env, *bridge); });
+}
+
+template <typename T>
+Detached runRoot(BridgeRef bridge, uint64_t id, Task<T> task) {
+    Completion c;
+    c.id = id;
+    try {
+        T v = co_await task;
+        if constexpr (std::is_same_v<T, std::string>) {
+            c.isString = true;
+            c.str = std::move(v);
+        } else {
+            c.num = (double)v;
+        }
+    } catch (const std::exception& e) {
+        c.error = e.what();
+    } catch (...) {
+        c.error = "native task failed";
+    }
+    complete(bridge, std::move(c));
+}
+
+template <typename T>
+Napi::Value launch(Napi::Env env, Task<T> task) {
+    BridgeRef bridge = bridgeOf(env);
+    auto deferred = Napi::Promise::Deferred::New(env);
+    uint64_t id = bridge->nextId++;
+    if (bridge->pending.empty()) bridge->tsfn.Ref(env);
+    bridge->pending.emplace(id, deferred);
+    scheduler->schedule(runRoot(bridge, id, std::move(task)).coro);
+    return deferred.Promise();
+}
+
+// ---------- Many tasks, one promise ----------
+struct Join {
+    std::atomic<uint64_t> remaining;
+    uint64_t id;
+    double total;
+    BridgeRef bridge;
+};
+
+Detached joinedSleeper(Join* join, int ms) {
+    co_await sleepFor(ms);
+    if (join->remaining.fetch_sub(1) == 1) {
+        Completion c;
+        c.id = join->id;
+        c.num = join->total;
+        BridgeRef bridge = std::move(join->bridge);
+        delete join;
+        complete(bridge, std::move(c));
+    }
+}
+
+// ---------- Wrappers ----------
 Napi::Value asyncAdd(const Napi::CallbackInfo& info) {
     Napi::Env env = info.Env();
-    int a = info[0].As<Napi::Number>().Int32Value();
-    int b = info[1].As<Napi::Number>().Int32Value();
+    double a = info[0].As<Napi::Number>().DoubleValue();
+    double b = info[1].As<Napi::Number>().DoubleValue();
+    return launch(env, addAsync(a, b));
+}
 
-    auto deferred = Napi::Promise::Deferred::New(env);
+Napi::Value Sleep(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    int ms = info.Length() > 0 ? info[0].As<Napi::Number>().Int32Value() : 0;
+    return launch(env, sleepTask(ms));
+}
 
-    // Run coroutine in a separate thread
-    std::thread([a,b,deferred]() mutable {
-        auto t = addAsync(a, b);
-        deferred.Resolve(Napi::Number::New(deferred.Env(), t.get()));
-    }).detach();
+Napi::Value ReadFile(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "Expected a path").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    return launch(env, readFileTask(info[0].As<Napi::String>().Utf8Value()));
+}
+
+// spawn(count, ms) -> Promise<count>: count native tasks that each sleep ms,
+// resolved once when the last one finishes.
+Napi::Value Spawn(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 1 || !info[0].IsNumber()) {
+        Napi::TypeError::New(env, "Expected (count, ms)").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    int64_t count = info[0].As<Napi::Number>().Int64Value();
+    int ms = info.Length() > 1 ? info[1].As<Napi::Number>().Int32Value() : 0;
 
+    auto deferred = Napi::Promise::Deferred::New(env);
+    if (count <= 0) {
+        deferred.Resolve(Napi::Number::New(env, 0));
+        return deferred.Promise();
+    }
+    BridgeRef bridge = bridgeOf(env);
+    uint64_t id = bridge->nextId++;
+    if (bridge->pending.empty()) bridge->tsfn.Ref(env);
+    bridge->pending.emplace(id, deferred);
+
+    auto* join = new Join{ { (uint64_t)count }, id, (double)count, bridge };
+    for (int64_t i = 0; i < count; i++) scheduler->schedule(joinedSleeper(join, ms).coro);
     return deferred.Promise();
 }
 
+Napi::Value Stats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::Object res = Napi::Object::New(env);
+    res.Set("workers", (double)scheduler->workers());
+    res.Set("sleeping", (double)scheduler->sleeping());
+    res.Set("pending", (double)bridgeOf(env)->pending.size());
+    return res;
+}
+
 // Register addon
 Napi::Object Init(Napi::Env env, Napi::Object exports) {
+    {
+        std::lock_guard<std::mutex> lock(schedulerMtx);
+        if (schedulerUsers++ == 0) scheduler = new Scheduler(std::thread::hardware_concurrency());
+    }
+    auto* bridge = new BridgeRef(std::make_shared<Bridge>());
+    (*bridge)->tsfn = Napi::ThreadSafeFunction::New(env, Napi::Function::New(env, [](const Napi::CallbackInfo&) {}), "coroutines", 0, 1);
+    (*bridge)->tsfn.Unref(env);
+    env.SetInstanceData(bridge);
+
+    // Added after the tsfn, so it runs before node tears the tsfn down.
+    napi_add_env_cleanup_hook(env, [](void* data) {
+        BridgeRef* b = static_cast<BridgeRef*>(data);
+        {
+            std::lock_guard<std::mutex> lock((*b)->mtx);
+            (*b)->closed = true;
+        }
+        delete b;
+        std::lock_guard<std::mutex> lock(schedulerMtx);
+        if (--schedulerUsers == 0) {
+            delete scheduler;
+            scheduler = nullptr;
+        }
+    }, new BridgeRef(*bridge));
+
     exports.Set("addAsync", Napi::Function::New(env, asyncAdd));
+    exports.Set("sleep", Napi::Function::New(env, Sleep));
+    exports.Set("readFile", Napi::Function::New(env, ReadFile));
+    exports.Set("spawn", Napi::Function::New(env, Spawn));
+    exports.Set("stats", Napi::Function::New(env, Stats));
     return exports;
 }
 
@@ -0,0 +1,64 @@
+// Times the decimal addon against big.js on the workloads it is meant for,
+// checking that both give the same answers: exact totals of many values,
+// long division / sqrt, and radix conversion of long integers.
+// usage: node bench.js [count]
+const Big = require('big.js');
+const dec = require('./index.js');
+
+const count = Number(process.argv[2]) || 1000000;
+let failed = false;
+
+function time(run) {
+  const t0 = process.hrtime.bigint();
+  const out = run();
+  return [out, Number(process.hrtime.bigint() - t0) / 1e6];
+}
+
+function report(name, ms, refMs, ok) {
+  if (!ok) failed = true;
+  console.log(`${name.padEnd(28)} ${ms.toFixed(1).padStart(9)} ms   ref ${refMs.toFixed(1).padStart(9)} ms (x${(refMs / ms).toFixed(1)})  ${ok ? 'ok' : 'WRONG'}`);
+}
+
+// Prices with two decimals, as numbers and as strings.
+const values = new Float64Array(count);
+const strings = new Array(count);
+for (let i = 0; i < count; i++) {
+  values[i] = Math.round((Math.random() - 0.3) * 1e8) / 100;
+  strings[i] = String(values[i]);
+}
+const [ref, refMs] = time(() => strings.reduce((t, s) => t.plus(s), new Big(0)));
+
+let [out, ms] = time(() => dec.sum(values));
+report(`sum ${count} Float64Array`, ms, refMs, dec.cmp(out, ref.toString()) === 0);
+[out, ms] = time(() => dec.sum(strings));
+report(`sum ${count} strings`, ms, refMs, dec.cmp(out, ref.toString()) === 0);
+[out, ms] = time(() => {
+  const acc = new dec.Accumulator();
+  for (let i = 0; i < count; i++) acc.add(values[i]);
+  return acc.value();
+});
+report(`Accumulator.add x${count}`, ms, refMs, dec.cmp(out, ref.toString()) === 0);
+
+for (const dp of [100, 1000, 5000]) {
+  Big.DP = dp;
+  const [q, qRef] = time(() => new Big(355).div(113));
+  [out, ms] = time(() => dec.div(355, 113, dp));
+  report(`div 355/113 dp ${dp}`, ms, qRef, dec.cmp(out, q.toString()) === 0);
+  if (dp > 1000) continue;  // big.js sqrt is too slow beyond this
+  const [r, rRef] = time(() => new Big(2).sqrt());
+  [out, ms] = time(() => dec.sqrt(2, dp));
+  report(`sqrt 2 dp ${dp}`, ms, rRef, dec.cmp(out, r.toString()) === 0);
+}
+
+// Radix conversion against BigInt, which does the same in V8.
+for (const digits of [1000, 100000]) {
+  const n = '9'.repeat(digits);
+  const [hex, bigintMs] = time(() => BigInt(n).toString(16));
+  [out, ms] = time(() => dec.toBase(n, 16));
+  const ok = Array.from(out).reverse().map((d) => d.toString(16)).join('') === hex;
+  report(`toBase 16, ${digits} digits`, ms, bigintMs, ok);
+  const [back, backMs] = time(() => dec.fromBase(out, 16));
+  console.log(`${'fromBase 16'.padEnd(28)} ${backMs.toFixed(1).padStart(9)} ms   ${back === n ? 'ok' : 'WRONG'}`);
+  if (back !== n) failed = true;
+}
+process.exitCode = failed ? 1 : 0;
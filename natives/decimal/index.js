@@ -0,0 +1,3 @@
+const addon = require('bindings')('decimal');
+
+module.exports = addon
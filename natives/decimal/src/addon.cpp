@@ -0,0 +1,643 @@
+#include <napi.h>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include "limbs.h"
+
+// Arbitrary-precision decimals behind nova's Big (core/nova-decimal.js),
+// bulk sums and DigitNumber radix conversion.
+//
+// A value is sign * coefficient * 10^exp, the coefficient in base-1e9 limbs
+// (limbs.h). Values cross the boundary as strings ("-123.45", "1.5e-7", or
+// the compact "12345e-2" returned here); JS numbers are read through their
+// shortest round-trip form, so 0.1 is exactly 0.1. Rounding modes are
+// big.js's: 0 down, 1 half-up, 2 half-even, 3 up (all by magnitude).
+
+struct Dec {
+    Limbs mag;
+    int64_t exp = 0;
+    bool neg = false;
+};
+
+static const uint32_t kPow10[10] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+};
+
+// Shifts beyond this many digits (e.g. 1e-999999999 + 1) are refused
+// rather than allocating the zeros.
+static const int64_t kMaxShift = 100000000;
+
+// ---------- parsing and formatting ----------
+
+static std::runtime_error invalid(std::string_view s) {
+    return std::runtime_error("Invalid number: " + std::string(s.substr(0, 40)));
+}
+
+// [+-]digits[.digits][e[+-]digits], or [+-].digits...
+static Dec parse(std::string_view s) {
+    Dec d;
+    size_t i = 0, n = s.size();
+    if (i < n && (s[i] == '-' || s[i] == '+')) d.neg = s[i++] == '-';
+    size_t begin = i;
+    int64_t frac = 0;
+    bool dot = false, any = false;
+    for (; i < n; i++) {
+        char c = s[i];
+        if (c >= '0' && c <= '9') { any = true; if (dot) frac++; }
+        else if (c == '.' && !dot) dot = true;
+        else break;
+    }
+    size_t end = i;
+    if (!any) throw invalid(s);
+    int64_t e = 0;
+    if (i < n && (s[i] == 'e' || s[i] == 'E')) {
+        bool eneg = false;
+        if (++i < n && (s[i] == '-' || s[i] == '+')) eneg = s[i++] == '-';
+        size_t start = i;
+        for (; i < n && s[i] >= '0' && s[i] <= '9'; i++) {
+            e = e * 10 + (s[i] - '0');
+            if (e > kMaxShift * 10) throw std::runtime_error("Exponent out of range");
+        }
+        if (i == start) throw invalid(s);
+        if (eneg) e = -e;
+    }
+    if (i != n) throw invalid(s);
+    d.exp = e - frac;
+
+    // nine digits per limb, from the right
+    uint32_t limb = 0;
+    int filled = 0;
+    for (size_t k = end; k-- > begin;) {
+        if (s[k] == '.') continue;
+        limb += static_cast<uint32_t>(s[k] - '0') * kPow10[filled];
+        if (++filled == 9) { d.mag.push_back(limb); limb = 0; filled = 0; }
+    }
+    if (filled) d.mag.push_back(limb);
+    trim(d.mag);
+    if (d.mag.empty()) d.neg = false;
+    return d;
+}
+
+static void appendCoefficient(std::string& out, const Limbs& mag) {
+    if (mag.empty()) { out += '0'; return; }
+    char buf[16];
+    out += std::to_string(mag.back());
+    for (size_t i = mag.size() - 1; i-- > 0;) {
+        snprintf(buf, sizeof buf, "%09u", mag[i]);
+        out.append(buf, 9);
+    }
+}
+
+static void mulPow10(Limbs& a, int64_t k) {
+    if (k > kMaxShift) throw std::runtime_error("Exponent out of range");
+    if (a.empty() || k <= 0) return;
+    a = shl(a, static_cast<size_t>(k / 9));
+    mulSmall(a, kPow10[k % 9]);
+}
+
+// Drops trailing zero digits into the exponent.
+static void normalize(Dec& d) {
+    if (d.mag.empty()) { d.exp = 0; d.neg = false; return; }
+    size_t zeroLimbs = 0;
+    while (d.mag[zeroLimbs] == 0) zeroLimbs++;
+    int tz = 0;
+    for (uint32_t x = d.mag[zeroLimbs]; x % 10 == 0; x /= 10) tz++;
+    if (zeroLimbs) d.mag = shr(d.mag, zeroLimbs);
+    if (tz) divSmall(d.mag, kPow10[tz]);
+    d.exp += static_cast<int64_t>(zeroLimbs) * 9 + tz;
+}
+
+// "-12345e-2": coefficient without trailing zeros plus exponent.
+static std::string compact(Dec d) {
+    normalize(d);
+    std::string out = d.neg ? "-" : "";
+    appendCoefficient(out, d.mag);
+    if (d.exp) out += "e" + std::to_string(d.exp);
+    return out;
+}
+
+// Plain notation; dp >= 0 pads the fraction to exactly dp digits (the
+// value must already be rounded to dp places).
+static std::string plain(Dec d, int64_t dp) {
+    normalize(d);
+    std::string digits;
+    appendCoefficient(digits, d.mag);
+    std::string out = d.neg ? "-" : "";
+    int64_t fracDigits = 0;
+    if (d.exp >= 0) {
+        out += digits;
+        if (!d.mag.empty()) out.append(static_cast<size_t>(d.exp), '0');
+    } else {
+        fracDigits = -d.exp;
+        int64_t len = static_cast<int64_t>(digits.size());
+        if (len <= fracDigits) {
+            out += "0.";
+            out.append(static_cast<size_t>(fracDigits - len), '0');
+            out += digits;
+        } else {
+            out += digits.substr(0, static_cast<size_t>(len - fracDigits));
+            out += '.';
+            out += digits.substr(static_cast<size_t>(len - fracDigits));
+        }
+    }
+    if (dp > fracDigits) {
+        if (!fracDigits) out += '.';
+        out.append(static_cast<size_t>(dp - fracDigits), '0');
+    }
+    return out;
+}
+
+// ---------- rounding ----------
+
+enum Rest { ZERO, BELOW, HALF, ABOVE };  // dropped part against half a unit
+
+static bool roundsUp(Rest rest, int rm, bool odd) {
+    switch (rm) {
+    case 0: return false;
+    case 1: return rest >= HALF;
+    case 2: return rest == ABOVE || (rest == HALF && odd);
+    case 3: return rest != ZERO;
+    }
+    throw std::runtime_error("Invalid rounding mode");
+}
+
+// mag / 10^k (truncated) and how the dropped digits compare to half.
+static Rest dropDigits(Limbs& mag, int64_t k) {
+    if (k <= 0) return ZERO;
+    if (mag.empty()) return ZERO;
+    if (k > static_cast<int64_t>(mag.size()) * 9 + 1) { mag.clear(); return BELOW; }
+    size_t limbs = static_cast<size_t>(k / 9);
+    int digits = static_cast<int>(k % 9);
+    bool lowZero = true;
+    for (size_t i = 0; i < limbs && i < mag.size(); i++) if (mag[i]) { lowZero = false; break; }
+    Rest rest;
+    if (digits) {
+        Limbs hi = shr(mag, limbs);
+        uint32_t r = divSmall(hi, kPow10[digits]), half = kPow10[digits] / 2;
+        rest = r > half ? ABOVE : r < half ? (r == 0 && lowZero ? ZERO : BELOW) : (lowZero ? HALF : ABOVE);
+        mag = std::move(hi);
+    } else {
+        uint32_t top = limbs - 1 < mag.size() ? mag[limbs - 1] : 0;
+        bool restZero = true;
+        for (size_t i = 0; i + 1 < limbs && i < mag.size(); i++) if (mag[i]) { restZero = false; break; }
+        const uint32_t half = kBase / 2;
+        rest = top > half ? ABOVE : top < half ? (top == 0 && restZero ? ZERO : BELOW) : (restZero ? HALF : ABOVE);
+        mag = shr(mag, limbs);
+    }
+    return rest;
+}
+
+static void applyRounding(Dec& d, Rest rest, int rm) {
+    if (roundsUp(rest, rm, !d.mag.empty() && (d.mag[0] & 1))) addTo(d.mag, Limbs{1});
+    if (d.mag.empty()) d.neg = false;
+}
+
+// To dp decimal places (dp may be negative: tens, hundreds...).
+static Dec roundTo(Dec d, int64_t dp, int rm) {
+    if (d.exp >= -dp) return d;
+    Rest rest = dropDigits(d.mag, -dp - d.exp);
+    d.exp = -dp;
+    applyRounding(d, rest, rm);
+    return d;
+}
+
+// ---------- arithmetic ----------
+
+static void align(Dec& a, Dec& b) {
+    if (a.mag.empty()) { a.exp = b.exp; return; }
+    if (b.mag.empty()) { b.exp = a.exp; return; }
+    if (a.exp > b.exp) { mulPow10(a.mag, a.exp - b.exp); a.exp = b.exp; }
+    else if (b.exp > a.exp) { mulPow10(b.mag, b.exp - a.exp); b.exp = a.exp; }
+}
+
+static Dec addDec(Dec a, Dec b, bool subtract = false) {
+    if (subtract) b.neg = !b.neg && !b.mag.empty();
+    align(a, b);
+    if (a.neg == b.neg) { addTo(a.mag, b.mag); return a; }
+    if (cmp(a.mag, b.mag) >= 0) subFrom(a.mag, b.mag);
+    else { a.mag = sub(b.mag, a.mag); a.neg = b.neg; }
+    if (a.mag.empty()) a.neg = false;
+    return a;
+}
+
+static Dec mulDec(const Dec& a, const Dec& b) {
+    Dec r;
+    r.mag = mul(a.mag, b.mag);
+    r.exp = a.exp + b.exp;
+    r.neg = !r.mag.empty() && a.neg != b.neg;
+    return r;
+}
+
+static Dec divDec(const Dec& a, const Dec& b, int64_t dp, int rm) {
+    if (b.mag.empty()) throw std::runtime_error("Division by zero");
+    Dec r;
+    if (a.mag.empty()) return r;
+    Limbs num = a.mag, den = b.mag, rem;
+    int64_t shift = a.exp - b.exp + dp;
+    if (shift >= 0) mulPow10(num, shift);
+    else mulPow10(den, -shift);
+    divmod(num, den, r.mag, rem);
+    Rest rest = ZERO;
+    if (!rem.empty()) {
+        addTo(rem, rem);
+        int c = cmp(rem, den);
+        rest = c < 0 ? BELOW : c == 0 ? HALF : ABOVE;
+    }
+    r.exp = -dp;
+    r.neg = a.neg != b.neg;
+    applyRounding(r, rest, rm);
+    return r;
+}
+
+// a - b * trunc(a / b): the sign follows a, as in big.js.
+static Dec modDec(Dec a, Dec b) {
+    if (b.mag.empty()) throw std::runtime_error("Division by zero");
+    align(a, b);
+    Limbs q, r;
+    divmod(a.mag, b.mag, q, r);
+    a.mag = std::move(r);
+    if (a.mag.empty()) a.neg = false;
+    return a;
+}
+
+static Dec sqrtDec(const Dec& a, int64_t dp, int rm) {
+    if (a.neg) throw std::runtime_error("No square root");
+    Dec r;
+    if (a.mag.empty()) return r;
+    // one digit past dp, plus whether anything below it is non-zero
+    int64_t e = a.exp + 2 * (dp + 1);
+    Limbs n = a.mag;
+    bool exact = true;
+    if (e >= 0) {
+        mulPow10(n, e);
+    } else {
+        Rest rest = dropDigits(n, -e);
+        exact = rest == ZERO;
+    }
+    r.mag = isqrt(n);
+    if (exact && cmp(mul(r.mag, r.mag), n) != 0) exact = false;
+    Rest rest = dropDigits(r.mag, 1);
+    if (!exact) rest = rest == ZERO ? BELOW : rest == HALF ? ABOVE : rest;
+    r.exp = -dp;
+    applyRounding(r, rest, rm);
+    return r;
+}
+
+static Dec powDec(const Dec& a, int64_t n, int64_t dp, int rm) {
+    Dec base = a, r;
+    r.mag = Limbs{1};
+    bool negative = n < 0;
+    for (uint64_t k = negative ? -static_cast<uint64_t>(n) : static_cast<uint64_t>(n); k; k >>= 1) {
+        if (k & 1) r = mulDec(r, base);
+        if (k > 1) base = mulDec(base, base);
+    }
+    if (negative) {
+        Dec one;
+        one.mag = Limbs{1};
+        return divDec(one, r, dp, rm);
+    }
+    return r;
+}
+
+static int cmpDec(Dec a, Dec b) {
+    if (a.mag.empty() && b.mag.empty()) return 0;
+    if (a.neg != b.neg) return a.neg ? -1 : 1;
+    int sign = a.neg ? -1 : 1;
+    if (a.mag.empty()) return -sign;
+    if (b.mag.empty()) return sign;
+    // compare magnitudes by decimal length + exponent first
+    auto order = [](const Dec& d) {
+        int64_t len = static_cast<int64_t>(d.mag.size() - 1) * 9 + static_cast<int64_t>(std::to_string(d.mag.back()).size());
+        return len + d.exp;
+    };
+    int64_t oa = order(a), ob = order(b);
+    if (oa != ob) return oa < ob ? -sign : sign;
+    align(a, b);
+    return cmp(a.mag, b.mag) * sign;
+}
+
+// ---------- running sums ----------
+
+// Positive and negative terms are kept apart so every add is unsigned; the
+// common exponent only ever moves down (more decimals) as terms arrive.
+class Sum {
+public:
+    void add(const Dec& d, bool subtract = false) {
+        if (d.mag.empty()) return;
+        if (!any) { exp = d.exp; any = true; }
+        if (d.exp < exp) {
+            mulPow10(pos, exp - d.exp);
+            mulPow10(neg, exp - d.exp);
+            exp = d.exp;
+        }
+        Limbs& acc = d.neg != subtract ? neg : pos;
+        if (d.exp == exp) {
+            addTo(acc, d.mag);
+        } else {
+            Limbs t = d.mag;
+            mulPow10(t, d.exp - exp);
+            addTo(acc, t);
+        }
+    }
+
+    // The same for sign * coef * 10^e without building a Dec: the path for
+    // plain doubles, whose shortest form has at most 17 digits.
+    void add(uint64_t coef, int64_t e, bool negative) {
+        if (!coef) return;
+        if (!any) { exp = e; any = true; }
+        if (e < exp) {
+            mulPow10(pos, exp - e);
+            mulPow10(neg, exp - e);
+            exp = e;
+        }
+        for (int64_t k = e - exp; k > 0; k--) {
+            if (coef > UINT64_MAX / 10) {
+                Dec d;
+                d.mag = fromU64(coef);
+                d.exp = exp + k;
+                d.neg = negative;
+                add(d);
+                return;
+            }
+            coef *= 10;
+        }
+        Limbs& acc = negative ? neg : pos;
+        size_t i = 0;
+        for (uint64_t carry = coef; carry; i++) {
+            if (i == acc.size()) acc.push_back(0);
+            carry += acc[i];
+            acc[i] = static_cast<uint32_t>(carry % kBase);
+            carry /= kBase;
+        }
+    }
+
+    Dec value() const {
+        Dec p, n;
+        p.mag = pos; p.exp = exp;
+        n.mag = neg; n.exp = exp; n.neg = !neg.empty();
+        return addDec(p, n);
+    }
+
+    void reset() { pos.clear(); neg.clear(); exp = 0; any = false; }
+
+private:
+    Limbs pos, neg;
+    int64_t exp = 0;
+    bool any = false;
+};
+
+// ---------- JS boundary ----------
+
+// x (finite) as sign * coef * 10^exp using its shortest round-trip digits.
+static void splitDouble(double x, uint64_t& coef, int64_t& exp, bool& neg) {
+    char buf[32];
+    auto res = std::to_chars(buf, buf + sizeof buf, x, std::chars_format::scientific);
+    const char* p = buf;
+    neg = *p == '-';
+    if (neg) p++;
+    coef = 0;
+    int digits = 0;
+    for (; p < res.ptr && *p != 'e'; p++) {
+        if (*p == '.') continue;
+        coef = coef * 10 + static_cast<uint64_t>(*p - '0');
+        digits++;
+    }
+    int e = 0;
+    std::from_chars(p + 1 + (p[1] == '+'), res.ptr, e);
+    exp = e - (digits - 1);
+}
+
+static Dec fromJS(const Napi::Value& v) {
+    if (v.IsNumber()) {
+        double x = v.As<Napi::Number>().DoubleValue();
+        char buf[32];
+        auto res = std::to_chars(buf, buf + sizeof buf, x);
+        if (!std::isfinite(x)) throw std::runtime_error("Invalid number: " + std::string(buf, res.ptr));
+        return parse(std::string_view(buf, static_cast<size_t>(res.ptr - buf)));
+    }
+    if (v.IsString()) return parse(v.As<Napi::String>().Utf8Value());
+    if (v.IsBigInt() || v.IsObject()) return parse(v.ToString().Utf8Value());
+    throw std::runtime_error("Invalid number");
+}
+
+static int64_t intArg(const Napi::CallbackInfo& info, size_t i, int64_t def) {
+    return info.Length() > i && info[i].IsNumber() ? info[i].As<Napi::Number>().Int64Value() : def;
+}
+
+// Rounding mode argument, as Big.roundDown (0) .. Big.roundUp (3); default half-up.
+static int rmArg(const Napi::CallbackInfo& info, size_t i) {
+    int64_t rm = intArg(info, i, 1);
+    if (rm < 0 || rm > 3) throw std::runtime_error("Invalid rounding mode");
+    return static_cast<int>(rm);
+}
+
+template <typename F>
+static Napi::Value guard(const Napi::CallbackInfo& info, F f) {
+    try {
+        return f();
+    } catch (const std::exception& e) {
+        Napi::Error::New(info.Env(), e.what()).ThrowAsJavaScriptException();
+        return info.Env().Undefined();
+    }
+}
+
+static Napi::Value str(Napi::Env env, const Dec& d) { return Napi::String::New(env, compact(d)); }
+
+// add(a, b) / sub(a, b) / mul(a, b) -> exact compact string
+static Napi::Value Add(const Napi::CallbackInfo& info) {
+    return guard(info, [&] { return str(info.Env(), addDec(fromJS(info[0]), fromJS(info[1]))); });
+}
+static Napi::Value Sub(const Napi::CallbackInfo& info) {
+    return guard(info, [&] { return str(info.Env(), addDec(fromJS(info[0]), fromJS(info[1]), true)); });
+}
+static Napi::Value Mul(const Napi::CallbackInfo& info) {
+    return guard(info, [&] { return str(info.Env(), mulDec(fromJS(info[0]), fromJS(info[1]))); });
+}
+// div(a, b, dp = 20, rm = 1)
+static Napi::Value Div(const Napi::CallbackInfo& info) {
+    return guard(info, [&] {
+        return str(info.Env(), divDec(fromJS(info[0]), fromJS(info[1]), intArg(info, 2, 20), rmArg(info, 3)));
+    });
+}
+static Napi::Value Mod(const Napi::CallbackInfo& info) {
+    return guard(info, [&] { return str(info.Env(), modDec(fromJS(info[0]), fromJS(info[1]))); });
+}
+// sqrt(a, dp = 20, rm = 1)
+static Napi::Value Sqrt(const Napi::CallbackInfo& info) {
+    return guard(info, [&] {
+        return str(info.Env(), sqrtDec(fromJS(info[0]), intArg(info, 1, 20), rmArg(info, 2)));
+    });
+}
+// pow(a, n, dp = 20, rm = 1); dp/rm only matter for negative n
+static Napi::Value Pow(const Napi::CallbackInfo& info) {
+    return guard(info, [&] {
+        return str(info.Env(), powDec(fromJS(info[0]), intArg(info, 1, 1), intArg(info, 2, 20), rmArg(info, 3)));
+    });
+}
+// round(a, dp = 0, rm = 1)
+static Napi::Value Round(const Napi::CallbackInfo& info) {
+    return guard(info, [&] {
+        return str(info.Env(), roundTo(fromJS(info[0]), intArg(info, 1, 0), rmArg(info, 2)));
+    });
+}
+// toFixed(a, dp?, rm = 1) -> plain notation, padded to dp places
+static Napi::Value ToFixed(const Napi::CallbackInfo& info) {
+    return guard(info, [&] {
+        Dec d = fromJS(info[0]);
+        int64_t dp = intArg(info, 1, -1);
+        if (dp >= 0) d = roundTo(d, dp, rmArg(info, 2));
+        return Napi::String::New(info.Env(), plain(d, dp));
+    });
+}
+static Napi::Value Cmp(const Napi::CallbackInfo& info) {
+    return guard(info, [&] { return Napi::Number::New(info.Env(), cmpDec(fromJS(info[0]), fromJS(info[1]))); });
+}
+
+static void addNumber(Sum& s, double x, bool subtract) {
+    if (!std::isfinite(x)) throw std::runtime_error("Invalid number in array");
+    uint64_t coef;
+    int64_t exp;
+    bool neg;
+    splitDouble(x, coef, exp, neg);
+    s.add(coef, exp, neg != subtract);
+}
+
+// Adds every element of an Array (numbers, strings, bigints, Big) or a
+// Float64Array into s.
+static void addAll(Sum& s, const Napi::Value& v, bool subtract = false) {
+    if (v.IsTypedArray() && v.As<Napi::TypedArray>().TypedArrayType() == napi_float64_array) {
+        Napi::Float64Array a = v.As<Napi::Float64Array>();
+        const double* x = a.Data();
+        for (size_t i = 0; i < a.ElementLength(); i++) addNumber(s, x[i], subtract);
+        return;
+    }
+    if (v.IsNumber()) { addNumber(s, v.As<Napi::Number>().DoubleValue(), subtract); return; }
+    if (!v.IsArray()) { s.add(fromJS(v), subtract); return; }
+    Napi::Array a = v.As<Napi::Array>();
+    for (uint32_t i = 0; i < a.Length(); i++) {
+        Napi::Value e = a.Get(i);
+        if (e.IsNumber()) addNumber(s, e.As<Napi::Number>().DoubleValue(), subtract);
+        else s.add(fromJS(e), subtract);
+    }
+}
+
+// sum(values, dp?, rm = 1) -> exact total (rounded when dp is given)
+static Napi::Value SumAll(const Napi::CallbackInfo& info) {
+    return guard(info, [&] {
+        Sum s;
+        addAll(s, info[0]);
+        Dec d = s.value();
+        if (info.Length() > 1 && info[1].IsNumber()) d = roundTo(d, intArg(info, 1, 0), rmArg(info, 2));
+        return str(info.Env(), d);
+    });
+}
+
+// new Accumulator(): add(x | values) / sub(x | values) / value(dp?, rm?) /
+// reset(). The running total lives here, so a loop over millions of values
+// creates no intermediate JS objects.
+class Accumulator : public Napi::ObjectWrap<Accumulator> {
+public:
+    static Napi::Function Define(Napi::Env env) {
+        return DefineClass(env, "Accumulator", {
+            InstanceMethod("add", &Accumulator::Add),
+            InstanceMethod("sub", &Accumulator::Sub),
+            InstanceMethod("value", &Accumulator::Value),
+            InstanceMethod("reset", &Accumulator::Reset),
+        });
+    }
+
+    Accumulator(const Napi::CallbackInfo& info) : Napi::ObjectWrap<Accumulator>(info) {}
+
+private:
+    Sum sum;
+
+    Napi::Value Add(const Napi::CallbackInfo& info) {
+        return guard(info, [&] { addAll(sum, info[0]); return info.This(); });
+    }
+    Napi::Value Sub(const Napi::CallbackInfo& info) {
+        return guard(info, [&] { addAll(sum, info[0], true); return info.This(); });
+    }
+    Napi::Value Value(const Napi::CallbackInfo& info) {
+        return guard(info, [&] {
+            Dec d = sum.value();
+            if (info.Length() > 0 && info[0].IsNumber()) d = roundTo(d, intArg(info, 0, 0), rmArg(info, 1));
+            return str(info.Env(), d);
+        });
+    }
+    Napi::Value Reset(const Napi::CallbackInfo& info) {
+        sum.reset();
+        return info.This();
+    }
+};
+
+static uint32_t baseArg(const Napi::CallbackInfo& info, size_t i) {
+    int64_t b = intArg(info, i, 0);
+    if (b < 2 || b > 0xffffffffLL) throw std::runtime_error("Base must be between 2 and 2^32 - 1");
+    return static_cast<uint32_t>(b);
+}
+
+// toBase(integer, base) -> Uint32Array of digit values, least significant first
+static Napi::Value ToBase(const Napi::CallbackInfo& info) {
+    return guard(info, [&] {
+        uint32_t base = baseArg(info, 1);
+        Dec d = fromJS(info[0]);
+        if (d.neg) throw std::runtime_error("toBase expects a non-negative integer");
+        if (d.exp < 0) {
+            Rest rest = dropDigits(d.mag, -d.exp);
+            if (rest != ZERO) throw std::runtime_error("toBase expects a non-negative integer");
+        } else {
+            mulPow10(d.mag, d.exp);
+        }
+        std::vector<uint32_t> digits = toBase(d.mag, base);
+        Napi::Uint32Array out = Napi::Uint32Array::New(info.Env(), digits.size());
+        std::copy(digits.begin(), digits.end(), out.Data());
+        return out;
+    });
+}
+
+// fromBase(digits (least significant first), base) -> decimal integer string
+static Napi::Value FromBase(const Napi::CallbackInfo& info) {
+    return guard(info, [&] {
+        uint32_t base = baseArg(info, 1);
+        std::vector<uint32_t> digits;
+        if (info[0].IsTypedArray() && info[0].As<Napi::TypedArray>().TypedArrayType() == napi_uint32_array) {
+            Napi::Uint32Array a = info[0].As<Napi::Uint32Array>();
+            digits.assign(a.Data(), a.Data() + a.ElementLength());
+        } else if (info[0].IsArray()) {
+            Napi::Array a = info[0].As<Napi::Array>();
+            digits.reserve(a.Length());
+            for (uint32_t i = 0; i < a.Length(); i++) digits.push_back(a.Get(i).As<Napi::Number>().Uint32Value());
+        } else {
+            throw std::runtime_error("fromBase expects an array of digits");
+        }
+        for (uint32_t x : digits) if (x >= base) throw std::runtime_error("Digit out of range for base");
+        Dec d;
+        d.mag = fromBase(digits, base);
+        std::string out;
+        appendCoefficient(out, d.mag);
+        return Napi::String::New(info.Env(), out);
+    });
+}
+
+Napi::Object Init(Napi::Env env, Napi::Object exports) {
+    exports.Set("add", Napi::Function::New(env, Add));
+    exports.Set("sub", Napi::Function::New(env, Sub));
+    exports.Set("mul", Napi::Function::New(env, Mul));
+    exports.Set("div", Napi::Function::New(env, Div));
+    exports.Set("mod", Napi::Function::New(env, Mod));
+    exports.Set("sqrt", Napi::Function::New(env, Sqrt));
+    exports.Set("pow", Napi::Function::New(env, Pow));
+    exports.Set("round", Napi::Function::New(env, Round));
+    exports.Set("toFixed", Napi::Function::New(env, ToFixed));
+    exports.Set("cmp", Napi::Function::New(env, Cmp));
+    exports.Set("sum", Napi::Function::New(env, SumAll));
+    exports.Set("Accumulator", Accumulator::Define(env));
+    exports.Set("toBase", Napi::Function::New(env, ToBase));
+    exports.Set("fromBase", Napi::Function::New(env, FromBase));
+    return exports;
+}
+
+NODE_API_MODULE(decimal, Init)
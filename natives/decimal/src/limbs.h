@@ -0,0 +1,543 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Unsigned integers as little-endian base-1e9 limbs, shared with the pi
+// addon: schoolbook / Karatsuba / three-prime NTT multiplication, Newton
+// reciprocal, exact divmod, integer square root and conversion to and from
+// an arbitrary radix by divide and conquer. Functions are inline so an
+// addon that uses only some of them compiles without unused warnings.
+
+using Limbs = std::vector<uint32_t>;
+
+static const uint32_t kBase = 1000000000;
+static const int kBaseDigits = 9;
+
+static const size_t kKaratsubaMin = 40;    // smaller operand, in limbs
+static const size_t kNttMin = 600;
+static const size_t kNttMaxLog = 23;       // 998244353 = 119 * 2^23 + 1
+
+// ---------- magnitude helpers ----------
+
+static inline void trim(Limbs& a) {
+    while (!a.empty() && a.back() == 0) a.pop_back();
+}
+
+static inline int cmp(const Limbs& a, const Limbs& b) {
+    if (a.size() != b.size()) return a.size() < b.size() ? -1 : 1;
+    for (size_t i = a.size(); i-- > 0;) {
+        if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+static inline Limbs fromU64(uint64_t v) {
+    Limbs r;
+    while (v) { r.push_back(static_cast<uint32_t>(v % kBase)); v /= kBase; }
+    return r;
+}
+
+static inline void addTo(Limbs& a, const Limbs& b, size_t shift = 0) {
+    if (a.size() < b.size() + shift) a.resize(b.size() + shift, 0);
+    uint32_t carry = 0;
+    size_t i = 0;
+    for (; i < b.size() || carry; i++) {
+        if (shift + i == a.size()) a.push_back(0);
+        uint32_t s = a[shift + i] + carry + (i < b.size() ? b[i] : 0);
+        carry = s >= kBase;
+        a[shift + i] = carry ? s - kBase : s;
+    }
+}
+
+// a -= b, a >= b
+static inline void subFrom(Limbs& a, const Limbs& b) {
+    int64_t borrow = 0;
+    for (size_t i = 0; i < b.size() || borrow; i++) {
+        int64_t s = static_cast<int64_t>(a[i]) - borrow - (i < b.size() ? b[i] : 0);
+        borrow = s < 0;
+        a[i] = static_cast<uint32_t>(borrow ? s + kBase : s);
+    }
+    trim(a);
+}
+
+static inline Limbs add(const Limbs& a, const Limbs& b) { Limbs r = a; addTo(r, b); return r; }
+static inline Limbs sub(const Limbs& a, const Limbs& b) { Limbs r = a; subFrom(r, b); return r; }
+
+static inline void mulSmall(Limbs& a, uint32_t m) {
+    uint64_t carry = 0;
+    for (auto& x : a) {
+        uint64_t p = static_cast<uint64_t>(x) * m + carry;
+        x = static_cast<uint32_t>(p % kBase);
+        carry = p / kBase;
+    }
+    while (carry) { a.push_back(static_cast<uint32_t>(carry % kBase)); carry /= kBase; }
+    trim(a);
+}
+
+static inline uint32_t divSmall(Limbs& a, uint32_t d) {
+    uint64_t rem = 0;
+    for (size_t i = a.size(); i-- > 0;) {
+        uint64_t cur = a[i] + rem * kBase;
+        a[i] = static_cast<uint32_t>(cur / d);
+        rem = cur % d;
+    }
+    trim(a);
+    return static_cast<uint32_t>(rem);
+}
+
+// a * B^k and floor(a / B^k)
+static inline Limbs shl(const Limbs& a, size_t k) {
+    if (a.empty()) return a;
+    Limbs r(k, 0);
+    r.insert(r.end(), a.begin(), a.end());
+    return r;
+}
+static inline Limbs shr(const Limbs& a, size_t k) {
+    return k >= a.size() ? Limbs() : Limbs(a.begin() + k, a.end());
+}
+
+// ---------- multiplication ----------
+
+static inline void mulSchool(const uint32_t* a, size_t n, const uint32_t* b, size_t m, uint32_t* out) {
+    std::fill(out, out + n + m, 0);
+    for (size_t i = 0; i < n; i++) {
+        uint64_t carry = 0, x = a[i];
+        if (!x) continue;
+        for (size_t j = 0; j < m; j++) {
+            uint64_t s = x * b[j] + out[i + j] + carry;
+            out[i + j] = static_cast<uint32_t>(s % kBase);
+            carry = s / kBase;
+        }
+        out[i + m] = static_cast<uint32_t>(carry);
+    }
+}
+
+// Residues stay in [0, P); only the twiddle factors are kept in Montgomery
+// form (x * 2^32 mod P), so one Montgomery product by a twiddle gives the
+// plain product. The forward transform is decimation in frequency and the
+// inverse decimation in time, which leaves the spectrum in bit-reversed
+// order in between and needs no reordering pass.
+template <uint32_t P>
+struct Ntt {
+    static constexpr uint32_t negInv() {
+        uint32_t inv = P;                       // P * P == 1 mod 8
+        for (int i = 0; i < 5; i++) inv *= 2 - P * inv;
+        return 0u - inv;
+    }
+    static constexpr uint32_t kNegInv = negInv();
+    static constexpr uint64_t kR2 = static_cast<uint64_t>((static_cast<unsigned __int128>(1) << 64) % P);
+
+    // Branch-free: on transform data the compares are coin flips. P < 2^30,
+    // so x - P for x < 2P is negative exactly when x < P.
+    static uint32_t reduce(uint32_t x) {
+        x -= P;
+        return x + (static_cast<uint32_t>(static_cast<int32_t>(x) >> 31) & P);
+    }
+    static uint32_t addMod(uint32_t a, uint32_t b) { return reduce(a + b); }
+    static uint32_t subMod(uint32_t a, uint32_t b) { return reduce(a - b + P); }
+    static uint32_t redc(uint64_t t) {
+        uint32_t m = static_cast<uint32_t>(t) * kNegInv;
+        return reduce(static_cast<uint32_t>((t + static_cast<uint64_t>(m) * P) >> 32));
+    }
+    static uint32_t mont(uint32_t x) { return redc(x * kR2); }
+
+    static uint32_t pow(uint64_t b, uint64_t e) {
+        uint64_t r = 1;
+        for (b %= P; e; e >>= 1, b = b * b % P) if (e & 1) r = r * b % P;
+        return static_cast<uint32_t>(r);
+    }
+
+    // Per-stage tables laid end to end: the butterflies of a stage with
+    // half-length h use w[h + k] = root_2h^k (Montgomery form), k < h. That
+    // does not depend on the transform length, so one table serves every
+    // length up to its size; it is shared between threads and only grows.
+    // 3 is a primitive root of all three primes.
+    using Table = std::shared_ptr<const std::vector<uint32_t>>;
+
+    static Table twiddles(size_t n, bool inverse) {
+        static std::mutex lock;
+        static Table cache[2];
+        std::lock_guard<std::mutex> hold(lock);
+        Table& t = cache[inverse];
+        if (t && t->size() >= n) return t;
+        auto w = std::make_shared<std::vector<uint32_t>>(n);
+        for (size_t h = 1; h < n; h <<= 1) {
+            uint64_t root = pow(3, (P - 1) / (2 * h));
+            if (inverse) root = pow(root, P - 2);
+            uint64_t x = 1;
+            for (size_t k = 0; k < h; k++, x = x * root % P) (*w)[h + k] = mont(static_cast<uint32_t>(x));
+        }
+        t = w;
+        return t;
+    }
+
+    static void forward(uint32_t* a, size_t n, const std::vector<uint32_t>& w) {
+        for (size_t half = n / 2; half >= 1; half >>= 1) {
+            const uint32_t* wh = w.data() + half;
+            for (size_t i = 0; i < n; i += 2 * half) {
+                for (size_t k = 0; k < half; k++) {
+                    uint32_t u = a[i + k], v = a[i + k + half];
+                    a[i + k] = addMod(u, v);
+                    a[i + k + half] = redc(static_cast<uint64_t>(subMod(u, v)) * wh[k]);
+                }
+            }
+        }
+    }
+
+    static void inverse(uint32_t* a, size_t n, const std::vector<uint32_t>& w) {
+        for (size_t half = 1; half < n; half <<= 1) {
+            const uint32_t* wh = w.data() + half;
+            for (size_t i = 0; i < n; i += 2 * half) {
+                for (size_t k = 0; k < half; k++) {
+                    uint32_t u = a[i + k], v = redc(static_cast<uint64_t>(a[i + k + half]) * wh[k]);
+                    a[i + k] = addMod(u, v);
+                    a[i + k + half] = subMod(u, v);
+                }
+            }
+        }
+        uint32_t scale = mont(pow(n, P - 2));
+        for (size_t i = 0; i < n; i++) a[i] = redc(static_cast<uint64_t>(a[i]) * scale);
+    }
+
+    // a * b mod P, cyclic of length size; b == a squares.
+    static std::vector<uint32_t> convolve(const uint32_t* a, size_t n, const uint32_t* b, size_t m, size_t size) {
+        Table w = twiddles(size, false);
+        std::vector<uint32_t> fa(size, 0), fb;
+        for (size_t i = 0; i < n; i++) fa[i] = a[i] % P;
+        forward(fa.data(), size, *w);
+        const std::vector<uint32_t>* other = &fa;
+        if (a != b || n != m) {
+            fb.assign(size, 0);
+            for (size_t i = 0; i < m; i++) fb[i] = b[i] % P;
+            forward(fb.data(), size, *w);
+            other = &fb;
+        }
+        for (size_t i = 0; i < size; i++) fa[i] = static_cast<uint32_t>(static_cast<uint64_t>(fa[i]) * (*other)[i] % P);
+        inverse(fa.data(), size, *twiddles(size, true));
+        return fa;
+    }
+};
+
+static const uint32_t kP1 = 998244353, kP2 = 167772161, kP3 = 469762049;
+
+// Each convolution term is below min(n, m) * 1e18, well under P1*P2*P3
+// (~7.8e25) for any length the transform supports.
+static inline void mulNtt(const uint32_t* a, size_t n, const uint32_t* b, size_t m, uint32_t* out) {
+    size_t size = 1;
+    while (size < n + m) size <<= 1;
+    std::vector<uint32_t> r1 = Ntt<kP1>::convolve(a, n, b, m, size);
+    std::vector<uint32_t> r2 = Ntt<kP2>::convolve(a, n, b, m, size);
+    std::vector<uint32_t> r3 = Ntt<kP3>::convolve(a, n, b, m, size);
+
+    // Garner: x = x1 + x2 P1 + x3 P1 P2. With P1 P2 = c1 B + c0 and
+    // x1 + x2 P1 = d1 B + d0 (both below 2e17) the x3 and d terms spread over
+    // two 64-bit accumulators per limb, and one carry pass finishes.
+    const uint64_t inv1 = Ntt<kP2>::pow(kP1, kP2 - 2);                                      // 1/P1 mod P2
+    const uint64_t inv12 = Ntt<kP3>::pow(static_cast<uint64_t>(kP1) * kP2 % kP3, kP3 - 2);  // 1/(P1 P2) mod P3
+    const uint64_t p12 = static_cast<uint64_t>(kP1) * kP2;
+    const uint64_t c0 = p12 % kBase, c1 = p12 / kBase;
+    std::vector<uint64_t> acc(n + m + 1, 0);
+    for (size_t i = 0; i < n + m; i++) {
+        uint64_t x1 = r1[i];
+        uint64_t x2 = (r2[i] + kP2 - x1 % kP2) % kP2 * inv1 % kP2;
+        uint64_t v12 = x1 + x2 * kP1;
+        uint64_t x3 = (r3[i] + kP3 - v12 % kP3) % kP3 * inv12 % kP3;
+        acc[i] += x3 * c0 + v12 % kBase;
+        acc[i + 1] += x3 * c1 + v12 / kBase;
+    }
+    uint64_t carry = 0;
+    for (size_t i = 0; i < n + m; i++) {
+        uint64_t v = acc[i] + carry;
+        out[i] = static_cast<uint32_t>(v % kBase);
+        carry = v / kBase;
+    }
+}
+
+static inline void mulInto(const uint32_t* a, size_t n, const uint32_t* b, size_t m, uint32_t* out);
+
+// n >= m >= kKaratsubaMin, and m > n / 2 so both halves of b are non-empty.
+static inline void mulKaratsuba(const uint32_t* a, size_t n, const uint32_t* b, size_t m, uint32_t* out) {
+    size_t h = n / 2;
+    Limbs a0(a, a + h), a1(a + h, a + n), b0(b, b + h), b1(b + h, b + m);
+    trim(a0); trim(b0);
+    Limbs z0(a0.size() + b0.size()), z2(a1.size() + b1.size());
+    mulInto(a0.data(), a0.size(), b0.data(), b0.size(), z0.data());
+    mulInto(a1.data(), a1.size(), b1.data(), b1.size(), z2.data());
+    Limbs sa = add(a0, a1), sb = add(b0, b1);
+    Limbs z1(sa.size() + sb.size());
+    mulInto(sa.data(), sa.size(), sb.data(), sb.size(), z1.data());
+    trim(z0); trim(z1); trim(z2);
+    subFrom(z1, z0);
+    subFrom(z1, z2);
+
+    Limbs r = z0;
+    addTo(r, z1, h);
+    addTo(r, z2, 2 * h);
+    std::fill(out, out + n + m, 0);
+    std::copy(r.begin(), r.begin() + std::min(r.size(), n + m), out);
+}
+
+// out[0 .. n+m) = a * b; out must not alias the inputs.
+static inline void mulInto(const uint32_t* a, size_t n, const uint32_t* b, size_t m, uint32_t* out) {
+    if (n < m) { std::swap(a, b); std::swap(n, m); }
+    if (m == 0) { std::fill(out, out + n, 0); return; }
+    if (m < kKaratsubaMin) { mulSchool(a, n, b, m, out); return; }
+    if (m >= kNttMin && n + m <= (size_t(1) << kNttMaxLog)) { mulNtt(a, n, b, m, out); return; }
+    if (m > n / 2) { mulKaratsuba(a, n, b, m, out); return; }
+    // unbalanced: b times m-limb slices of a
+    std::fill(out, out + n + m, 0);
+    Limbs part(2 * m);
+    for (size_t i = 0; i < n; i += m) {
+        size_t len = std::min(m, n - i);
+        mulInto(a + i, len, b, m, part.data());
+        Limbs p(part.begin(), part.begin() + len + m);
+        trim(p);
+        Limbs acc(out + i, out + n + m);
+        addTo(acc, p);
+        std::copy(acc.begin(), acc.begin() + (n + m - i), out + i);
+    }
+}
+
+static inline Limbs mul(const Limbs& a, const Limbs& b) {
+    if (a.empty() || b.empty()) return Limbs();
+    Limbs r(a.size() + b.size());
+    mulInto(a.data(), a.size(), b.data(), b.size(), r.data());
+    trim(r);
+    return r;
+}
+
+// ---------- division and square root ----------
+
+// B^k as limbs
+static inline Limbs power(size_t k) {
+    Limbs r(k + 1, 0);
+    r[k] = 1;
+    return r;
+}
+
+// Top k limbs of d (zero-padded when d is shorter).
+static inline Limbs top(const Limbs& d, size_t k) {
+    return d.size() >= k ? shr(d, d.size() - k) : shl(d, k - d.size());
+}
+
+// R ~ B^(2k) / top(d, k), within a few units; Newton with doubling precision.
+static inline Limbs reciprocal(const Limbs& d, size_t k) {
+    if (k <= 2) {
+        Limbs t = top(d, 2);
+        uint64_t v = t[0] + static_cast<uint64_t>(t[1]) * kBase;
+        unsigned __int128 r = static_cast<unsigned __int128>(1000000000000000000ULL) * 1000000000000000000ULL / v;
+        Limbs out;
+        while (r) { out.push_back(static_cast<uint32_t>(r % kBase)); r /= kBase; }
+        return k == 2 ? out : shr(out, 2);
+    }
+    size_t h = k / 2 + 1;
+    Limbs r = shl(reciprocal(d, h), k - h);
+    Limbs dk = top(d, k);
+    Limbs pk = power(2 * k);
+    Limbs dr = mul(dk, r);
+    // r += r * (B^2k - dk r) / B^2k
+    if (cmp(dr, pk) <= 0) {
+        Limbs e = sub(pk, dr);
+        addTo(r, shr(mul(r, e), 2 * k));
+    } else {
+        Limbs e = sub(dr, pk);
+        Limbs c = shr(mul(r, e), 2 * k);
+        addTo(c, Limbs{1});
+        subFrom(r, c);
+    }
+    return r;
+}
+
+// Knuth's algorithm D in base 1e9: n >= d, d has at least two limbs.
+static inline void divKnuth(const Limbs& n, const Limbs& d, Limbs& q, Limbs& r) {
+    const uint64_t B = kBase;
+    uint32_t f = static_cast<uint32_t>(B / (static_cast<uint64_t>(d.back()) + 1));  // top limb of v >= B/2
+    Limbs u = n, v = d;
+    mulSmall(u, f);
+    mulSmall(v, f);
+    size_t m = v.size();
+    u.resize(n.size() + 1, 0);
+    q.assign(n.size() - m + 1, 0);
+    for (size_t j = n.size() - m + 1; j-- > 0;) {
+        uint64_t num = u[j + m] * B + u[j + m - 1];
+        uint64_t qhat = num / v[m - 1], rhat = num % v[m - 1];
+        while (qhat >= B || qhat * v[m - 2] > rhat * B + u[j + m - 2]) {
+            qhat--;
+            rhat += v[m - 1];
+            if (rhat >= B) break;
+        }
+        uint64_t carry = 0;
+        int64_t borrow = 0;
+        for (size_t i = 0; i < m; i++) {
+            uint64_t p = qhat * v[i] + carry;
+            carry = p / B;
+            int64_t t = static_cast<int64_t>(u[i + j]) - borrow - static_cast<int64_t>(p % B);
+            borrow = t < 0;
+            u[i + j] = static_cast<uint32_t>(borrow ? t + static_cast<int64_t>(B) : t);
+        }
+        int64_t top = static_cast<int64_t>(u[j + m]) - borrow - static_cast<int64_t>(carry);
+        if (top < 0) {  // qhat was one too big: add v back
+            qhat--;
+            uint32_t c = 0;
+            for (size_t i = 0; i < m; i++) {
+                uint32_t s = u[i + j] + v[i] + c;
+                c = s >= B;
+                u[i + j] = c ? s - kBase : s;
+            }
+            top += c;
+        }
+        u[j + m] = static_cast<uint32_t>(top);
+        q[j] = static_cast<uint32_t>(qhat);
+    }
+    u.resize(m);
+    trim(u);
+    divSmall(u, f);
+    r = std::move(u);
+    trim(q);
+}
+
+static const size_t kNewtonDivMin = 80;   // divisor and quotient limbs
+
+// q = floor(n / d), r = n - q d; d non-zero. Long division while either the
+// divisor or the quotient is short, Newton's reciprocal above that.
+static inline void divmod(const Limbs& n, const Limbs& d, Limbs& q, Limbs& r) {
+    if (cmp(n, d) < 0) { q.clear(); r = n; return; }
+    if (d.size() == 1) {
+        q = n;
+        uint32_t rem = divSmall(q, d[0]);
+        r = rem ? Limbs{rem} : Limbs();
+        return;
+    }
+    if (d.size() < kNewtonDivMin || n.size() - d.size() < kNewtonDivMin) { divKnuth(n, d, q, r); return; }
+    size_t k = n.size() - d.size() + 2;
+    // reciprocal(d, k) ~ B^(k + |d|) / d either way top() pads or cuts d
+    q = shr(mul(n, reciprocal(d, k)), k + d.size());
+    Limbs qd = mul(q, d);
+    while (cmp(qd, n) > 0) { subFrom(q, Limbs{1}); subFrom(qd, d); }
+    r = sub(n, qd);
+    while (cmp(r, d) >= 0) { addTo(q, Limbs{1}); subFrom(r, d); }
+}
+
+// floor(sqrt(n)). Above a few limbs: the root of the top half, shifted,
+// then one Newton step at full size, which lands at or just above the
+// answer (the step never undershoots), and a final step down.
+static inline Limbs isqrt(const Limbs& n) {
+    if (n.size() <= 2) {
+        uint64_t v = n.empty() ? 0 : n[0] + (n.size() > 1 ? static_cast<uint64_t>(n[1]) * kBase : 0);
+        uint64_t s = static_cast<uint64_t>(std::sqrt(static_cast<long double>(v)));
+        while (s * s > v) s--;
+        while ((s + 1) * (s + 1) <= v) s++;
+        return fromU64(s);
+    }
+    Limbs q, r;
+    if (n.size() < 12) {
+        Limbs x = power((n.size() + 1) / 2);  // above the root
+        for (;;) {
+            divmod(n, x, q, r);
+            Limbs y = add(x, q);
+            divSmall(y, 2);
+            if (cmp(y, x) >= 0) return x;
+            x = std::move(y);
+        }
+    }
+    size_t k = n.size() / 4 - 2;
+    Limbs x = shl(isqrt(shr(n, 2 * k)), k);
+    divmod(n, x, q, r);
+    x = add(x, q);
+    divSmall(x, 2);
+    while (cmp(mul(x, x), n) > 0) subFrom(x, Limbs{1});
+    return x;
+}
+
+// ---------- radix conversion ----------
+
+// Digits (least significant first) of a number in base `base` <= 2^32 - 1
+// and back. Both split the number in halves around base^(t 2^i), where
+// base^t is the largest power that fits a limb divisor, so the cost is
+// O(M(n) log n) instead of quadratic.
+struct Radix {
+    uint32_t base;
+    uint32_t chunk;           // base^t
+    unsigned t;               // digits per chunk
+    std::deque<Limbs> pow;    // pow[i] = chunk^(2^i); a deque keeps references valid
+
+    explicit Radix(uint32_t b) : base(b), chunk(b), t(1) {
+        while (static_cast<uint64_t>(chunk) * base <= 0xffffffffULL) { chunk *= base; t++; }
+        pow.push_back(fromU64(chunk));
+    }
+    const Limbs& power(size_t i) {
+        while (pow.size() <= i) pow.push_back(mul(pow.back(), pow.back()));
+        return pow[i];
+    }
+};
+
+// Appends the digits of x; with width > 0 exactly that many (zero padded).
+static inline void toRadix(Limbs x, Radix& rx, size_t level, size_t width, std::vector<uint32_t>& out) {
+    if (level == 0 || x.size() <= 32) {
+        size_t start = out.size();
+        while (!x.empty()) {
+            uint32_t c = divSmall(x, rx.chunk);
+            for (unsigned i = 0; i < rx.t; i++) { out.push_back(c % rx.base); c /= rx.base; }
+        }
+        if (width) out.resize(start + width, 0);  // pads, or drops zeros past the width
+        else while (out.size() > start && out.back() == 0) out.pop_back();
+        return;
+    }
+    size_t i = level - 1;
+    const Limbs& p = rx.power(i);
+    size_t half = static_cast<size_t>(rx.t) << i;
+    if (cmp(x, p) < 0) {
+        toRadix(std::move(x), rx, i, width, out);
+        return;
+    }
+    Limbs q, r;
+    divmod(x, p, q, r);
+    x = Limbs();
+    toRadix(std::move(r), rx, i, half, out);
+    toRadix(std::move(q), rx, i, width ? width - half : 0, out);
+}
+
+static inline std::vector<uint32_t> toBase(const Limbs& x, uint32_t base) {
+    Radix rx(base);
+    size_t level = 0;
+    while (rx.power(level).size() * 2 <= x.size() + 1) level++;  // x < pow[level]^2
+    std::vector<uint32_t> out;
+    toRadix(x, rx, level + 1, 0, out);
+    if (out.empty()) out.push_back(0);
+    return out;
+}
+
+// Value of d[0 .. n) (least significant first).
+static inline Limbs fromRadix(const uint32_t* d, size_t n, Radix& rx) {
+    if (n <= static_cast<size_t>(rx.t) * 64) {
+        Limbs x;
+        size_t top = n % rx.t ? n % rx.t : rx.t;
+        for (size_t end = n; end > 0; end -= top, top = rx.t) {
+            uint64_t c = 0;
+            for (size_t i = end; i-- > end - top;) c = c * rx.base + d[i];
+            uint32_t scale = 1;
+            for (size_t i = 0; i < top; i++) scale *= rx.base;
+            mulSmall(x, scale);
+            addTo(x, fromU64(c));
+        }
+        return x;
+    }
+    size_t i = 0;
+    while ((static_cast<size_t>(rx.t) << (i + 1)) < n) i++;
+    size_t half = static_cast<size_t>(rx.t) << i;
+    Limbs hi = mul(fromRadix(d + half, n - half, rx), rx.power(i));
+    addTo(hi, fromRadix(d, half, rx));
+    trim(hi);
+    return hi;
+}
+
+static inline Limbs fromBase(const std::vector<uint32_t>& digits, uint32_t base) {
+    Radix rx(base);
+    return fromRadix(digits.data(), digits.size(), rx);
+}
@@ -0,0 +1,82 @@
+// Throughput of each kernel in GB/s of input read, per instruction set and
+// against a plain JS loop, on an array that fits in cache and on one that
+// does not. Results are checked against the JS loops.
+// usage: node bench.js [elements] [float64|float32|int32|...]
+const K = require('./index.js');
+
+const n = Number(process.argv[2]) || 1e7;
+const kind = process.argv[3] || 'float64';
+const Typed = { int8: Int8Array, uint8: Uint8Array, int16: Int16Array, uint16: Uint16Array, int32: Int32Array, uint32: Uint32Array, float32: Float32Array, float64: Float64Array }[kind];
+if (!Typed) throw new Error(`Unknown kind: ${kind}`);
+let failed = false;
+
+function best(fn, bytes) {
+  const reps = Math.max(3, Math.min(1000, Math.ceil(2e8 / bytes)));
+  let ms = Infinity;
+  for (let r = 0; r < reps; r++) {
+    const t0 = process.hrtime.bigint();
+    fn();
+    ms = Math.min(ms, Number(process.hrtime.bigint() - t0) / 1e6);
+  }
+  return bytes / ms / 1e6;
+}
+
+const js = {
+  sum: (a) => { let s = 0; for (let i = 0; i < a.length; i++) s += a[i]; return s; },
+  min: (a) => { let m = Infinity; for (let i = 0; i < a.length; i++) if (a[i] < m) m = a[i]; return m; },
+  argmax: (a) => { let m = -Infinity, k = -1; for (let i = 0; i < a.length; i++) if (a[i] > m) { m = a[i]; k = i; } return k; },
+  variance: (a) => {
+    let s = 0;
+    for (let i = 0; i < a.length; i++) s += a[i];
+    const mean = s / a.length;
+    let q = 0;
+    for (let i = 0; i < a.length; i++) q += (a[i] - mean) ** 2;
+    return q / a.length;
+  },
+  dot: (a, b) => { let s = 0; for (let i = 0; i < a.length; i++) s += a[i] * b[i]; return s; },
+  prefixSum: (a, out) => { let s = 0; for (let i = 0; i < a.length; i++) out[i] = s += a[i]; return out; },
+};
+
+const kernels = {
+  sum: (a) => K.sum(a),
+  'sum kahan': (a) => K.sum(a, true),
+  min: (a) => K.min(a),
+  argmax: (a) => K.argmax(a),
+  variance: (a) => K.variance(a),
+  dot: (a, b) => K.dot(a, b),
+  prefixSum: (a, out) => K.prefixSum(a, out),
+  histogram: (a) => K.histogram(a, 64),
+};
+
+// bytes of input each kernel reads (variance reads the array twice)
+const reads = { variance: 2, dot: 2 };
+
+const agree = (x, y) => Math.abs(x - y) <= 1e-6 * Math.max(1, Math.abs(y));
+
+for (const len of [Math.min(n, 16384), n]) {
+  const a = new Typed(len), b = new Typed(len), out = new Float64Array(len);
+  for (let i = 0; i < len; i++) {
+    a[i] = Math.sin(i) * 100;
+    b[i] = Math.cos(i) * 100;
+  }
+  const bytes = len * Typed.BYTES_PER_ELEMENT;
+  console.log(`${kind} x ${len} (${(bytes / 1048576).toFixed(2)} MB), GB/s`);
+  const isas = [...K.isas];
+  console.log(`${'kernel'.padEnd(12)} ${'js'.padStart(7)} ${isas.map((s) => s.padStart(7)).join(' ')}`);
+  for (const name of Object.keys(kernels)) {
+    const base = js[name.split(' ')[0]];
+    const cells = [base ? best(() => base(a, name === 'dot' ? b : out), bytes * (reads[name] || 1)).toFixed(2) : '-'];
+    for (const isa of isas) {
+      K.setIsa(isa);
+      cells.push(best(() => kernels[name](a, name === 'dot' ? b : out), bytes * (reads[name] || 1)).toFixed(2));
+      if (base && name !== 'prefixSum') {
+        const got = kernels[name](a, b), want = base(a, b);
+        if (!agree(got, want)) { failed = true; console.log(`  ${isa} ${name}: ${got} != ${want}`); }
+      }
+    }
+    console.log(`${name.padEnd(12)} ${cells.map((c) => c.padStart(7)).join(' ')}`);
+  }
+  K.setIsa(isas[0]);
+}
+console.log(failed ? 'WRONG' : 'ok');
+process.exitCode = failed ? 1 : 0;
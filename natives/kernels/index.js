@@ -0,0 +1,3 @@
+const addon = require('bindings')('kernels');
+
+module.exports = addon
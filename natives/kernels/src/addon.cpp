@@ -0,0 +1,240 @@
+#include <napi.h>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "kernels.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+// Single-threaded SIMD reductions over typed arrays for nova's sum / min /
+// max / mean (core/nova-arrays.js). natives/parallel splits the same kind
+// of work across threads; these make each pass as cheap as the memory bus
+// allows. The widest kernel table this CPU supports is chosen at load.
+
+static bool cpuHasAvx2() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int r[4];
+    __cpuid(r, 0);
+    if (r[0] < 7) return false;
+    __cpuid(r, 1);
+    bool osxsave = r[2] & (1 << 27), avx = r[2] & (1 << 28);
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false;  // the OS saves ymm registers
+    __cpuidex(r, 7, 0);
+    return (r[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+
+// Tables this build and CPU can run, widest first.
+static std::vector<const Kernels*> available() {
+    std::vector<const Kernels*> out;
+    if (avx2Kernels() && cpuHasAvx2()) out.push_back(avx2Kernels());
+    if (sse2Kernels()) out.push_back(sse2Kernels());
+    out.push_back(scalarKernels());
+    return out;
+}
+
+static const Kernels* active = nullptr;
+
+struct View {
+    const void* data;
+    size_t length;
+    Elem elem;
+};
+
+static View viewOf(Napi::Value v) {
+    if (!v.IsTypedArray()) throw std::invalid_argument("Expected a typed array");
+    Napi::TypedArray ta = v.As<Napi::TypedArray>();
+    View view{ static_cast<uint8_t*>(ta.ArrayBuffer().Data()) + ta.ByteOffset(), ta.ElementLength(), Elem::F64 };
+    switch (ta.TypedArrayType()) {
+        case napi_int8_array: view.elem = Elem::I8; break;
+        case napi_uint8_array: case napi_uint8_clamped_array: view.elem = Elem::U8; break;
+        case napi_int16_array: view.elem = Elem::I16; break;
+        case napi_uint16_array: view.elem = Elem::U16; break;
+        case napi_int32_array: view.elem = Elem::I32; break;
+        case napi_uint32_array: view.elem = Elem::U32; break;
+        case napi_float32_array: view.elem = Elem::F32; break;
+        case napi_float64_array: view.elem = Elem::F64; break;
+        default: throw std::invalid_argument("BigInt arrays are not supported");
+    }
+    return view;
+}
+
+template <typename F>
+static Napi::Value guard(const Napi::CallbackInfo& info, F f) {
+    try {
+        return f();
+    } catch (const std::exception& e) {
+        Napi::TypeError::New(info.Env(), e.what()).ThrowAsJavaScriptException();
+        return info.Env().Undefined();
+    }
+}
+
+static bool flagArg(const Napi::CallbackInfo& info, size_t i) {
+    return info.Length() > i && info[i].ToBoolean().Value();
+}
+
+static double meanOf(const View& v, bool compensated) {
+    if (v.length == 0) return std::numeric_limits<double>::quiet_NaN();
+    return active->sum(v.data, v.elem, v.length, compensated) / v.length;
+}
+
+// sum(typedArray[, compensated]): compensated uses Kahan-Neumaier sums
+static Napi::Value Sum(const Napi::CallbackInfo& info) {
+    return guard(info, [&] {
+        View v = viewOf(info[0]);
+        return Napi::Number::New(info.Env(), active->sum(v.data, v.elem, v.length, flagArg(info, 1)));
+    });
+}
+
+// extrema(typedArray) -> { min, max, argmin, argmax }; NaNs are skipped,
+// an empty array gives Infinity / -Infinity and -1
+static Napi::Value ExtremaFn(const Napi::CallbackInfo& info) {
+    return guard(info, [&] {
+        View v = viewOf(info[0]);
+        Extrema e = active->extrema(v.data, v.elem, v.length);
+        Napi::Object out = Napi::Object::New(info.Env());
+        out.Set("min", e.min);
+        out.Set("max", e.max);
+        out.Set("argmin", (double)e.argmin);
+        out.Set("argmax", (double)e.argmax);
+        return out;
+    });
+}
+
+template <typename Pick>
+static Napi::Value extremum(const Napi::CallbackInfo& info, Pick pick) {
+    return guard(info, [&] {
+        View v = viewOf(info[0]);
+        return Napi::Number::New(info.Env(), pick(active->extrema(v.data, v.elem, v.length)));
+    });
+}
+
+static Napi::Value Min(const Napi::CallbackInfo& info) { return extremum(info, [](const Extrema& e) { return e.min; }); }
+static Napi::Value Max(const Napi::CallbackInfo& info) { return extremum(info, [](const Extrema& e) { return e.max; }); }
+static Napi::Value ArgMin(const Napi::CallbackInfo& info) { return extremum(info, [](const Extrema& e) { return (double)e.argmin; }); }
+static Napi::Value ArgMax(const Napi::CallbackInfo& info) { return extremum(info, [](const Extrema& e) { return (double)e.argmax; }); }
+
+// mean(typedArray[, compensated]) -> NaN when empty
+static Napi::Value Mean(const Napi::CallbackInfo& info) {
+    return guard(info, [&] { return Napi::Number::New(info.Env(), meanOf(viewOf(info[0]), flagArg(info, 1))); });
+}
+
+// variance(typedArray[, ddof = 0]): two passes, the mean and then the
+// squared deviations from it, which keeps large offsets from cancelling
+static Napi::Value Variance(const Napi::CallbackInfo& info) {
+    return guard(info, [&] {
+        View v = viewOf(info[0]);
+        double ddof = info.Length() > 1 && info[1].IsNumber() ? info[1].As<Napi::Number>().DoubleValue() : 0;
+        double n = (double)v.length - ddof;
+        if (v.length == 0 || n <= 0) return Napi::Number::New(info.Env(), std::numeric_limits<double>::quiet_NaN());
+        double mean = meanOf(v, false);
+        return Napi::Number::New(info.Env(), active->squares(v.data, v.elem, v.length, mean) / n);
+    });
+}
+
+// dot(a, b): typed arrays of the same length, of any kinds
+static Napi::Value Dot(const Napi::CallbackInfo& info) {
+    return guard(info, [&] {
+        View a = viewOf(info[0]), b = viewOf(info[1]);
+        if (a.length != b.length) throw std::invalid_argument("dot expects arrays of the same length");
+        return Napi::Number::New(info.Env(), active->dot(a.data, a.elem, b.data, b.elem, a.length));
+    });
+}
+
+// prefixSum(typedArray[, out]) -> out, a new Float64Array by default; out
+// may be the input when that is a Float64Array
+static Napi::Value PrefixSum(const Napi::CallbackInfo& info) {
+    return guard(info, [&] {
+        View v = viewOf(info[0]);
+        Napi::Value outVal = info.Length() > 1 && !info[1].IsUndefined() ? info[1] : Napi::Value(Napi::Float64Array::New(info.Env(), v.length));
+        if (!outVal.IsTypedArray() || outVal.As<Napi::TypedArray>().TypedArrayType() != napi_float64_array)
+            throw std::invalid_argument("prefixSum writes to a Float64Array");
+        Napi::Float64Array out = outVal.As<Napi::Float64Array>();
+        if (out.ElementLength() < v.length) throw std::invalid_argument("Destination array is too short");
+        active->prefixSum(v.data, v.elem, v.length, out.Data());
+        return outVal;
+    });
+}
+
+// histogram(typedArray, bins = 10[, lo, hi]) -> Uint32Array(bins); the range
+// defaults to the array's min and max
+static Napi::Value Histogram(const Napi::CallbackInfo& info) {
+    return guard(info, [&] {
+        View v = viewOf(info[0]);
+        size_t bins = info.Length() > 1 && info[1].IsNumber() ? info[1].As<Napi::Number>().Uint32Value() : 10;
+        if (bins == 0 || bins > (1u << 24)) throw std::invalid_argument("bins must be between 1 and 2^24");
+        double lo, hi;
+        if (info.Length() > 3 && info[2].IsNumber() && info[3].IsNumber()) {
+            lo = info[2].As<Napi::Number>().DoubleValue();
+            hi = info[3].As<Napi::Number>().DoubleValue();
+        } else {
+            Extrema e = active->extrema(v.data, v.elem, v.length);
+            lo = e.min;
+            hi = e.max;
+        }
+        std::vector<uint32_t> counts(HISTOGRAM_SETS * bins, 0);
+        active->histogram(v.data, v.elem, v.length, lo, hi, counts.data(), bins);
+        Napi::Uint32Array out = Napi::Uint32Array::New(info.Env(), bins);
+        for (size_t b = 0; b < bins; b++) {
+            uint32_t total = 0;
+            for (size_t s = 0; s < HISTOGRAM_SETS; s++) total += counts[s * bins + b];
+            out[b] = total;
+        }
+        return out;
+    });
+}
+
+// isa() -> "avx2" | "sse2" | "scalar", the kernels in use
+static Napi::Value Isa(const Napi::CallbackInfo& info) {
+    return Napi::String::New(info.Env(), active->name);
+}
+
+// setIsa(name): use a narrower instruction set, e.g. to compare them
+static Napi::Value SetIsa(const Napi::CallbackInfo& info) {
+    return guard(info, [&] {
+        std::string name = info.Length() > 0 && info[0].IsString() ? info[0].As<Napi::String>().Utf8Value() : "";
+        std::string names;
+        for (const Kernels* k : available()) {
+            if (name == k->name) {
+                active = k;
+                return Napi::String::New(info.Env(), active->name);
+            }
+            names += (names.empty() ? "" : ", ") + std::string(k->name);
+        }
+        throw std::invalid_argument("Unknown or unsupported instruction set '" + name + "' (available: " + names + ")");
+    });
+}
+
+Napi::Object Init(Napi::Env env, Napi::Object exports) {
+    std::vector<const Kernels*> tables = available();
+    if (!active) active = tables.front();
+    Napi::Array isas = Napi::Array::New(env, tables.size());
+    for (size_t i = 0; i < tables.size(); i++) isas.Set((uint32_t)i, tables[i]->name);
+
+    exports.Set("sum", Napi::Function::New(env, Sum));
+    exports.Set("min", Napi::Function::New(env, Min));
+    exports.Set("max", Napi::Function::New(env, Max));
+    exports.Set("argmin", Napi::Function::New(env, ArgMin));
+    exports.Set("argmax", Napi::Function::New(env, ArgMax));
+    exports.Set("extrema", Napi::Function::New(env, ExtremaFn));
+    exports.Set("mean", Napi::Function::New(env, Mean));
+    exports.Set("variance", Napi::Function::New(env, Variance));
+    exports.Set("dot", Napi::Function::New(env, Dot));
+    exports.Set("prefixSum", Napi::Function::New(env, PrefixSum));
+    exports.Set("histogram", Napi::Function::New(env, Histogram));
+    exports.Set("isa", Napi::Function::New(env, Isa));
+    exports.Set("setIsa", Napi::Function::New(env, SetIsa));
+    exports.Set("isas", isas);
+    return exports;
+}
+
+NODE_API_MODULE(kernels, Init)
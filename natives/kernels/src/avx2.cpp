@@ -0,0 +1,73 @@
+#include "kernels.h"
+
+// Built with -mavx2 (see CMakeLists.txt); addon.cpp only calls in after
+// checking the CPU.
+#if defined(__AVX2__)
+#include <immintrin.h>
+#include <cstring>
+#include "simd.h"
+
+// Four doubles per register; narrower elements are widened on load
+// (int8/16/32 and float in one instruction, uint32 lane by lane).
+
+namespace {
+
+inline __m128i load32(const void* p) {
+    int32_t v;
+    std::memcpy(&v, p, 4);
+    return _mm_cvtsi32_si128(v);
+}
+
+struct Avx2 {
+    using reg = __m256d;
+    using mask = __m256d;
+    static constexpr size_t lanes = 4;
+
+    static reg zero() { return _mm256_setzero_pd(); }
+    static reg set1(double x) { return _mm256_set1_pd(x); }
+    static reg iota() { return _mm256_set_pd(3, 2, 1, 0); }
+    template <typename T> static reg load(const T* p) {
+        if constexpr (std::is_same_v<T, double>) return _mm256_loadu_pd(p);
+        else if constexpr (std::is_same_v<T, float>) return _mm256_cvtps_pd(_mm_loadu_ps(p));
+        else if constexpr (std::is_same_v<T, int32_t>) return _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+        else if constexpr (std::is_same_v<T, int16_t>) return _mm256_cvtepi32_pd(_mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))));
+        else if constexpr (std::is_same_v<T, uint16_t>) return _mm256_cvtepi32_pd(_mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))));
+        else if constexpr (std::is_same_v<T, int8_t>) return _mm256_cvtepi32_pd(_mm_cvtepi8_epi32(load32(p)));
+        else if constexpr (std::is_same_v<T, uint8_t>) return _mm256_cvtepi32_pd(_mm_cvtepu8_epi32(load32(p)));
+        else return _mm256_set_pd((double)p[3], (double)p[2], (double)p[1], (double)p[0]);
+    }
+    static reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+    static reg sub(reg a, reg b) { return _mm256_sub_pd(a, b); }
+    static reg mul(reg a, reg b) { return _mm256_mul_pd(a, b); }
+    static reg abs(reg a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    static reg min(reg a, reg b) { return _mm256_min_pd(a, b); }
+    static mask lt(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static mask gt(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    static mask ge(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+    static mask le(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+    static mask both(mask a, mask b) { return _mm256_and_pd(a, b); }
+    static reg select(mask m, reg a, reg b) { return _mm256_blendv_pd(b, a, m); }
+    // [a b c d] -> [a, a+b, a+b+c, a+b+c+d] in two shifted adds.
+    static reg scan(reg a) {
+        a = _mm256_add_pd(a, _mm256_blend_pd(_mm256_permute4x64_pd(a, _MM_SHUFFLE(2, 1, 0, 0)), _mm256_setzero_pd(), 0x1));
+        return _mm256_add_pd(a, _mm256_blend_pd(_mm256_permute4x64_pd(a, _MM_SHUFFLE(1, 0, 0, 0)), _mm256_setzero_pd(), 0x3));
+    }
+    static reg broadcastLast(reg a) { return _mm256_permute4x64_pd(a, _MM_SHUFFLE(3, 3, 3, 3)); }
+    static void store(double* out, reg a) { _mm256_storeu_pd(out, a); }
+    // Two 8-byte stores: reading single lanes back from one 16-byte store
+    // measured twice as slow.
+    static void truncate(int32_t* out, reg a) {
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_cvttpd_epi32(_mm256_castpd256_pd128(a)));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + 2), _mm_cvttpd_epi32(_mm256_extractf128_pd(a, 1)));
+    }
+};
+
+}  // namespace
+
+const Kernels* avx2Kernels() { return kernelTable<Avx2>("avx2"); }
+
+#else
+
+const Kernels* avx2Kernels() { return nullptr; }
+
+#endif
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Reductions over typed array data, one table per instruction set. Every
+// kernel reads elements of any Elem kind as doubles and accumulates in
+// double. scalar.cpp, sse2.cpp and avx2.cpp each build a table from the
+// same templates in simd.h; addon.cpp picks the widest one this CPU runs.
+
+enum class Elem { I8, U8, I16, U16, I32, U32, F32, F64 };
+
+constexpr size_t HISTOGRAM_SETS = 4;
+
+struct Extrema {
+    double min, max;            // NaNs are skipped; +/-Infinity when nothing is left
+    int64_t argmin, argmax;     // first index of each, -1 when nothing is left
+};
+
+struct Kernels {
+    const char* name;
+    double (*sum)(const void* p, Elem e, size_t n, bool compensated);
+    Extrema (*extrema)(const void* p, Elem e, size_t n);
+    double (*squares)(const void* p, Elem e, size_t n, double mean);   // sum of (x - mean)^2
+    double (*dot)(const void* a, Elem ea, const void* b, Elem eb, size_t n);
+    void (*prefixSum)(const void* p, Elem e, size_t n, double* out);
+    // counts: HISTOGRAM_SETS * nbins zeroed counters, summed per bin by the caller
+    void (*histogram)(const void* p, Elem e, size_t n, double lo, double hi, uint32_t* counts, size_t nbins);
+};
+
+const Kernels* scalarKernels();
+const Kernels* sse2Kernels();   // nullptr where not built
+const Kernels* avx2Kernels();   // nullptr where not built
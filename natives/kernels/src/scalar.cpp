@@ -0,0 +1,36 @@
+#include "simd.h"
+
+// One lane of plain doubles: the fallback on any CPU, and the reference the
+// wider tables are checked against.
+
+namespace {
+
+struct Scalar {
+    using reg = double;
+    using mask = bool;
+    static constexpr size_t lanes = 1;
+
+    static reg zero() { return 0; }
+    static reg set1(double x) { return x; }
+    static reg iota() { return 0; }
+    template <typename T> static reg load(const T* p) { return (double)*p; }
+    static reg add(reg a, reg b) { return a + b; }
+    static reg sub(reg a, reg b) { return a - b; }
+    static reg mul(reg a, reg b) { return a * b; }
+    static reg abs(reg a) { return mag(a); }
+    static reg min(reg a, reg b) { return b < a ? b : a; }
+    static mask lt(reg a, reg b) { return a < b; }
+    static mask gt(reg a, reg b) { return a > b; }
+    static mask ge(reg a, reg b) { return a >= b; }
+    static mask le(reg a, reg b) { return a <= b; }
+    static mask both(mask a, mask b) { return a && b; }
+    static reg select(mask m, reg a, reg b) { return m ? a : b; }
+    static reg scan(reg a) { return a; }
+    static reg broadcastLast(reg a) { return a; }
+    static void store(double* out, reg a) { *out = a; }
+    static void truncate(int32_t* out, reg a) { *out = (int32_t)a; }
+};
+
+}  // namespace
+
+const Kernels* scalarKernels() { return kernelTable<Scalar>("scalar"); }
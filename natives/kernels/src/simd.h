@@ -0,0 +1,275 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include "kernels.h"
+
+// The kernels, written once against a vector type V:
+//
+//   reg, mask, lanes         a register of `lanes` doubles and a lane mask
+//   zero() set1(x) iota()    constants; iota() is 0, 1, 2, ...
+//   load<T>(p)               lanes elements of T widened to double
+//   add sub mul abs min      lane-wise arithmetic
+//   lt gt ge le both         ordered compares (false for NaN) and mask and
+//   select(m, a, b)          m ? a : b per lane
+//   scan(x)                  inclusive prefix sum across the lanes
+//   broadcastLast(x)         the last lane in every lane
+//   store(out, x)            lanes doubles to out
+//   truncate(out, x)         lanes int32s, rounded toward zero, to out
+//
+// Each instruction set's .cpp defines its V and includes this header, so
+// everything here stays internal to that translation unit: none of it may
+// be shared between files built with different -m flags.
+
+namespace {
+
+constexpr double INF = std::numeric_limits<double>::infinity();
+
+inline double mag(double x) { return x < 0 ? -x : x; }
+
+// Neumaier's variant of Kahan summation: c collects the low-order bits each
+// addition drops, whichever operand is larger.
+struct Compensated {
+    double s = 0, c = 0;
+    void add(double x) {
+        double t = s + x;
+        c += mag(s) >= mag(x) ? (s - t) + x : (x - t) + s;
+        s = t;
+    }
+    double value() const { return s + c; }
+};
+
+template <typename F>
+auto withElem(const void* p, Elem e, F&& f) {
+    switch (e) {
+        case Elem::I8: return f(static_cast<const int8_t*>(p));
+        case Elem::U8: return f(static_cast<const uint8_t*>(p));
+        case Elem::I16: return f(static_cast<const int16_t*>(p));
+        case Elem::U16: return f(static_cast<const uint16_t*>(p));
+        case Elem::I32: return f(static_cast<const int32_t*>(p));
+        case Elem::U32: return f(static_cast<const uint32_t*>(p));
+        case Elem::F32: return f(static_cast<const float*>(p));
+        default: return f(static_cast<const double*>(p));
+    }
+}
+
+template <typename V>
+double addLanes(typename V::reg x) {
+    double l[V::lanes];
+    V::store(l, x);
+    double t = 0;
+    for (size_t k = 0; k < V::lanes; k++) t += l[k];
+    return t;
+}
+
+// Four independent accumulators hide the latency of each add.
+template <typename V, typename T>
+double sumOf(const T* p, size_t n) {
+    constexpr size_t L = V::lanes;
+    auto s0 = V::zero(), s1 = V::zero(), s2 = V::zero(), s3 = V::zero();
+    size_t i = 0;
+    for (; i + 4 * L <= n; i += 4 * L) {
+        s0 = V::add(s0, V::load(p + i));
+        s1 = V::add(s1, V::load(p + i + L));
+        s2 = V::add(s2, V::load(p + i + 2 * L));
+        s3 = V::add(s3, V::load(p + i + 3 * L));
+    }
+    for (; i + L <= n; i += L) s0 = V::add(s0, V::load(p + i));
+    double t = addLanes<V>(V::add(V::add(s0, s1), V::add(s2, s3)));
+    for (; i < n; i++) t += (double)p[i];
+    return t;
+}
+
+template <typename V, typename T>
+double compensatedSumOf(const T* p, size_t n) {
+    constexpr size_t L = V::lanes;
+    auto s = V::zero(), c = V::zero();
+    size_t i = 0;
+    for (; i + L <= n; i += L) {
+        auto x = V::load(p + i);
+        auto t = V::add(s, x);
+        auto lost = V::select(V::ge(V::abs(s), V::abs(x)), V::add(V::sub(s, t), x), V::add(V::sub(x, t), s));
+        c = V::add(c, lost);
+        s = t;
+    }
+    double sl[L], cl[L];
+    V::store(sl, s);
+    V::store(cl, c);
+    Compensated acc;
+    for (size_t k = 0; k < L; k++) acc.add(sl[k]);
+    for (; i < n; i++) acc.add((double)p[i]);
+    double comp = 0;
+    for (size_t k = 0; k < L; k++) comp += cl[k];
+    acc.c += comp;
+    return acc.value();
+}
+
+// Each lane keeps its own best value and the index it was first seen at,
+// in two sets so consecutive blocks do not wait on each other; the lanes
+// are merged preferring the lower index on ties.
+template <typename V, typename T>
+Extrema extremaOf(const T* p, size_t n) {
+    constexpr size_t L = V::lanes;
+    typename V::reg lo[2], hi[2], ilo[2], ihi[2];
+    for (int s = 0; s < 2; s++) {
+        lo[s] = V::set1(INF);
+        hi[s] = V::set1(-INF);
+        ilo[s] = ihi[s] = V::set1(-1);
+    }
+    auto idx = V::iota(), step = V::set1((double)L);
+    auto update = [&](int s, typename V::reg x, typename V::reg at) {
+        auto m = V::lt(x, lo[s]);
+        lo[s] = V::select(m, x, lo[s]);
+        ilo[s] = V::select(m, at, ilo[s]);
+        m = V::gt(x, hi[s]);
+        hi[s] = V::select(m, x, hi[s]);
+        ihi[s] = V::select(m, at, ihi[s]);
+    };
+    size_t i = 0;
+    for (; i + 2 * L <= n; i += 2 * L) {
+        update(0, V::load(p + i), idx);
+        idx = V::add(idx, step);
+        update(1, V::load(p + i + L), idx);
+        idx = V::add(idx, step);
+    }
+    if (i + L <= n) {
+        update(0, V::load(p + i), idx);
+        i += L;
+    }
+    Extrema r{ INF, -INF, -1, -1 };
+    for (int s = 0; s < 2; s++) {
+        double lov[L], hiv[L], ilov[L], ihiv[L];
+        V::store(lov, lo[s]);
+        V::store(hiv, hi[s]);
+        V::store(ilov, ilo[s]);
+        V::store(ihiv, ihi[s]);
+        for (size_t k = 0; k < L; k++) {
+            int64_t a = (int64_t)ilov[k], b = (int64_t)ihiv[k];
+            if (a >= 0 && (lov[k] < r.min || (lov[k] == r.min && a < r.argmin))) { r.min = lov[k]; r.argmin = a; }
+            if (b >= 0 && (hiv[k] > r.max || (hiv[k] == r.max && b < r.argmax))) { r.max = hiv[k]; r.argmax = b; }
+        }
+    }
+    for (; i < n; i++) {
+        double x = (double)p[i];
+        if (x < r.min) { r.min = x; r.argmin = (int64_t)i; }
+        if (x > r.max) { r.max = x; r.argmax = (int64_t)i; }
+    }
+    // Only an infinity can fail to beat the starting values: look for the
+    // first one when that is all there was.
+    for (size_t k = 0; r.argmin < 0 && k < n; k++) if ((double)p[k] == INF) r.argmin = (int64_t)k;
+    for (size_t k = 0; r.argmax < 0 && k < n; k++) if ((double)p[k] == -INF) r.argmax = (int64_t)k;
+    return r;
+}
+
+template <typename V, typename T>
+double squaresOf(const T* p, size_t n, double mean) {
+    constexpr size_t L = V::lanes;
+    auto m = V::set1(mean);
+    auto s0 = V::zero(), s1 = V::zero();
+    size_t i = 0;
+    for (; i + 2 * L <= n; i += 2 * L) {
+        auto d0 = V::sub(V::load(p + i), m), d1 = V::sub(V::load(p + i + L), m);
+        s0 = V::add(s0, V::mul(d0, d0));
+        s1 = V::add(s1, V::mul(d1, d1));
+    }
+    for (; i + L <= n; i += L) {
+        auto d = V::sub(V::load(p + i), m);
+        s0 = V::add(s0, V::mul(d, d));
+    }
+    double t = addLanes<V>(V::add(s0, s1));
+    for (; i < n; i++) {
+        double d = (double)p[i] - mean;
+        t += d * d;
+    }
+    return t;
+}
+
+template <typename V, typename A, typename B>
+double dotOf(const A* a, const B* b, size_t n) {
+    constexpr size_t L = V::lanes;
+    auto s0 = V::zero(), s1 = V::zero(), s2 = V::zero(), s3 = V::zero();
+    size_t i = 0;
+    for (; i + 4 * L <= n; i += 4 * L) {
+        s0 = V::add(s0, V::mul(V::load(a + i), V::load(b + i)));
+        s1 = V::add(s1, V::mul(V::load(a + i + L), V::load(b + i + L)));
+        s2 = V::add(s2, V::mul(V::load(a + i + 2 * L), V::load(b + i + 2 * L)));
+        s3 = V::add(s3, V::mul(V::load(a + i + 3 * L), V::load(b + i + 3 * L)));
+    }
+    for (; i + L <= n; i += L) s0 = V::add(s0, V::mul(V::load(a + i), V::load(b + i)));
+    double t = addLanes<V>(V::add(V::add(s0, s1), V::add(s2, s3)));
+    for (; i < n; i++) t += (double)a[i] * (double)b[i];
+    return t;
+}
+
+// out may be the input itself when that is a Float64Array: each block is
+// loaded before it is overwritten.
+template <typename V, typename T>
+void prefixSumOf(const T* p, size_t n, double* out) {
+    constexpr size_t L = V::lanes;
+    auto carry = V::zero();
+    size_t i = 0;
+    for (; i + L <= n; i += L) {
+        auto x = V::add(V::scan(V::load(p + i)), carry);
+        V::store(out + i, x);
+        carry = V::broadcastLast(x);
+    }
+    double run = i ? out[i - 1] : 0;
+    for (; i < n; i++) out[i] = run += (double)p[i];
+}
+
+// Values in [lo, hi] fall in nbins equal bins, hi itself in the last one;
+// NaNs and values outside are not counted. counts holds HISTOGRAM_SETS
+// rows of nbins: element i goes to row i % HISTOGRAM_SETS, so runs of equal
+// values do not serialize on one counter. The caller adds the rows up.
+template <typename V, typename T>
+void histogramOf(const T* p, size_t n, double lo, double hi, uint32_t* counts, size_t nbins) {
+    constexpr size_t L = V::lanes;
+    double scale = hi > lo ? nbins / (hi - lo) : 0;
+    double last = (double)(nbins - 1);
+    auto vlo = V::set1(lo), vhi = V::set1(hi), vscale = V::set1(scale), vlast = V::set1(last), skip = V::set1(-1);
+    int32_t bin[L];
+    size_t i = 0;
+    for (; i + L <= n; i += L) {
+        auto x = V::load(p + i);
+        auto at = V::mul(V::sub(x, vlo), vscale);
+        // at >= 0 also drops the NaN an infinite range gives
+        auto in = V::both(V::both(V::ge(x, vlo), V::le(x, vhi)), V::ge(at, V::zero()));
+        V::truncate(bin, V::select(in, V::min(at, vlast), skip));
+        for (size_t k = 0; k < L; k++)
+            if (bin[k] >= 0) counts[((i + k) % HISTOGRAM_SETS) * nbins + bin[k]]++;
+    }
+    for (; i < n; i++) {
+        double x = (double)p[i], at = (x - lo) * scale;
+        if (!(x >= lo && x <= hi && at >= 0)) continue;
+        counts[(i % HISTOGRAM_SETS) * nbins + (size_t)(at < last ? at : last)]++;
+    }
+}
+
+template <typename V>
+const Kernels* kernelTable(const char* name) {
+    static const Kernels table = {
+        name,
+        [](const void* p, Elem e, size_t n, bool compensated) {
+            return withElem(p, e, [&](auto* q) { return compensated ? compensatedSumOf<V>(q, n) : sumOf<V>(q, n); });
+        },
+        [](const void* p, Elem e, size_t n) {
+            return withElem(p, e, [&](auto* q) { return extremaOf<V>(q, n); });
+        },
+        [](const void* p, Elem e, size_t n, double mean) {
+            return withElem(p, e, [&](auto* q) { return squaresOf<V>(q, n, mean); });
+        },
+        [](const void* a, Elem ea, const void* b, Elem eb, size_t n) {
+            return withElem(a, ea, [&](auto* x) { return withElem(b, eb, [&](auto* y) { return dotOf<V>(x, y, n); }); });
+        },
+        [](const void* p, Elem e, size_t n, double* out) {
+            withElem(p, e, [&](auto* q) { prefixSumOf<V>(q, n, out); return 0; });
+        },
+        [](const void* p, Elem e, size_t n, double lo, double hi, uint32_t* counts, size_t nbins) {
+            withElem(p, e, [&](auto* q) { histogramOf<V>(q, n, lo, hi, counts, nbins); return 0; });
+        },
+    };
+    return &table;
+}
+
+}  // namespace
@@ -0,0 +1,51 @@
+#include "kernels.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#include "simd.h"
+
+// Two doubles per register. SSE2 is part of x86-64 itself, so this table
+// needs no CPU check.
+
+namespace {
+
+struct Sse2 {
+    using reg = __m128d;
+    using mask = __m128d;
+    static constexpr size_t lanes = 2;
+
+    static reg zero() { return _mm_setzero_pd(); }
+    static reg set1(double x) { return _mm_set1_pd(x); }
+    static reg iota() { return _mm_set_pd(1, 0); }
+    template <typename T> static reg load(const T* p) {
+        if constexpr (std::is_same_v<T, double>) return _mm_loadu_pd(p);
+        else if constexpr (std::is_same_v<T, float>) return _mm_cvtps_pd(_mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(p))));
+        else if constexpr (std::is_same_v<T, int32_t>) return _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+        else return _mm_set_pd((double)p[1], (double)p[0]);
+    }
+    static reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+    static reg sub(reg a, reg b) { return _mm_sub_pd(a, b); }
+    static reg mul(reg a, reg b) { return _mm_mul_pd(a, b); }
+    static reg abs(reg a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+    static reg min(reg a, reg b) { return _mm_min_pd(a, b); }
+    static mask lt(reg a, reg b) { return _mm_cmplt_pd(a, b); }
+    static mask gt(reg a, reg b) { return _mm_cmpgt_pd(a, b); }
+    static mask ge(reg a, reg b) { return _mm_cmpge_pd(a, b); }
+    static mask le(reg a, reg b) { return _mm_cmple_pd(a, b); }
+    static mask both(mask a, mask b) { return _mm_and_pd(a, b); }
+    static reg select(mask m, reg a, reg b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+    static reg scan(reg a) { return _mm_add_pd(a, _mm_unpacklo_pd(_mm_setzero_pd(), a)); }
+    static reg broadcastLast(reg a) { return _mm_unpackhi_pd(a, a); }
+    static void store(double* out, reg a) { _mm_storeu_pd(out, a); }
+    static void truncate(int32_t* out, reg a) { _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_cvttpd_epi32(a)); }
+};
+
+}  // namespace
+
+const Kernels* sse2Kernels() { return kernelTable<Sse2>("sse2"); }
+
+#else
+
+const Kernels* sse2Kernels() { return nullptr; }
+
+#endif
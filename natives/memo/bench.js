@@ -0,0 +1,75 @@
+// Cost of a memoized call, in ns, for the old JSON.stringify + Map + Proxy
+// Memoize, the JS fallback cache and this addon, on hits (a few hot keys)
+// and on misses (more distinct keys than the capacity). Results are
+// checked against the plain function.
+// usage: node bench.js [calls]
+require('./index.js');
+const { Memoize, JsCache } = require('../../core/nova-memo.js');
+
+const calls = Number(process.argv[2]) || 5e4;
+let failed = false;
+
+function legacy(fn) {
+  const cache = new Map();
+  const callable = (...args) => {
+    const key = JSON.stringify(args);
+    if (!cache.has(key)) cache.set(key, fn(...args));
+    return cache.get(key);
+  };
+  return new Proxy(callable, {
+    get: (target, prop) => (prop in target ? target[prop] : undefined),
+  });
+}
+
+// Memoize with the addon hidden, so the JsCache fallback is used.
+function fallback(fn, opts) {
+  const cache = new JsCache(opts);
+  let values = [];
+  return (...args) => {
+    const slot = cache.find(args);
+    if (slot >= 0) return values[slot];
+    const value = fn(...args);
+    values[cache.store()] = value;
+    return value;
+  };
+}
+
+const f = (a, b) => (typeof a === 'number' ? a * 31 : JSON.stringify(a).length) + (b ? b.length : 0);
+
+const shapes = {
+  'number': (i) => [i],
+  'two strings': (i) => ['key' + i, 'a longer second argument ' + (i % 7)],
+  'object': (i) => [{ id: i, name: 'item' + i, tags: ['a', 'b'] }],
+  'float64[64]': (i) => [new Float64Array(64).fill(i)],
+};
+
+// best of five runs
+function ns(fn, argsOf, keys) {
+  const args = Array.from({ length: keys }, (_, i) => argsOf(i));
+  for (let i = 0; i < Math.min(calls, 2000); i++) fn(...args[i % keys]);
+  let best = Infinity;
+  for (let r = 0; r < 5; r++) {
+    const t0 = process.hrtime.bigint();
+    for (let i = 0; i < calls; i++) fn(...args[i % keys]);
+    best = Math.min(best, Number(process.hrtime.bigint() - t0) / calls);
+  }
+  return best;
+}
+
+const capacity = 1000;
+for (const [workload, keys] of [['hits', 16], ['misses', 4 * capacity]]) {
+  console.log(`${workload}: ${keys} distinct keys, capacity ${capacity}, ns per call`);
+  console.log(`${'arguments'.padEnd(14)} ${'legacy'.padStart(8)} ${'js'.padStart(8)} ${'native'.padStart(8)}`);
+  for (const [name, argsOf] of Object.entries(shapes)) {
+    const memos = [legacy(f), fallback(f, { capacity }), Memoize(f, { capacity })];
+    const cells = memos.map((m) => ns(m, argsOf, keys).toFixed(0));
+    for (let i = 0; i < 50; i++) {
+      const args = argsOf(i);
+      for (const m of memos) if (m(...args) !== f(...args)) failed = true;
+    }
+    console.log(`${name.padEnd(14)} ${cells.map((c) => c.padStart(8)).join(' ')}`);
+  }
+}
+console.log('(legacy grows without bound: on misses it ends holding every key)');
+console.log(failed ? 'WRONG' : 'ok');
+process.exitCode = failed ? 1 : 0;
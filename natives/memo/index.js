@@ -0,0 +1,3 @@
+const addon = require('bindings')('memo');
+
+module.exports = addon
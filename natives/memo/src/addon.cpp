@@ -0,0 +1,398 @@
+#include <napi.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "cache.h"
+#include "xxhash.h"
+
+// Memoization caches for nova's Memoize and `memo func` (core/nova-memo.js).
+// Arguments are encoded into one canonical byte string, hashed with XXH64 and
+// looked up in a bounded LRU or LFU table (cache.h); results stay in a JS
+// array the caller indexes by the returned slot. Compared with the
+// JSON.stringify key this replaces, the encoding keeps types apart (1 vs
+// "1"), takes typed arrays as raw bytes, orders object keys, Map and Set
+// entries so equal contents give equal keys, and keys functions and symbols
+// by identity instead of dropping them.
+
+constexpr int MAX_DEPTH = 32;
+
+// Arguments that have no stable encoding (nesting too deep, usually a cycle).
+struct Uncacheable {};
+
+// A getter, proxy trap or helper threw while encoding; the JS exception is
+// already pending and guard() lets it through.
+struct Pending {};
+
+static Napi::Value checked(Napi::Value v) {
+    if (v.IsEmpty()) throw Pending();
+    return v;
+}
+
+// Per-environment constructors and the identity tables, kept as instance data.
+struct Shared {
+    Napi::FunctionReference mapCtor, setCtor, arrayFrom;
+    Napi::ObjectReference objectIds, symbolIds;   // WeakMap and Map to id
+    Napi::FunctionReference weakGet, weakSet, mapGet, mapSet;
+    double nextId = 1;
+};
+
+static Shared& shared(Napi::Env env) { return *env.GetInstanceData<Shared>(); }
+
+static void putTag(std::string& out, char tag) { out.push_back(tag); }
+
+template <typename T>
+static void putRaw(std::string& out, T v) {
+    char b[sizeof(T)];
+    std::memcpy(b, &v, sizeof(T));
+    out.append(b, sizeof(T));
+}
+
+static void putBytes(std::string& out, const void* p, size_t n) {
+    putRaw<uint64_t>(out, n);
+    out.append(static_cast<const char*>(p), n);
+}
+
+// Short strings, most keys, take one N-API call instead of two.
+static void putString(std::string& out, napi_env env, napi_value v) {
+    char16_t small[128];
+    size_t len = 0;
+    napi_get_value_string_utf16(env, v, small, 128, &len);
+    if (len < 127) return putBytes(out, small, len * sizeof(char16_t));
+    napi_get_value_string_utf16(env, v, nullptr, 0, &len);
+    std::u16string buf(len + 1, u'\0');
+    napi_get_value_string_utf16(env, v, &buf[0], len + 1, &len);
+    putBytes(out, buf.data(), len * sizeof(char16_t));
+}
+
+// Functions, symbols, promises and the like compare by identity: each gets a
+// number the first time it is seen. Objects are held weakly; symbols cannot
+// all be WeakMap keys, so they are held for the life of the process.
+static double identity(Napi::Env env, Napi::Value v) {
+    Shared& s = shared(env);
+    bool weak = !v.IsSymbol();
+    Napi::Object table = weak ? s.objectIds.Value() : s.symbolIds.Value();
+    Napi::Value id = checked((weak ? s.weakGet : s.mapGet).Call(table, { v }));
+    if (id.IsNumber()) return id.As<Napi::Number>().DoubleValue();
+    double fresh = s.nextId++;
+    checked((weak ? s.weakSet : s.mapSet).Call(table, { v, Napi::Number::New(env, fresh) }));
+    return fresh;
+}
+
+static void encode(std::string& out, Napi::Env env, Napi::Value v, int depth);
+
+// Each item is encoded on its own and the encodings sorted, so insertion
+// order does not matter.
+static void encodeUnordered(std::string& out, Napi::Env env, char tag, Napi::Array items, int depth) {
+    uint32_t n = items.Length();
+    std::vector<std::string> parts(n);
+    for (uint32_t i = 0; i < n; i++) encode(parts[i], env, checked(items.Get(i)), depth + 1);
+    std::sort(parts.begin(), parts.end());
+    putTag(out, tag);
+    putRaw<uint32_t>(out, n);
+    for (const std::string& p : parts) putBytes(out, p.data(), p.size());
+}
+
+static void encodeObject(std::string& out, Napi::Env env, Napi::Object obj, int depth) {
+    napi_value names;
+    napi_status st = napi_get_all_property_names(env, obj, napi_key_own_only,
+        static_cast<napi_key_filter>(napi_key_enumerable | napi_key_skip_symbols), napi_key_numbers_to_strings, &names);
+    if (st != napi_ok) throw Pending();
+    Napi::Array keys(env, names);
+    uint32_t n = keys.Length();
+    if (n == 0) {
+        // Maps and Sets keep their contents out of their own properties
+        Shared& s = shared(env);
+        if (obj.InstanceOf(s.mapCtor.Value())) return encodeUnordered(out, env, 'M', checked(s.arrayFrom.Call({ obj })).As<Napi::Array>(), depth);
+        if (obj.InstanceOf(s.setCtor.Value())) return encodeUnordered(out, env, 'S', checked(s.arrayFrom.Call({ obj })).As<Napi::Array>(), depth);
+    }
+    std::vector<std::pair<std::string, Napi::Value>> fields(n);
+    for (uint32_t i = 0; i < n; i++) {
+        Napi::Value k = checked(keys.Get(i));
+        putString(fields[i].first, env, k);
+        fields[i].second = k;
+    }
+    std::sort(fields.begin(), fields.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    putTag(out, 'o');
+    putRaw<uint32_t>(out, n);
+    for (auto& f : fields) {
+        out += f.first;
+        encode(out, env, checked(obj.Get(f.second)), depth + 1);
+    }
+}
+
+static void encode(std::string& out, Napi::Env env, Napi::Value v, int depth) {
+    if (depth > MAX_DEPTH) throw Uncacheable();
+    switch (v.Type()) {
+        case napi_undefined: return putTag(out, 'u');
+        case napi_null: return putTag(out, 'n');
+        case napi_boolean: return putTag(out, v.As<Napi::Boolean>().Value() ? 't' : 'f');
+        case napi_number: {
+            double d = v.As<Napi::Number>().DoubleValue();
+            if (std::isnan(d)) d = std::numeric_limits<double>::quiet_NaN();
+            if (d == 0) d = 0;   // -0 and 0 are the same key, as in a Map
+            putTag(out, 'd');
+            return putRaw(out, d);
+        }
+        case napi_string:
+            putTag(out, 's');
+            return putString(out, env, v);
+        case napi_bigint: {
+            int sign = 0;
+            size_t words = 0;
+            napi_get_value_bigint_words(env, v, nullptr, &words, nullptr);
+            std::vector<uint64_t> w(words);
+            napi_get_value_bigint_words(env, v, &sign, &words, w.data());
+            while (words > 0 && w[words - 1] == 0) words--;
+            putTag(out, sign && words ? 'G' : 'g');
+            return putBytes(out, w.data(), words * sizeof(uint64_t));
+        }
+        case napi_object: break;
+        default:   // function, symbol, external
+            putTag(out, 'i');
+            return putRaw(out, identity(env, v));
+    }
+    if (v.IsArray()) {
+        Napi::Array a = v.As<Napi::Array>();
+        uint32_t n = a.Length();
+        putTag(out, 'a');
+        putRaw<uint32_t>(out, n);
+        for (uint32_t i = 0; i < n; i++) encode(out, env, checked(a.Get(i)), depth + 1);
+        return;
+    }
+    if (v.IsTypedArray()) {
+        Napi::TypedArray t = v.As<Napi::TypedArray>();
+        putTag(out, 'T');
+        putTag(out, (char)t.TypedArrayType());
+        return putBytes(out, static_cast<uint8_t*>(t.ArrayBuffer().Data()) + t.ByteOffset(), t.ByteLength());
+    }
+    if (v.IsArrayBuffer()) {
+        Napi::ArrayBuffer b = v.As<Napi::ArrayBuffer>();
+        putTag(out, 'B');
+        return putBytes(out, b.Data(), b.ByteLength());
+    }
+    if (v.IsDataView()) {
+        Napi::DataView d = v.As<Napi::DataView>();
+        putTag(out, 'V');
+        return putBytes(out, static_cast<uint8_t*>(d.ArrayBuffer().Data()) + d.ByteOffset(), d.ByteLength());
+    }
+    if (v.IsDate()) {
+        putTag(out, 'D');
+        return putRaw(out, v.As<Napi::Date>().ValueOf());
+    }
+    if (v.IsPromise()) {
+        putTag(out, 'i');
+        return putRaw(out, identity(env, v));
+    }
+    encodeObject(out, env, v.As<Napi::Object>(), depth);
+}
+
+// The arguments of a call as one key: their count, then each one.
+static bool encodeArgs(std::string& out, const Napi::CallbackInfo& info) {
+    out.clear();
+    putRaw<uint32_t>(out, (uint32_t)info.Length());
+    try {
+        for (size_t i = 0; i < info.Length(); i++) encode(out, info.Env(), info[i], 0);
+    } catch (const Uncacheable&) {
+        return false;
+    }
+    return true;
+}
+
+template <typename F>
+static Napi::Value guard(const Napi::CallbackInfo& info, F f) {
+    try {
+        return f();
+    } catch (const Pending&) {
+        return info.Env().Undefined();
+    } catch (const std::exception& e) {
+        Napi::TypeError::New(info.Env(), e.what()).ThrowAsJavaScriptException();
+        return info.Env().Undefined();
+    }
+}
+
+// new MemoCache({ capacity = 10000, policy = 'lru' | 'lfu', ttl = 0 ms })
+//
+//   lookup(...args) -> slot of the cached result, -1 on a miss (the key is
+//                      kept for store()), or -2 when the arguments cannot be
+//                      keyed and the call should just run
+//   store()         -> slot for the result of the last missed lookup
+//   abandon()       forgets the last missed lookup (the call threw)
+//   delete(...args) -> former slot, or -1
+//   clear() / stats()
+//
+// Missed keys wait on a stack, so a memoized function may recurse into
+// itself between its lookup and its store.
+class MemoCache : public Napi::ObjectWrap<MemoCache> {
+public:
+    static Napi::Function Define(Napi::Env env) {
+        return DefineClass(env, "MemoCache", {
+            InstanceMethod("lookup", &MemoCache::Lookup),
+            InstanceMethod("store", &MemoCache::Store),
+            InstanceMethod("abandon", &MemoCache::Abandon),
+            InstanceMethod("delete", &MemoCache::Delete),
+            InstanceMethod("clear", &MemoCache::Clear),
+            InstanceMethod("stats", &MemoCache::Stats),
+        });
+    }
+
+    MemoCache(const Napi::CallbackInfo& info) : Napi::ObjectWrap<MemoCache>(info) {
+        try {
+            cache = optionsOf(info);
+        } catch (const std::exception& e) {
+            Napi::TypeError::New(info.Env(), e.what()).ThrowAsJavaScriptException();
+        }
+    }
+
+private:
+    Cache cache;
+    std::string key;
+    std::vector<std::pair<uint64_t, std::string>> pending;
+    double uncacheable = 0;
+
+    static Cache optionsOf(const Napi::CallbackInfo& info) {
+        size_t capacity = 10000;
+        Policy policy = Policy::LRU;
+        double ttl = 0;
+        if (info.Length() > 0 && info[0].IsObject()) {
+            Napi::Object o = info[0].As<Napi::Object>();
+            Napi::Value c = o.Get("capacity"), p = o.Get("policy"), t = o.Get("ttl");
+            if (c.IsNumber()) {
+                double d = c.As<Napi::Number>().DoubleValue();
+                if (!(d >= 1)) throw std::invalid_argument("capacity must be at least 1");
+                capacity = d >= 4294967295.0 ? 4294967294u : (size_t)d;
+            }
+            if (p.IsString()) {
+                std::string name = p.As<Napi::String>().Utf8Value();
+                if (name == "lfu") policy = Policy::LFU;
+                else if (name != "lru") throw std::invalid_argument("policy must be 'lru' or 'lfu'");
+            }
+            if (t.IsNumber()) ttl = std::max(0.0, t.As<Napi::Number>().DoubleValue());
+        }
+        return Cache(capacity, policy, ttl);
+    }
+
+    Napi::Value Lookup(const Napi::CallbackInfo& info) {
+        return guard(info, [&] {
+            if (!encodeArgs(key, info)) {
+                uncacheable++;
+                return Napi::Number::New(info.Env(), -2);
+            }
+            uint64_t h = xxh::hash64(key.data(), key.size());
+            uint32_t s = cache.find(h, key);
+            if (s != Cache::NONE) return Napi::Number::New(info.Env(), s);
+            pending.emplace_back(h, key);
+            return Napi::Number::New(info.Env(), -1);
+        });
+    }
+
+    Napi::Value Store(const Napi::CallbackInfo& info) {
+        return guard(info, [&] {
+            if (pending.empty()) throw std::logic_error("store() without a missed lookup()");
+            auto& top = pending.back();
+            uint32_t s = cache.insert(top.first, std::move(top.second));
+            pending.pop_back();
+            return Napi::Number::New(info.Env(), s);
+        });
+    }
+
+    Napi::Value Abandon(const Napi::CallbackInfo& info) {
+        if (!pending.empty()) pending.pop_back();
+        return info.Env().Undefined();
+    }
+
+    Napi::Value Delete(const Napi::CallbackInfo& info) {
+        return guard(info, [&] {
+            if (!encodeArgs(key, info)) return Napi::Number::New(info.Env(), -1);
+            uint32_t s = cache.erase(xxh::hash64(key.data(), key.size()), key);
+            return Napi::Number::New(info.Env(), s == Cache::NONE ? -1.0 : (double)s);
+        });
+    }
+
+    Napi::Value Clear(const Napi::CallbackInfo& info) {
+        cache.clear();
+        return info.This();
+    }
+
+    Napi::Value Stats(const Napi::CallbackInfo& info) {
+        Napi::Object out = Napi::Object::New(info.Env());
+        out.Set("hits", cache.stats.hits);
+        out.Set("misses", cache.stats.misses);
+        out.Set("evictions", cache.stats.evictions);
+        out.Set("expired", cache.stats.expired);
+        out.Set("uncacheable", uncacheable);
+        out.Set("size", (double)cache.count());
+        out.Set("capacity", (double)cache.limit());
+        out.Set("policy", cache.mode() == Policy::LFU ? "lfu" : "lru");
+        out.Set("ttl", cache.ttlMs());
+        return out;
+    }
+};
+
+static Napi::String hex(Napi::Env env, uint64_t h) {
+    char out[16];
+    for (int i = 15; i >= 0; i--, h >>= 4) out[i] = "0123456789abcdef"[h & 15];
+    return Napi::String::New(env, out, 16);
+}
+
+// hash(...args) -> the 16 hex digit XXH64 of the arguments' canonical
+// encoding, the key MemoCache uses; undefined when they cannot be keyed
+static Napi::Value Hash(const Napi::CallbackInfo& info) {
+    return guard(info, [&]() -> Napi::Value {
+        std::string key;
+        if (!encodeArgs(key, info)) return info.Env().Undefined();
+        uint64_t h = xxh::hash64(key.data(), key.size());
+        return hex(info.Env(), h);
+    });
+}
+
+// xxh64(buffer | typedArray | string[, seed]) -> 16 hex digits; strings are
+// hashed as UTF-8
+static Napi::Value Xxh64(const Napi::CallbackInfo& info) {
+    return guard(info, [&] {
+        uint64_t seed = 0;
+        if (info.Length() > 1 && info[1].IsNumber()) seed = (uint64_t)info[1].As<Napi::Number>().Int64Value();
+        uint64_t h;
+        if (info[0].IsString()) {
+            std::string s = info[0].As<Napi::String>().Utf8Value();
+            h = xxh::hash64(s.data(), s.size(), seed);
+        } else if (info[0].IsTypedArray()) {
+            Napi::TypedArray t = info[0].As<Napi::TypedArray>();
+            h = xxh::hash64(static_cast<uint8_t*>(t.ArrayBuffer().Data()) + t.ByteOffset(), t.ByteLength(), seed);
+        } else if (info[0].IsArrayBuffer()) {
+            Napi::ArrayBuffer b = info[0].As<Napi::ArrayBuffer>();
+            h = xxh::hash64(b.Data(), b.ByteLength(), seed);
+        } else {
+            throw std::invalid_argument("xxh64 expects a string, typed array or ArrayBuffer");
+        }
+        return hex(info.Env(), h);
+    });
+}
+
+Napi::Object Init(Napi::Env env, Napi::Object exports) {
+    Napi::Object global = env.Global();
+    Napi::Function weakMap = global.Get("WeakMap").As<Napi::Function>(), map = global.Get("Map").As<Napi::Function>();
+    Napi::Object weakProto = weakMap.Get("prototype").As<Napi::Object>(), mapProto = map.Get("prototype").As<Napi::Object>();
+    Shared* s = new Shared();
+    s->mapCtor = Napi::Persistent(map);
+    s->setCtor = Napi::Persistent(global.Get("Set").As<Napi::Function>());
+    s->arrayFrom = Napi::Persistent(global.Get("Array").As<Napi::Object>().Get("from").As<Napi::Function>());
+    s->objectIds = Napi::Persistent(weakMap.New({}));
+    s->symbolIds = Napi::Persistent(map.New({}));
+    s->weakGet = Napi::Persistent(weakProto.Get("get").As<Napi::Function>());
+    s->weakSet = Napi::Persistent(weakProto.Get("set").As<Napi::Function>());
+    s->mapGet = Napi::Persistent(mapProto.Get("get").As<Napi::Function>());
+    s->mapSet = Napi::Persistent(mapProto.Get("set").As<Napi::Function>());
+    env.SetInstanceData(s);
+
+    exports.Set("MemoCache", MemoCache::Define(env));
+    exports.Set("hash", Napi::Function::New(env, Hash));
+    exports.Set("xxh64", Napi::Function::New(env, Xxh64));
+    return exports;
+}
+
+NODE_API_MODULE(memo, Init)
@@ -0,0 +1,190 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// A bounded map from encoded argument keys to slot numbers. The values
+// themselves stay on the JS side in an array indexed by slot, so nothing
+// here touches the JS heap. Entries live in one vector and are linked into
+// per-frequency lists: LRU keeps everything in frequency 0 and moves hits
+// to the front, LFU moves a hit to the front of the next frequency up and
+// evicts from the back of the lowest one. Expired entries are dropped when
+// they are looked up; ones never asked for again leave by normal eviction.
+
+enum class Policy { LRU, LFU };
+
+class Cache {
+public:
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+    struct Stats {
+        double hits = 0, misses = 0, evictions = 0, expired = 0;
+    };
+
+    Cache(size_t capacity = 10000, Policy policy = Policy::LRU, double ttlMs = 0)
+        : capacity(capacity), policy(policy), ttl(std::chrono::nanoseconds((int64_t)(ttlMs * 1e6))) {}
+
+    // Slot of a live entry, counting the hit or miss; a hit becomes the most
+    // recently (and, for LFU, more frequently) used.
+    uint32_t find(uint64_t hash, const std::string& key) {
+        uint32_t s = locate(hash, key);
+        if (s != NONE && ttl.count() > 0 && Clock::now() >= slots[s].expires) {
+            remove(s);
+            stats.expired++;
+            s = NONE;
+        }
+        if (s == NONE) {
+            stats.misses++;
+            return NONE;
+        }
+        stats.hits++;
+        touch(s);
+        return s;
+    }
+
+    // Adds key, evicting if full, and returns its slot; a key already present
+    // (stored again by a reentrant call) keeps its slot.
+    uint32_t insert(uint64_t hash, std::string key) {
+        uint32_t s = locate(hash, key);
+        if (s != NONE) {
+            refresh(s);
+            return s;
+        }
+        if (size >= capacity) evict();
+        if (free.empty()) {
+            s = (uint32_t)slots.size();
+            slots.emplace_back();
+        } else {
+            s = free.back();
+            free.pop_back();
+        }
+        Slot& e = slots[s];
+        e.hash = hash;
+        e.key = std::move(key);
+        e.freq = 0;
+        refresh(s);
+        link(s);
+        if (policy == Policy::LFU) minFreq = 0;
+        index.emplace(hash, s);
+        size++;
+        return s;
+    }
+
+    // Removes key; its former slot, or NONE.
+    uint32_t erase(uint64_t hash, const std::string& key) {
+        uint32_t s = locate(hash, key);
+        if (s != NONE) remove(s);
+        return s;
+    }
+
+    void clear() {
+        slots.clear();
+        free.clear();
+        index.clear();
+        lists.clear();
+        size = 0;
+        minFreq = 0;
+    }
+
+    size_t count() const { return size; }
+    size_t limit() const { return capacity; }
+    Policy mode() const { return policy; }
+    double ttlMs() const { return ttl.count() / 1e6; }
+
+    Stats stats;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Slot {
+        uint64_t hash = 0;
+        std::string key;
+        uint32_t prev = NONE, next = NONE, freq = 0;
+        Clock::time_point expires;
+    };
+    struct List {
+        uint32_t head = NONE, tail = NONE;
+    };
+
+    size_t capacity;
+    Policy policy;
+    std::chrono::nanoseconds ttl;
+    std::vector<Slot> slots;
+    std::vector<uint32_t> free;
+    std::unordered_multimap<uint64_t, uint32_t> index;
+    std::unordered_map<uint32_t, List> lists;   // by frequency
+    size_t size = 0;
+    uint32_t minFreq = 0;
+
+    uint32_t locate(uint64_t hash, const std::string& key) const {
+        auto range = index.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it)
+            if (slots[it->second].key == key) return it->second;
+        return NONE;
+    }
+
+    void refresh(uint32_t s) {
+        if (ttl.count() > 0) slots[s].expires = Clock::now() + ttl;
+    }
+
+    void link(uint32_t s) {
+        Slot& e = slots[s];
+        List& l = lists[e.freq];
+        e.prev = NONE;
+        e.next = l.head;
+        if (l.head != NONE) slots[l.head].prev = s;
+        l.head = s;
+        if (l.tail == NONE) l.tail = s;
+    }
+
+    // Returns whether the entry's list is now empty.
+    bool unlink(uint32_t s) {
+        Slot& e = slots[s];
+        List& l = lists[e.freq];
+        if (e.prev != NONE) slots[e.prev].next = e.next; else l.head = e.next;
+        if (e.next != NONE) slots[e.next].prev = e.prev; else l.tail = e.prev;
+        if (l.head != NONE) return false;
+        lists.erase(e.freq);
+        return true;
+    }
+
+    void touch(uint32_t s) {
+        Slot& e = slots[s];
+        if (policy == Policy::LRU) {
+            if (lists[0].head == s) return;
+            unlink(s);
+        } else {
+            if (unlink(s) && minFreq == e.freq) minFreq++;
+            if (e.freq < NONE - 1) e.freq++;
+        }
+        link(s);
+    }
+
+    void remove(uint32_t s) {
+        Slot& e = slots[s];
+        auto range = index.equal_range(e.hash);
+        for (auto it = range.first; it != range.second; ++it)
+            if (it->second == s) { index.erase(it); break; }
+        unlink(s);
+        e.key = std::string();
+        free.push_back(s);
+        size--;
+        // minFreq only has to be exact when evicting, which recomputes it
+    }
+
+    void evict() {
+        if (size == 0) return;
+        if (policy == Policy::LFU && !lists.count(minFreq)) {
+            minFreq = NONE;
+            for (auto& l : lists) if (l.first < minFreq) minFreq = l.first;
+        }
+        uint32_t victim = lists[policy == Policy::LFU ? minFreq : 0].tail;
+        if (ttl.count() > 0 && Clock::now() >= slots[victim].expires) stats.expired++;
+        else stats.evictions++;
+        remove(victim);
+    }
+};
@@ -2,6 +2,15 @@
 #include <ncurses.h>
 #include <string>
 #include <map>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
 
 std::map<int, WINDOW*> windowMap;
 int nextWinId = 1;
@@ -362,6 +371,208 @@ Napi::Value nodelayGetchWrapped(const Napi::CallbackInfo& info) {
     return Napi::Number::New(info.Env(), ch);
 }
 
+// ---------- Input Thread ----------
+// A dedicated thread sleeps in poll() on stdin (plus a wake pipe fed by SIGWINCH
+// and stopInput) and only tells the main thread that input is ready. All
+// ncurses calls stay on the main thread, which drains every pending key with
+// a non-blocking wgetch and hands the whole burst to the callback at once.
+struct InputPump {
+    std::thread thread;
+    Napi::ThreadSafeFunction tsfn;
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool pending = false;
+    std::atomic<bool> running{false};
+    int wake[2] = {-1, -1};
+    WINDOW* win = nullptr;
+};
+
+InputPump* inputPump = nullptr;
+struct sigaction prevWinch;
+
+void winchHandler(int sig) {
+    if (inputPump && inputPump->wake[1] >= 0) {
+        char b = 'r';
+        ssize_t n = write(inputPump->wake[1], &b, 1);
+        (void)n;
+    }
+    if (prevWinch.sa_flags & SA_SIGINFO) {
+        if (prevWinch.sa_sigaction) prevWinch.sa_sigaction(sig, nullptr, nullptr);
+    } else if (prevWinch.sa_handler != SIG_DFL && prevWinch.sa_handler != SIG_IGN) {
+        prevWinch.sa_handler(sig);
+    }
+}
+
+void drainInput(Napi::Env env, Napi::Function callback);
+
+void inputThreadMain(InputPump* pump) {
+    struct pollfd fds[2];
+    fds[0].fd = STDIN_FILENO;
+    fds[0].events = POLLIN;
+    fds[1].fd = pump->wake[0];
+    fds[1].events = POLLIN;
+
+    while (pump->running) {
+        fds[0].revents = fds[1].revents = 0;
+        if (poll(fds, 2, -1) < 0) continue; // EINTR
+
+        if (fds[1].revents & POLLIN) {
+            char buf[64];
+            while (read(pump->wake[0], buf, sizeof(buf)) > 0) {}
+        }
+        if (!pump->running) break;
+        if (fds[0].revents & (POLLHUP | POLLERR | POLLNVAL)) break;
+
+        // Hand the burst to the main thread and wait until it has been drained,
+        // so a readable stdin is never polled twice (no spinning).
+        std::unique_lock<std::mutex> lock(pump->mtx);
+        pump->pending = true;
+        napi_status st = pump->tsfn.NonBlockingCall([](Napi::Env env, Napi::Function cb) { drainInput(env, cb); });
+        if (st != napi_ok) break;
+        pump->cv.wait(lock, [pump] { return !pump->pending || !pump->running; });
+    }
+}
+
+// One wgetch result; a KEY_MOUSE carries the event getmouse returned for it.
+struct Input {
+    int ch;
+    bool mouse;
+    MEVENT me;
+};
+
+Napi::Object decodeKey(Napi::Env env, const Input& in) {
+    Napi::Object ev = Napi::Object::New(env);
+    if (in.ch == KEY_RESIZE) {
+        ev.Set("type", "resize");
+        ev.Set("lines", LINES);
+        ev.Set("cols", COLS);
+    } else if (in.ch == KEY_MOUSE) {
+        ev.Set("type", "mouse");
+        if (in.mouse) {
+            ev.Set("x", in.me.x);
+            ev.Set("y", in.me.y);
+            ev.Set("bstate", Napi::Number::New(env, (double)in.me.bstate));
+        }
+    } else {
+        ev.Set("type", "key");
+        ev.Set("key", in.ch);
+        const char* name = keyname(in.ch);
+        ev.Set("name", name ? name : "");
+    }
+    return ev;
+}
+
+bool isMotion(const Input& in) {
+    return in.ch == KEY_MOUSE && in.mouse && (in.me.bstate & REPORT_MOUSE_POSITION);
+}
+
+// Runs on the main thread: drain everything ncurses has buffered, coalescing
+// repeated resizes and runs of mouse motion into their latest occurrence.
+// Each KEY_MOUSE is read with getmouse as soon as it arrives, since ncurses
+// only holds the most recent mouse events.
+void drainInput(Napi::Env env, Napi::Function callback) {
+    InputPump* pump = inputPump;
+    if (!pump) return;
+
+    std::vector<Input> inputs;
+    int ch;
+    while ((ch = wgetch(pump->win)) != ERR) {
+        Input in{ch, false, {}};
+        if (ch == KEY_MOUSE) in.mouse = getmouse(&in.me) == OK;
+        if (!inputs.empty()) {
+            Input& last = inputs.back();
+            if (ch == KEY_RESIZE && last.ch == KEY_RESIZE) continue;
+            if (isMotion(in) && isMotion(last)) {
+                last = in;
+                continue;
+            }
+        }
+        inputs.push_back(in);
+    }
+
+    Napi::Array events = Napi::Array::New(env);
+    uint32_t n = 0;
+    for (const Input& in : inputs) events.Set(n++, decodeKey(env, in));
+
+    {
+        std::lock_guard<std::mutex> lock(pump->mtx);
+        pump->pending = false;
+    }
+    pump->cv.notify_one();
+
+    if (n > 0) callback.Call({ events });
+}
+
+Napi::Value stopInputWrapped(const Napi::CallbackInfo& info) {
+    InputPump* pump = inputPump;
+    if (!pump) return info.Env().Undefined();
+
+    {
+        std::lock_guard<std::mutex> lock(pump->mtx);
+        pump->running = false;
+    }
+    pump->cv.notify_one();
+    char b = 'q';
+    ssize_t w = write(pump->wake[1], &b, 1);
+    (void)w;
+    pump->thread.join();
+
+    sigaction(SIGWINCH, &prevWinch, nullptr);
+    inputPump = nullptr;
+    pump->tsfn.Release();
+    nodelay(pump->win, FALSE);
+    close(pump->wake[0]);
+    close(pump->wake[1]);
+    delete pump;
+    return info.Env().Undefined();
+}
+
+// startInput(callback[, winId]) -> callback(events) with events like
+// { type: 'key', key, name }, { type: 'mouse', x, y, bstate }, { type: 'resize', lines, cols }
+Napi::Value startInputWrapped(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 1 || !info[0].IsFunction()) {
+        Napi::TypeError::New(env, "Expected a callback").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    if (inputPump) stopInputWrapped(info);
+
+    WINDOW* win = stdscr;
+    if (info.Length() > 1 && info[1].IsNumber()) {
+        auto it = windowMap.find(info[1].As<Napi::Number>().Int32Value());
+        if (it != windowMap.end()) win = it->second;
+    }
+    if (!win) {
+        Napi::Error::New(env, "initscr must be called before startInput").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    auto* pump = new InputPump();
+    if (pipe(pump->wake) != 0) {
+        delete pump;
+        Napi::Error::New(env, "Failed to create wake pipe").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    fcntl(pump->wake[0], F_SETFL, O_NONBLOCK);
+    fcntl(pump->wake[1], F_SETFL, O_NONBLOCK);
+    pump->win = win;
+    keypad(win, TRUE);
+    nodelay(win, TRUE);
+
+    pump->tsfn = Napi::ThreadSafeFunction::New(env, info[0].As<Napi::Function>(), "ncursesInput", 0, 1);
+    pump->running = true;
+    inputPump = pump;
+
+    struct sigaction sa;
+    sa.sa_handler = winchHandler;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART;
+    sigaction(SIGWINCH, &sa, &prevWinch);
+
+    pump->thread = std::thread(inputThreadMain, pump);
+    return env.Undefined();
+}
+
 // ---------- Module Init ----------
 Napi::Object Init(Napi::Env env, Napi::Object exports) {
 exports.Set("enableMouse", Napi::Function::New(env, enableMouseWrapped));
@@ -369,6 +580,8 @@ exports.Set("mvaddch", Napi::Function::New(env, mvaddchWrapped));
 exports.Set("boxDefault", Napi::Function::New(env, boxDefaultWrapped));
 exports.Set("fullWin", Napi::Function::New(env, fullWinWrapped));
 exports.Set("nodelayGetch", Napi::Function::New(env, nodelayGetchWrapped));
+exports.Set("startInput", Napi::Function::New(env, startInputWrapped));
+exports.Set("stopInput", Napi::Function::New(env, stopInputWrapped));
 exports.Set("color_set", Napi::Function::New(env, color_setWrapped));
 // ---------- Pads ----------
 exports.Set("newpad", Napi::Function::New(env, wpadWrapped));
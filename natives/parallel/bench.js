@@ -0,0 +1,42 @@
+// Scaling of the built-in kernels from 1 to N pool threads.
+// usage: node bench.js [elements] [maxThreads]
+const os = require('os');
+const par = require('./index.js');
+
+const n = Number(process.argv[2]) || 1e7;
+const maxThreads = Number(process.argv[3]) || os.cpus().length;
+
+const data = new Float64Array(n);
+for (let i = 0; i < n; i++) data[i] = Math.sin(i) * 1000;
+
+function time(fn, reps = 3) {
+  let best = Infinity;
+  for (let r = 0; r < reps; r++) {
+    const t0 = process.hrtime.bigint();
+    fn();
+    best = Math.min(best, Number(process.hrtime.bigint() - t0) / 1e6);
+  }
+  return best;
+}
+
+const kernels = {
+  sum: () => par.sum(data),
+  minmax: () => par.minmax(data),
+  histogram: () => par.histogram(data, 64),
+  map: () => par.map(data, 'x * 2 + sqrt(abs(x))'),
+  sort: () => par.sort(Float64Array.from(data)),
+};
+
+const js = {
+  sum: () => { let s = 0; for (let i = 0; i < n; i++) s += data[i]; return s; },
+  sort: () => Float64Array.from(data).sort(),
+};
+
+console.log(`elements=${n}`);
+for (const name of Object.keys(js)) console.log(`js ${name.padEnd(10)} ${time(js[name]).toFixed(1)}ms`);
+
+for (let t = 1; t <= maxThreads; t++) {
+  par.setThreads(t);
+  const row = Object.entries(kernels).map(([name, fn]) => `${name}=${time(fn).toFixed(1)}ms`);
+  console.log(`threads=${t} ${row.join(' ')}`);
+}
@@ -0,0 +1,3 @@
+const addon = require('bindings')('parallel');
+
+module.exports = addon
@@ -0,0 +1,655 @@
+#include <napi.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <string>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <random>
+#include <utility>
+
+// ---------- Work-stealing pool ----------
+// Every worker owns a deque: it splits ranges by pushing the upper half to
+// the back of its own deque and keeps the lower half, and pops from the
+// back. Idle workers steal the oldest (largest) pieces from the front of
+// someone else's deque. Threads outside the pool inject work through a
+// shared queue and help execute it while they wait for a join.
+
+struct Kernel {
+    virtual ~Kernel() {}
+    virtual void run(size_t begin, size_t end) = 0;
+
+    size_t grain = 16384;
+    std::atomic<size_t> remaining{0};
+    std::mutex doneMtx;
+    std::condition_variable doneCv;
+};
+
+struct Chunk {
+    Kernel* kernel;
+    size_t begin;
+    size_t end;
+};
+
+class Pool {
+public:
+    explicit Pool(unsigned n) {
+        if (n == 0) n = 1;
+        for (unsigned i = 0; i < n; i++) queues.emplace_back(new Queue());
+        for (unsigned i = 0; i < n; i++) threads.emplace_back([this, i] { workerLoop((int)i); });
+    }
+
+    ~Pool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMtx);
+            stopping = true;
+        }
+        sleepCv.notify_all();
+        for (auto& t : threads) t.join();
+    }
+
+    size_t size() const { return threads.size(); }
+
+    // Runs kernel over [0, n) and returns once every element was processed.
+    void parallelFor(Kernel& k, size_t n) {
+        if (n == 0) return;
+        k.remaining = n;
+        execute({ &k, 0, n });
+        for (;;) {
+            Chunk c;
+            if (take(c)) { execute(c); continue; }
+            std::unique_lock<std::mutex> lock(k.doneMtx);
+            k.doneCv.wait(lock, [&k] { return k.remaining.load() == 0; });
+            return;
+        }
+    }
+
+private:
+    struct Queue {
+        std::mutex mtx;
+        std::deque<Chunk> items;
+    };
+
+    static thread_local int self;
+
+    void push(const Chunk& c) {
+        if (self >= 0) {
+            std::lock_guard<std::mutex> lock(queues[self]->mtx);
+            queues[self]->items.push_back(c);
+        } else {
+            std::lock_guard<std::mutex> lock(inject.mtx);
+            inject.items.push_back(c);
+        }
+        queued.fetch_add(1);
+        { std::lock_guard<std::mutex> lock(sleepMtx); }
+        sleepCv.notify_one();
+    }
+
+    bool popFront(Queue& q, Chunk& c) {
+        std::lock_guard<std::mutex> lock(q.mtx);
+        if (q.items.empty()) return false;
+        c = q.items.front();
+        q.items.pop_front();
+        return true;
+    }
+
+    bool take(Chunk& c) {
+        if (self >= 0) {
+            Queue& own = *queues[self];
+            std::lock_guard<std::mutex> lock(own.mtx);
+            if (!own.items.empty()) {
+                c = own.items.back();
+                own.items.pop_back();
+                queued.fetch_sub(1);
+                return true;
+            }
+        }
+        size_t n = queues.size();
+        size_t start = (size_t)(self >= 0 ? self + 1 : 0);
+        for (size_t k = 0; k < n; k++) {
+            size_t victim = (start + k) % n;
+            if ((int)victim == self) continue;
+            if (popFront(*queues[victim], c)) { queued.fetch_sub(1); return true; }
+        }
+        if (popFront(inject, c)) { queued.fetch_sub(1); return true; }
+        return false;
+    }
+
+    void execute(Chunk c) {
+        Kernel* k = c.kernel;
+        size_t b = c.begin, e = c.end;
+        while (e - b > k->grain) {
+            size_t mid = b + (e - b) / 2;
+            push({ k, mid, e });
+            e = mid;
+        }
+        k->run(b, e);
+        // Decrement under the lock so the joiner cannot free k while we notify.
+        std::lock_guard<std::mutex> lock(k->doneMtx);
+        if (k->remaining.fetch_sub(e - b) == e - b) k->doneCv.notify_all();
+    }
+
+    void workerLoop(int index) {
+        self = index;
+        for (;;) {
+            Chunk c;
+            if (take(c)) { execute(c); continue; }
+            std::unique_lock<std::mutex> lock(sleepMtx);
+            sleepCv.wait(lock, [this] { return stopping || queued.load() > 0; });
+            if (stopping) return;
+        }
+    }
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    Queue inject;
+    std::vector<std::thread> threads;
+    std::atomic<size_t> queued{0};
+    std::mutex sleepMtx;
+    std::condition_variable sleepCv;
+    bool stopping = false;
+};
+
+thread_local int Pool::self = -1;
+
+// setThreads swaps in a new pool while async jobs may still be running on
+// the old one, so every job takes its own reference when it starts and runs
+// all of its parallelFor calls on that; the old pool stops (and joins its
+// threads) when the last job using it lets go.
+std::shared_ptr<Pool> pool;
+std::mutex poolMtx;
+thread_local Pool* activePool = nullptr;
+
+std::shared_ptr<Pool> currentPool() {
+    std::lock_guard<std::mutex> lock(poolMtx);
+    return pool;
+}
+
+struct PoolScope {
+    Pool* saved;
+    explicit PoolScope(Pool* p) : saved(activePool) { activePool = p; }
+    ~PoolScope() { activePool = saved; }
+};
+
+template <typename F>
+struct FnKernel : Kernel {
+    F fn;
+    explicit FnKernel(F f, size_t g) : fn(std::move(f)) { grain = g ? g : 1; }
+    void run(size_t b, size_t e) override { fn(b, e); }
+};
+
+template <typename F>
+void parallelFor(size_t n, size_t grain, F fn) {
+    FnKernel<F> k(std::move(fn), grain);
+    activePool->parallelFor(k, n);
+}
+
+// Each leaf reduces its range to an Acc; leaves are then combined under a lock.
+template <typename Acc, typename Leaf, typename Combine>
+Acc parallelReduce(size_t n, size_t grain, Acc init, Leaf leaf, Combine combine) {
+    Acc total = init;
+    std::mutex mtx;
+    parallelFor(n, grain, [&](size_t b, size_t e) {
+        Acc part = leaf(b, e);
+        std::lock_guard<std::mutex> lock(mtx);
+        combine(total, part);
+    });
+    return total;
+}
+
+// ---------- Typed array views ----------
+struct View {
+    void* data = nullptr;
+    size_t length = 0;
+    napi_typedarray_type type = napi_float64_array;
+};
+
+View viewOf(Napi::Value v) {
+    if (!v.IsTypedArray()) throw std::invalid_argument("Expected a typed array");
+    Napi::TypedArray ta = v.As<Napi::TypedArray>();
+    View view;
+    view.data = static_cast<uint8_t*>(ta.ArrayBuffer().Data()) + ta.ByteOffset();
+    view.length = ta.ElementLength();
+    view.type = ta.TypedArrayType();
+    if (view.type == napi_bigint64_array || view.type == napi_biguint64_array)
+        throw std::invalid_argument("BigInt arrays are not supported");
+    return view;
+}
+
+template <typename F>
+auto dispatch(const View& v, F&& f) {
+    switch (v.type) {
+        case napi_int8_array: return f(static_cast<int8_t*>(v.data));
+        case napi_uint8_array: return f(static_cast<uint8_t*>(v.data));
+        case napi_uint8_clamped_array: return f(static_cast<uint8_t*>(v.data));
+        case napi_int16_array: return f(static_cast<int16_t*>(v.data));
+        case napi_uint16_array: return f(static_cast<uint16_t*>(v.data));
+        case napi_int32_array: return f(static_cast<int32_t*>(v.data));
+        case napi_uint32_array: return f(static_cast<uint32_t*>(v.data));
+        case napi_float32_array: return f(static_cast<float*>(v.data));
+        default: return f(static_cast<double*>(v.data));
+    }
+}
+
+// ---------- Expression compiler for map ----------
+// Compiles "x * 2 + sin(i)" into a postfix program over x (element) and i (index).
+enum class Op : uint8_t { Const, X, I, Add, Sub, Mul, Div, Mod, Pow, Neg, Call1, Call2 };
+
+struct Instr {
+    Op op;
+    double value = 0;
+    double (*fn1)(double) = nullptr;
+    double (*fn2)(double, double) = nullptr;
+};
+
+class ExprCompiler {
+public:
+    explicit ExprCompiler(const std::string& s) : src(s) {}
+
+    std::vector<Instr> compile() {
+        expr();
+        skip();
+        if (pos != src.size()) fail("unexpected '" + src.substr(pos, 1) + "'");
+        return prog;
+    }
+
+private:
+    const std::string& src;
+    size_t pos = 0;
+    std::vector<Instr> prog;
+
+    [[noreturn]] void fail(const std::string& why) { throw std::invalid_argument("map expression: " + why); }
+    void skip() { while (pos < src.size() && isspace((unsigned char)src[pos])) pos++; }
+    bool eat(char c) { skip(); if (pos < src.size() && src[pos] == c) { pos++; return true; } return false; }
+
+    void expr() {
+        term();
+        for (;;) {
+            if (eat('+')) { term(); prog.push_back({ Op::Add }); }
+            else if (eat('-')) { term(); prog.push_back({ Op::Sub }); }
+            else return;
+        }
+    }
+    void term() {
+        unary();
+        for (;;) {
+            if (eat('*')) { unary(); prog.push_back({ Op::Mul }); }
+            else if (eat('/')) { unary(); prog.push_back({ Op::Div }); }
+            else if (eat('%')) { unary(); prog.push_back({ Op::Mod }); }
+            else return;
+        }
+    }
+    void unary() {
+        if (eat('-')) { unary(); prog.push_back({ Op::Neg }); return; }
+        if (eat('+')) { unary(); return; }
+        power();
+    }
+    void power() {
+        primary();
+        if (eat('^')) { unary(); prog.push_back({ Op::Pow }); }
+    }
+    void primary() {
+        skip();
+        if (pos >= src.size()) fail("unexpected end");
+        char c = src[pos];
+        if (c == '(') { pos++; expr(); if (!eat(')')) fail("missing ')'"); return; }
+        if (isdigit((unsigned char)c) || c == '.') {
+            char* end = nullptr;
+            double v = strtod(src.c_str() + pos, &end);
+            pos = end - src.c_str();
+            prog.push_back({ Op::Const, v });
+            return;
+        }
+        if (isalpha((unsigned char)c) || c == '_') {
+            size_t start = pos;
+            while (pos < src.size() && (isalnum((unsigned char)src[pos]) || src[pos] == '_')) pos++;
+            std::string name = src.substr(start, pos - start);
+            if (name == "x") { prog.push_back({ Op::X }); return; }
+            if (name == "i") { prog.push_back({ Op::I }); return; }
+            if (name == "PI") { prog.push_back({ Op::Const, M_PI }); return; }
+            if (name == "E") { prog.push_back({ Op::Const, M_E }); return; }
+            call(name);
+            return;
+        }
+        fail("unexpected '" + std::string(1, c) + "'");
+    }
+    void call(const std::string& name) {
+        static const std::pair<const char*, double (*)(double)> unaries[] = {
+            { "sqrt", [](double a) { return std::sqrt(a); } }, { "abs", [](double a) { return std::fabs(a); } },
+            { "sin", [](double a) { return std::sin(a); } },   { "cos", [](double a) { return std::cos(a); } },
+            { "tan", [](double a) { return std::tan(a); } },   { "exp", [](double a) { return std::exp(a); } },
+            { "log", [](double a) { return std::log(a); } },   { "floor", [](double a) { return std::floor(a); } },
+            { "ceil", [](double a) { return std::ceil(a); } }, { "round", [](double a) { return std::round(a); } },
+        };
+        static const std::pair<const char*, double (*)(double, double)> binaries[] = {
+            { "min", [](double a, double b) { return std::fmin(a, b); } },
+            { "max", [](double a, double b) { return std::fmax(a, b); } },
+            { "pow", [](double a, double b) { return std::pow(a, b); } },
+        };
+        if (!eat('(')) fail("unknown name '" + name + "'");
+        for (auto& u : unaries) {
+            if (name == u.first) {
+                expr();
+                if (!eat(')')) fail("missing ')'");
+                Instr in{ Op::Call1 };
+                in.fn1 = u.second;
+                prog.push_back(in);
+                return;
+            }
+        }
+        for (auto& b : binaries) {
+            if (name == b.first) {
+                expr();
+                if (!eat(',')) fail(name + " takes two arguments");
+                expr();
+                if (!eat(')')) fail("missing ')'");
+                Instr in{ Op::Call2 };
+                in.fn2 = b.second;
+                prog.push_back(in);
+                return;
+            }
+        }
+        fail("unknown function '" + name + "'");
+    }
+};
+
+inline double evalProgram(const std::vector<Instr>& prog, double x, double i) {
+    double st[64];
+    int sp = 0;
+    for (const Instr& in : prog) {
+        switch (in.op) {
+            case Op::Const: st[sp++] = in.value; break;
+            case Op::X: st[sp++] = x; break;
+            case Op::I: st[sp++] = i; break;
+            case Op::Add: sp--; st[sp - 1] += st[sp]; break;
+            case Op::Sub: sp--; st[sp - 1] -= st[sp]; break;
+            case Op::Mul: sp--; st[sp - 1] *= st[sp]; break;
+            case Op::Div: sp--; st[sp - 1] /= st[sp]; break;
+            case Op::Mod: sp--; st[sp - 1] = std::fmod(st[sp - 1], st[sp]); break;
+            case Op::Pow: sp--; st[sp - 1] = std::pow(st[sp - 1], st[sp]); break;
+            case Op::Neg: st[sp - 1] = -st[sp - 1]; break;
+            case Op::Call1: st[sp - 1] = in.fn1(st[sp - 1]); break;
+            case Op::Call2: sp--; st[sp - 1] = in.fn2(st[sp - 1], st[sp]); break;
+        }
+    }
+    return st[0];
+}
+
+size_t stackDepth(const std::vector<Instr>& prog) {
+    int sp = 0, max = 0;
+    for (const Instr& in : prog) {
+        switch (in.op) {
+            case Op::Const: case Op::X: case Op::I: sp++; break;
+            case Op::Neg: case Op::Call1: break;
+            default: sp--; break;
+        }
+        max = std::max(max, sp);
+    }
+    return max;
+}
+
+// ---------- Kernels ----------
+double sumKernel(const View& v) {
+    return dispatch(v, [&](auto* p) {
+        return parallelReduce(v.length, 65536, 0.0,
+            [p](size_t b, size_t e) { double s = 0; for (size_t i = b; i < e; i++) s += p[i]; return s; },
+            [](double& acc, double part) { acc += part; });
+    });
+}
+
+struct MinMax {
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+};
+
+MinMax minMaxKernel(const View& v) {
+    return dispatch(v, [&](auto* p) {
+        return parallelReduce(v.length, 65536, MinMax(),
+            [p](size_t b, size_t e) {
+                MinMax m;
+                for (size_t i = b; i < e; i++) {
+                    double x = p[i];
+                    if (x < m.min) m.min = x;
+                    if (x > m.max) m.max = x;
+                }
+                return m;
+            },
+            [](MinMax& acc, const MinMax& part) {
+                acc.min = std::min(acc.min, part.min);
+                acc.max = std::max(acc.max, part.max);
+            });
+    });
+}
+
+std::vector<uint32_t> histogramKernel(const View& v, size_t bins, double lo, double hi) {
+    using Hist = std::vector<uint32_t>;
+    double scale = hi > lo ? bins / (hi - lo) : 0;
+    return dispatch(v, [&](auto* p) {
+        return parallelReduce(v.length, 65536, Hist(bins, 0),
+            [=](size_t b, size_t e) {
+                Hist h(bins, 0);
+                for (size_t i = b; i < e; i++) {
+                    double x = p[i];
+                    if (!(x >= lo && x <= hi)) continue;
+                    size_t bin = (size_t)((x - lo) * scale);
+                    h[bin < bins ? bin : bins - 1]++;
+                }
+                return h;
+            },
+            [bins](Hist& acc, const Hist& part) { for (size_t k = 0; k < bins; k++) acc[k] += part[k]; });
+    });
+}
+
+void mapKernel(const View& src, const View& dst, const std::vector<Instr>& prog) {
+    dispatch(src, [&](auto* in) {
+        dispatch(dst, [&](auto* out) {
+            using Out = std::remove_pointer_t<decltype(out)>;
+            parallelFor(src.length, 8192, [&](size_t b, size_t e) {
+                for (size_t i = b; i < e; i++) out[i] = static_cast<Out>(evalProgram(prog, (double)in[i], (double)i));
+            });
+            return 0;
+        });
+        return 0;
+    });
+}
+
+// Sorts equal runs in parallel, then merges neighbouring runs in rounds.
+void sortKernel(const View& v) {
+    dispatch(v, [&](auto* p) {
+        using T = std::remove_pointer_t<decltype(p)>;
+        auto less = [](T a, T b) {
+            if constexpr (std::is_floating_point_v<T>) return a < b || (a == a && b != b); // NaN last
+            else return a < b;
+        };
+        size_t n = v.length;
+        size_t runs = std::max<size_t>(1, std::min<size_t>(activePool->size() * 4, n / 4096));
+        size_t width = (n + runs - 1) / runs;
+        parallelFor(runs, 1, [&](size_t b, size_t e) {
+            for (size_t r = b; r < e; r++) {
+                size_t lo = std::min(n, r * width), hi = std::min(n, lo + width);
+                std::sort(p + lo, p + hi, less);
+            }
+        });
+        for (; width < n; width *= 2) {
+            size_t pairs = (n + 2 * width - 1) / (2 * width);
+            parallelFor(pairs, 1, [&](size_t b, size_t e) {
+                for (size_t k = b; k < e; k++) {
+                    size_t lo = k * 2 * width, mid = std::min(n, lo + width), hi = std::min(n, lo + 2 * width);
+                    if (mid < hi) std::inplace_merge(p + lo, p + mid, p + hi, less);
+                }
+            });
+        }
+        return 0;
+    });
+}
+
+// ---------- JS bindings ----------
+// Every kernel has a synchronous form (the JS thread helps and joins) and an
+// *Async form that runs on a libuv worker and resolves a Promise.
+class KernelWorker : public Napi::AsyncWorker {
+public:
+    KernelWorker(Napi::Env env, std::function<void()> work, std::function<Napi::Value(Napi::Env)> result)
+        : Napi::AsyncWorker(env), deferred(Napi::Promise::Deferred::New(env)), work(std::move(work)), result(std::move(result)) {}
+
+    void Keep(Napi::Value v) { if (v.IsObject()) kept.push_back(Napi::Persistent(v.As<Napi::Object>())); }
+    Napi::Promise Promise() { return deferred.Promise(); }
+
+    void Execute() override {
+        try { work(); } catch (const std::exception& e) { SetError(e.what()); }
+    }
+    void OnOK() override { deferred.Resolve(result(Env())); }
+    void OnError(const Napi::Error& e) override { deferred.Reject(e.Value()); }
+
+private:
+    Napi::Promise::Deferred deferred;
+    std::function<void()> work;
+    std::function<Napi::Value(Napi::Env)> result;
+    std::vector<Napi::ObjectReference> kept;   // keeps typed arrays alive while workers use them
+};
+
+Napi::Value finish(const Napi::CallbackInfo& info, bool async, std::function<void()> kernel,
+                   std::function<Napi::Value(Napi::Env)> result) {
+    Napi::Env env = info.Env();
+    std::function<void()> work = [p = currentPool(), kernel = std::move(kernel)] {
+        PoolScope scope(p.get());
+        kernel();
+    };
+    if (!async) {
+        try { work(); } catch (const std::exception& e) {
+            Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+            return env.Undefined();
+        }
+        return result(env);
+    }
+    auto* worker = new KernelWorker(env, std::move(work), std::move(result));
+    for (size_t i = 0; i < info.Length(); i++) worker->Keep(info[i]);
+    Napi::Promise promise = worker->Promise();
+    worker->Queue();
+    return promise;
+}
+
+Napi::Value throwError(Napi::Env env, const std::exception& e) {
+    Napi::TypeError::New(env, e.what()).ThrowAsJavaScriptException();
+    return env.Undefined();
+}
+
+// sum(typedArray)
+Napi::Value Sum(const Napi::CallbackInfo& info, bool async) {
+    try {
+        View v = viewOf(info[0]);
+        auto total = std::make_shared<double>(0);
+        return finish(info, async, [v, total] { *total = sumKernel(v); },
+                      [total](Napi::Env env) { return Napi::Number::New(env, *total); });
+    } catch (const std::exception& e) { return throwError(info.Env(), e); }
+}
+
+// minmax(typedArray) -> { min, max }
+Napi::Value MinMaxFn(const Napi::CallbackInfo& info, bool async) {
+    try {
+        View v = viewOf(info[0]);
+        auto out = std::make_shared<MinMax>();
+        return finish(info, async, [v, out] { *out = minMaxKernel(v); }, [out](Napi::Env env) {
+            Napi::Object res = Napi::Object::New(env);
+            res.Set("min", out->min);
+            res.Set("max", out->max);
+            return res;
+        });
+    } catch (const std::exception& e) { return throwError(info.Env(), e); }
+}
+
+// histogram(typedArray, bins[, lo, hi]) -> Uint32Array(bins)
+Napi::Value Histogram(const Napi::CallbackInfo& info, bool async) {
+    try {
+        View v = viewOf(info[0]);
+        size_t bins = info.Length() > 1 && info[1].IsNumber() ? info[1].As<Napi::Number>().Uint32Value() : 10;
+        if (bins == 0) throw std::invalid_argument("bins must be positive");
+        bool ranged = info.Length() > 3 && info[2].IsNumber() && info[3].IsNumber();
+        double lo = ranged ? info[2].As<Napi::Number>().DoubleValue() : 0;
+        double hi = ranged ? info[3].As<Napi::Number>().DoubleValue() : 0;
+        auto out = std::make_shared<std::vector<uint32_t>>();
+        return finish(info, async, [=] {
+            double l = lo, h = hi;
+            if (!ranged) { MinMax m = minMaxKernel(v); l = m.min; h = m.max; }
+            *out = histogramKernel(v, bins, l, h);
+        }, [out](Napi::Env env) {
+            Napi::Uint32Array res = Napi::Uint32Array::New(env, out->size());
+            std::copy(out->begin(), out->end(), res.Data());
+            return res;
+        });
+    } catch (const std::exception& e) { return throwError(info.Env(), e); }
+}
+
+// map(typedArray, "x * 2 + 1"[, dst]) -> dst (a new Float64Array by default)
+Napi::Value Map(const Napi::CallbackInfo& info, bool async) {
+    Napi::Env env = info.Env();
+    try {
+        View src = viewOf(info[0]);
+        if (info.Length() < 2 || !info[1].IsString()) throw std::invalid_argument("Expected an expression string");
+        auto prog = std::make_shared<std::vector<Instr>>(ExprCompiler(info[1].As<Napi::String>().Utf8Value()).compile());
+        if (stackDepth(*prog) > 64) throw std::invalid_argument("map expression is too deeply nested");
+        Napi::Value dstVal = info.Length() > 2 && info[2].IsTypedArray()
+            ? info[2] : Napi::Value(Napi::Float64Array::New(env, src.length));
+        View dst = viewOf(dstVal);
+        if (dst.length < src.length) throw std::invalid_argument("Destination array is too short");
+        auto ref = std::make_shared<Napi::ObjectReference>(Napi::Persistent(dstVal.As<Napi::Object>()));
+        return finish(info, async, [src, dst, prog] { mapKernel(src, dst, *prog); },
+                      [ref](Napi::Env) { return ref->Value(); });
+    } catch (const std::exception& e) { return throwError(env, e); }
+}
+
+// sort(typedArray) -> the same array, sorted in place
+Napi::Value Sort(const Napi::CallbackInfo& info, bool async) {
+    try {
+        View v = viewOf(info[0]);
+        auto ref = std::make_shared<Napi::ObjectReference>(Napi::Persistent(info[0].As<Napi::Object>()));
+        return finish(info, async, [v] { sortKernel(v); }, [ref](Napi::Env) { return ref->Value(); });
+    } catch (const std::exception& e) { return throwError(info.Env(), e); }
+}
+
+Napi::Value Threads(const Napi::CallbackInfo& info) {
+    return Napi::Number::New(info.Env(), (double)currentPool()->size());
+}
+
+// setThreads(n): resize the pool (0 = one per core). Jobs already running
+// finish on the old pool.
+Napi::Value SetThreads(const Napi::CallbackInfo& info) {
+    unsigned n = info.Length() > 0 ? info[0].As<Napi::Number>().Uint32Value() : 0;
+    if (n == 0) n = std::thread::hardware_concurrency();
+    auto next = std::make_shared<Pool>(n);
+    std::shared_ptr<Pool> old;
+    {
+        std::lock_guard<std::mutex> lock(poolMtx);
+        old = std::exchange(pool, next);
+    }
+    return Napi::Number::New(info.Env(), (double)next->size());
+}
+
+template <Napi::Value (*F)(const Napi::CallbackInfo&, bool)>
+void exportKernel(Napi::Env env, Napi::Object exports, const char* name) {
+    exports.Set(name, Napi::Function::New(env, [](const Napi::CallbackInfo& info) { return F(info, false); }));
+    exports.Set(std::string(name) + "Async", Napi::Function::New(env, [](const Napi::CallbackInfo& info) { return F(info, true); }));
+}
+
+Napi::Object Init(Napi::Env env, Napi::Object exports) {
+    {
+        std::lock_guard<std::mutex> lock(poolMtx);
+        if (!pool) pool = std::make_shared<Pool>(std::thread::hardware_concurrency());
+    }
+
+    exportKernel<Sum>(env, exports, "sum");
+    exportKernel<MinMaxFn>(env, exports, "minmax");
+    exportKernel<Histogram>(env, exports, "histogram");
+    exportKernel<Map>(env, exports, "map");
+    exportKernel<Sort>(env, exports, "sort");
+    exports.Set("threads", Napi::Function::New(env, Threads));
+    exports.Set("setThreads", Napi::Function::New(env, SetThreads));
+    return exports;
+}
+
+NODE_API_MODULE(parallel, Init)
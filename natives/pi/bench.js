@@ -0,0 +1,29 @@
+// Times pi(digits) and checks the result against known digits: the last ten
+// decimals and a SHA-256 prefix of the whole "3.14..." string per size.
+// usage: node bench.js [maxDigits] [threads]
+const crypto = require('crypto');
+const { pi } = require('./index.js');
+
+const known = {
+  1000: ['2164201989', '823a2e34f63c5d5f'],
+  10000: ['5256375678', '452304d0e15d9e9f'],
+  100000: ['5493624646', '6fba00bd4d732bf5'],
+  1000000: ['5779458151', 'dd382ef6a0c1e8d9'],
+};
+
+const max = Number(process.argv[2]) || 1000000;
+const threads = Number(process.argv[3]) || 0;
+let failed = false;
+
+for (const [n, [tail, hash]] of Object.entries(known)) {
+  const digits = Number(n);
+  if (digits > max) break;
+  const t0 = process.hrtime.bigint();
+  const s = pi(digits, threads ? { threads } : {});
+  const ms = Number(process.hrtime.bigint() - t0) / 1e6;
+  const ok = s.length === digits + 2 && s.endsWith(tail)
+    && crypto.createHash('sha256').update(s).digest('hex').startsWith(hash);
+  if (!ok) failed = true;
+  console.log(`${String(digits).padStart(8)} digits ${ms.toFixed(0).padStart(7)} ms  ...${s.slice(-10)}  ${ok ? 'ok' : 'WRONG'}`);
+}
+process.exitCode = failed ? 1 : 0;
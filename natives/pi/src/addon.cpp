@@ -1,115 +1,276 @@
 #include <napi.h>
-#include <vector>
-#include <string>
-#include <sstream>
-#include <iomanip>
-#include <cstdint>
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
-Napi::Value Pi(const Napi::CallbackInfo& info) {
-    Napi::Env env = info.Env();
-    int digits = info[0].As<Napi::Number>().Int32Value();
-
-    // --- BigDecimal block representation ---
-    struct Big {
-        std::vector<uint32_t> blocks; // each block = 9 digits
-        int block_size = 9;
-
-        Big(uint32_t val=0) { if(val) blocks.push_back(val); }
-
-        void multiply(uint32_t x) {
-            uint64_t carry=0;
-            for(auto &b:blocks){
-                uint64_t prod = uint64_t(b)*x+carry;
-                b = prod%1000000000;
-                carry = prod/1000000000;
-            }
-            while(carry){
-                blocks.push_back(carry%1000000000);
-                carry/=1000000000;
-            }
-        }
+#include "../../decimal/src/limbs.h"
 
-        void multiply(const Big &other){
-            std::vector<uint32_t> res(blocks.size()+other.blocks.size(),0);
-            for(size_t i=0;i<blocks.size();i++){
-                uint64_t carry=0;
-                for(size_t j=0;j<other.blocks.size();j++){
-                    uint64_t sum = uint64_t(blocks[i])*other.blocks[j]+res[i+j]+carry;
-                    res[i+j] = sum%1000000000;
-                    carry = sum/1000000000;
-                }
-                if(carry) res[i+other.blocks.size()] += carry;
-            }
-            blocks = res;
-            while(blocks.size()>1 && blocks.back()==0) blocks.pop_back();
-        }
+// Digits of pi: Chudnovsky series summed by binary splitting.
+//
+// Integers are little-endian vectors of base-1e9 limbs (limbs.h in the
+// decimal addon, which shares this arithmetic), so the final
+// fixed-point value turns into decimal digits without a radix conversion.
+// Multiplication is schoolbook, Karatsuba or a three-prime NTT (recombined
+// with CRT) depending on the operand sizes. Division and the square root
+// are Newton iterations on top of it that double their precision per step,
+// so both cost a small multiple of one full-size multiplication.
+//
+// Binary splitting gives P, Q, T over [0, N) with
+//     pi = 426880 * sqrt(10005) * Q / T;
+// its upper levels run on separate threads. Q and T are cut down to the
+// working precision before the final division.
 
-        void add(const Big &other){
-            size_t n = std::max(blocks.size(),other.blocks.size());
-            blocks.resize(n,0);
-            uint64_t carry=0;
-            for(size_t i=0;i<n;i++){
-                uint64_t sum = uint64_t(blocks[i])+(i<other.blocks.size()?other.blocks[i]:0)+carry;
-                blocks[i] = sum%1000000000;
-                carry = sum/1000000000;
-            }
-            if(carry) blocks.push_back(carry);
-        }
+static const double kDigitsPerTerm = 14.181647462725477;  // log10(640320^3 / 1728)
+
+// floor(n / d), d non-zero
+static Limbs divide(const Limbs& n, const Limbs& d) {
+    if (cmp(n, d) < 0) return Limbs();
+    if (d.size() == 1) { Limbs q = n; divSmall(q, d[0]); return q; }
+    size_t k = n.size() - d.size() + 2;
+    // reciprocal(d, k) ~ B^(k + |d|) / d either way top() pads or cuts d
+    Limbs q = shr(mul(n, reciprocal(d, k)), k + d.size());
+    Limbs qd = mul(q, d);
+    while (cmp(qd, n) > 0) { subFrom(q, Limbs{1}); subFrom(qd, d); }
+    Limbs r = sub(n, qd);
+    while (cmp(r, d) >= 0) { addTo(q, Limbs{1}); subFrom(r, d); }
+    return q;
+}
+
+// Y ~ B^k / sqrt(v), within a few units: Newton on the inverse square root,
+// Y += Y (B^2k - v Y^2) / (2 B^2k), which needs no division.
+static Limbs invSqrt(uint32_t v, size_t k) {
+    if (k <= 2) {
+        Limbs y = fromU64(static_cast<uint64_t>(1e18 / std::sqrt(static_cast<double>(v))));
+        return shr(y, 2 - k);
+    }
+    size_t h = k / 2 + 1;
+    Limbs y = shl(invSqrt(v, h), k - h);
+    Limbs vy2 = mul(y, y);
+    mulSmall(vy2, v);
+    Limbs pk = power(2 * k);
+    bool under = cmp(vy2, pk) <= 0;
+    Limbs c = shr(mul(y, under ? sub(pk, vy2) : sub(vy2, pk)), 2 * k);
+    divSmall(c, 2);
+    if (under) addTo(y, c);
+    else { addTo(c, Limbs{1}); subFrom(y, c); }
+    return y;
+}
+
+// ---------- binary splitting ----------
+
+struct Signed {
+    Limbs mag;
+    bool neg = false;
+};
+
+static Signed mulS(const Signed& a, const Signed& b) {
+    Signed r;
+    r.mag = mul(a.mag, b.mag);
+    r.neg = !r.mag.empty() && a.neg != b.neg;
+    return r;
+}
+
+static Signed addS(Signed a, const Signed& b) {
+    if (a.neg == b.neg) { addTo(a.mag, b.mag); return a; }
+    if (cmp(a.mag, b.mag) >= 0) { subFrom(a.mag, b.mag); }
+    else { a.mag = sub(b.mag, a.mag); a.neg = b.neg; }
+    if (a.mag.empty()) a.neg = false;
+    return a;
+}
+
+struct PQT {
+    Signed p, q, t;
+};
 
-        void divide(uint32_t x){
-            uint64_t rem=0;
-            for(int i=blocks.size()-1;i>=0;i--){
-                uint64_t cur = blocks[i]+rem*1000000000ULL;
-                blocks[i] = cur/x;
-                rem = cur%x;
-            }
-            while(blocks.size()>1 && blocks.back()==0) blocks.pop_back();
+// 640320^3 / 24
+static const uint64_t kC3Over24 = 10939058860032000ULL;
+
+static PQT split(uint64_t a, uint64_t b, unsigned threads, bool needP) {
+    PQT r;
+    if (b - a == 1) {
+        if (a == 0) {
+            r.p.mag = r.q.mag = Limbs{1};
+            r.t.mag = fromU64(13591409);
+            return r;
         }
+        r.p.mag = fromU64((6 * a - 5) * (2 * a - 1));
+        mulSmall(r.p.mag, static_cast<uint32_t>(6 * a - 1));
+        r.p.neg = true;
+        r.q.mag = fromU64(kC3Over24);
+        mulSmall(r.q.mag, static_cast<uint32_t>(a));
+        mulSmall(r.q.mag, static_cast<uint32_t>(a));
+        mulSmall(r.q.mag, static_cast<uint32_t>(a));
+        r.t = r.p;
+        Limbs term = fromU64(13591409 + 545140134 * a);
+        r.t.mag = mul(r.t.mag, term);
+        return r;
+    }
+    uint64_t m = (a + b) / 2;
+    PQT left, right;
+    if (threads > 1) {
+        auto job = std::async(std::launch::async, split, a, m, threads / 2, true);
+        right = split(m, b, threads - threads / 2, needP);
+        left = job.get();
+    } else {
+        left = split(a, m, 1, true);
+        right = split(m, b, 1, needP);
+    }
+    if (threads > 1) {
+        auto q = std::async(std::launch::async, mulS, std::cref(left.q), std::cref(right.q));
+        r.t = addS(mulS(left.t, right.q), mulS(left.p, right.t));
+        if (needP) r.p = mulS(left.p, right.p);
+        r.q = q.get();
+    } else {
+        r.t = addS(mulS(left.t, right.q), mulS(left.p, right.t));
+        if (needP) r.p = mulS(left.p, right.p);
+        r.q = mulS(left.q, right.q);
+    }
+    return r;
+}
 
-        std::string toString(int decimalDigits){
-            std::ostringstream oss;
-            oss<<blocks.back();
-            for(int i=blocks.size()-2;i>=0;i--) oss<<std::setw(9)<<std::setfill('0')<<blocks[i];
-            std::string s = oss.str();
-            if(decimalDigits < (int)s.size()) s = s.substr(0,decimalDigits+1);
-            s.insert(1,".");
-            return s;
+// pi * B^w, truncated; the integer part is the top limb.
+static Limbs piFixed(size_t digits, unsigned threads) {
+    size_t w = digits / kBaseDigits + 3;  // two guard limbs
+    uint64_t terms = static_cast<uint64_t>(digits / kDigitsPerTerm) + 2;
+    PQT s = split(0, terms, std::max(1u, threads), false);
+
+    // pi = 426880 sqrt(10005) Q / T; keep w + 2 limbs of T and Q alongside
+    Limbs& t = s.t.mag;
+    size_t cut = t.size() > w + 2 ? t.size() - (w + 2) : 0;
+    Limbs q = shr(s.q.mag, cut), tt = shr(t, cut);
+
+    Limbs root = invSqrt(10005, w + 1);                 // sqrt(10005) B^w = 10005 B^w / sqrt(10005)
+    mulSmall(root, 10005);
+    root = shr(root, 1);
+    Limbs num = mul(q, root);
+    mulSmall(num, 426880);
+    return divide(num, tt);
+}
+
+// ---------- output ----------
+
+static const size_t kChunk = 64 * 1024;
+
+// Calls emit() with consecutive pieces of "3.14159..." (digits decimals).
+template <typename Emit>
+static void forEachChunk(const Limbs& fixed, size_t digits, Emit emit) {
+    size_t w = fixed.size() - 1;
+    std::string buf = std::to_string(fixed[w]) + (digits ? "." : "");
+    char limb[kBaseDigits + 1];
+    size_t left = digits;
+    for (size_t i = w; i-- > 0 && left;) {
+        snprintf(limb, sizeof limb, "%09u", fixed[i]);
+        size_t n = std::min<size_t>(kBaseDigits, left);
+        buf.append(limb, n);
+        left -= n;
+        if (buf.size() >= kChunk) { emit(buf); buf.clear(); }
+    }
+    if (!buf.empty()) emit(buf);
+}
+
+struct PiOptions {
+    size_t digits = 0;
+    unsigned threads = 0;
+    bool print = false;
+};
+
+static std::string computePi(const PiOptions& o) {
+    unsigned threads = o.threads ? o.threads : std::max(1u, std::thread::hardware_concurrency());
+    Limbs fixed = piFixed(o.digits, threads);
+    std::string out;
+    if (o.print) {
+        forEachChunk(fixed, o.digits, [](const std::string& s) { fwrite(s.data(), 1, s.size(), stdout); });
+        fflush(stdout);
+    } else {
+        out.reserve(o.digits + 2);
+        forEachChunk(fixed, o.digits, [&](const std::string& s) { out += s; });
+    }
+    return out;
+}
+
+static bool parseOptions(const Napi::CallbackInfo& info, PiOptions& o) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 1 || !info[0].IsNumber() || info[0].As<Napi::Number>().DoubleValue() < 0) {
+        Napi::TypeError::New(env, "Expected a digit count").ThrowAsJavaScriptException();
+        return false;
+    }
+    o.digits = static_cast<size_t>(info[0].As<Napi::Number>().Int64Value());
+    if (info.Length() > 1 && info[1].IsObject()) {
+        Napi::Object opts = info[1].As<Napi::Object>();
+        if (opts.Get("threads").IsNumber()) o.threads = opts.Get("threads").As<Napi::Number>().Uint32Value();
+        if (opts.Get("print").IsBoolean()) o.print = opts.Get("print").As<Napi::Boolean>();
+    }
+    return true;
+}
+
+// pi(digits, { threads = cores, print = false }) -> "3.1415..." with that
+// many decimals (truncated). print streams the digits to stdout in 64 KB
+// writes instead and returns the count.
+Napi::Value Pi(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    PiOptions o;
+    if (!parseOptions(info, o)) return env.Undefined();
+    std::string s;
+    try {
+        s = computePi(o);
+    } catch (const std::exception& e) {
+        Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    if (o.print) return Napi::Number::New(env, static_cast<double>(o.digits));
+    return Napi::String::New(env, s);
+}
+
+// piAsync(digits, opts) runs on a libuv worker and resolves a Promise.
+class PiWorker : public Napi::AsyncWorker {
+public:
+    PiWorker(Napi::Env env, PiOptions o)
+        : Napi::AsyncWorker(env), deferred(Napi::Promise::Deferred::New(env)), o(o) {}
+
+    Napi::Promise Promise() { return deferred.Promise(); }
+
+    void Execute() override {
+        try {
+            result = computePi(o);
+        } catch (const std::exception& e) {
+            SetError(e.what());
         }
-    };
-
-    // --- Factorial helper ---
-    auto factorial = [&](int n) -> Big {
-        Big res(1);
-        for(int i=2;i<=n;i++) res.multiply(i);
-        return res;
-    };
-
-    // --- Chudnovsky sum ---
-    int terms = digits/14+1;
-    Big sum(0);
-    for(int k=0;k<terms;k++){
-        Big num = factorial(6*k);
-        Big den = factorial(3*k);
-        Big kfact = factorial(k);
-        kfact.multiply(kfact);
-        kfact.multiply(kfact); // k!^3
-        den.multiply(kfact);
-        if(k%2) num.multiply(-1);
-        Big term(545140134*k+13591409);
-        num.multiply(term);
-        num.divide(den.blocks.back()); // simple integer division
-        sum.add(num);
     }
+    void OnOK() override {
+        if (o.print) deferred.Resolve(Napi::Number::New(Env(), static_cast<double>(o.digits)));
+        else deferred.Resolve(Napi::String::New(Env(), result));
+    }
+    void OnError(const Napi::Error& e) override { deferred.Reject(e.Value()); }
 
-    // multiply by constant 426880*sqrt(10005) ~ 42692725
-    sum.multiply(42692725);
+private:
+    Napi::Promise::Deferred deferred;
+    PiOptions o;
+    std::string result;
+};
 
-    return Napi::String::New(env,sum.toString(digits));
+Napi::Value PiAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    PiOptions o;
+    if (!parseOptions(info, o)) return env.Undefined();
+    auto* worker = new PiWorker(env, o);
+    Napi::Promise promise = worker->Promise();
+    worker->Queue();
+    return promise;
 }
 
 Napi::Object Init(Napi::Env env, Napi::Object exports){
-    exports.Set("pi", Napi::Function::New(env,Pi));
+    exports.Set("pi", Napi::Function::New(env, Pi));
+    exports.Set("piAsync", Napi::Function::New(env, PiAsync));
     return exports;
 }
 
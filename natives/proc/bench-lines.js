@@ -0,0 +1,46 @@
+// Counts the lines of a file with readFileSync + split and with fileLines,
+// reporting time and RSS growth.
+// usage: node bench-lines.js [megabytes]
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const proc = require('./index.js');
+
+const mb = Number(process.argv[2]) || 256;
+const file = path.join(os.tmpdir(), `proc-lines-${process.pid}.txt`);
+const line = 'the quick brown fox jumps over the lazy dog 0123456789\n';
+const block = line.repeat(Math.ceil(1048576 / line.length));
+const fd = fs.openSync(file, 'w');
+for (let i = 0; i < mb; i++) fs.writeSync(fd, block);
+fs.closeSync(fd);
+const bytes = fs.statSync(file).size;
+
+function measure(name, fn) {
+  global.gc?.();
+  const rss0 = process.memoryUsage().rss;
+  let peak = rss0;
+  const t0 = process.hrtime.bigint();
+  const lines = fn(() => { peak = Math.max(peak, process.memoryUsage().rss); });
+  const ms = Number(process.hrtime.bigint() - t0) / 1e6;
+  peak = Math.max(peak, process.memoryUsage().rss);
+  console.log(`${name.padEnd(10)} ${lines} lines  ${ms.toFixed(0)} ms  ${(bytes / 1048.576 / ms).toFixed(0)} MB/s  rss +${((peak - rss0) / 1048576).toFixed(0)} MB`);
+}
+
+try {
+  measure('fileLines', (sample) => {
+    let n = 0;
+    for (const l of proc.fileLines(file)) if ((++n & 0xffff) === 0) sample();
+    return n;
+  });
+  measure('readFile', (sample) => {
+    try {
+      const lines = fs.readFileSync(file, 'utf8').split('\n');
+      sample();
+      return lines.length - 1;
+    } catch (e) {
+      return `failed (${e.code || e.message})`;
+    }
+  });
+} finally {
+  fs.rmSync(file, { force: true });
+}
@@ -0,0 +1,35 @@
+// Streams N MB of command output through execSync (buffered) and through
+// proc (line iterator), reporting time and RSS growth.
+// usage: node bench.js [megabytes]
+const { execSync } = require('child_process');
+const proc = require('./index.js');
+
+const mb = Number(process.argv[2]) || 256;
+const cmd = `yes 'the quick brown fox jumps over the lazy dog 0123456789' | head -c ${mb * 1048576}`;
+
+function measure(name, fn) {
+  global.gc?.();
+  const rss0 = process.memoryUsage().rss;
+  let peak = rss0;
+  const t0 = process.hrtime.bigint();
+  const lines = fn(() => { peak = Math.max(peak, process.memoryUsage().rss); });
+  const ms = Number(process.hrtime.bigint() - t0) / 1e6;
+  peak = Math.max(peak, process.memoryUsage().rss);
+  console.log(`${name.padEnd(10)} ${lines} lines  ${ms.toFixed(0)} ms  ${(mb * 1000 / ms).toFixed(0)} MB/s  rss +${((peak - rss0) / 1048576).toFixed(0)} MB`);
+}
+
+measure('proc', (sample) => {
+  let n = 0;
+  for (const line of proc.run(cmd)) if ((++n & 0xffff) === 0) sample();
+  return n;
+});
+
+measure('execSync', (sample) => {
+  try {
+    const out = execSync(cmd, { encoding: 'utf8', maxBuffer: Infinity });
+    sample();
+    return out.split('\n').length - 1;
+  } catch (e) {
+    return `failed (${e.code || e.message})`;
+  }
+});
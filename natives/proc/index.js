@@ -0,0 +1,70 @@
+const addon = require('bindings')('proc');
+
+// Command forms accepted by run():
+//   "ls -l | wc -l"                  one shell command line (/bin/sh -c)
+//   ["grep", "-n", "x", file]        one argv, no shell, no quoting
+//   [["cat", f], ["grep", "x"]]      pipeline of argv stages wired with pipes
+const stagesOf = (cmd) => {
+  if (typeof cmd === 'string') return [['/bin/sh', '-c', cmd]];
+  if (Array.isArray(cmd) && cmd.length && cmd.every(Array.isArray)) return cmd.map(s => s.map(String));
+  if (Array.isArray(cmd) && cmd.length) return [cmd.map(String)];
+  throw new TypeError('Expected a command string, an argv array or an array of argv arrays');
+};
+
+// run(cmd, { cwd, env, stdin, stdout, stderr, maxLine }) -> Process
+// stdio: 'pipe' | 'inherit' | 'ignore' (stderr also 'stdout' for 2>&1).
+addon.run = (cmd, opts = {}) => new addon.Process(stagesOf(cmd), opts);
+
+const proto = addon.Process.prototype;
+
+// The addon hands over blocks of whole lines joined by '\n'.
+const splitLines = (text) => text.includes('\r') ? text.split(/\r?\n/) : text.split('\n');
+
+// for (const line of proc.lines()) ... pulls blocks on demand, so the
+// child is paused by the pipe whenever the loop body is slow.
+proto.lines = function* (stream = 'stdout') {
+  let text;
+  while ((text = this.read(stream)) !== null) if (text !== false) yield* splitLines(text);
+};
+proto[Symbol.iterator] = function () { return this.lines(); };
+
+// each(onLine, { stream }) -> Promise<{ code, signal, codes }>
+// Event-loop version: many children can stream at once. If onLine returns a
+// promise, reading pauses until it settles.
+proto.each = function (onLine, { stream = 'stdout' } = {}) {
+  return new Promise((resolve, reject) => {
+    let pending = 0;
+    this.start((event, payload) => {
+      if (event === 'exit') return resolve(payload);
+      if (event !== stream) return;
+      for (const line of splitLines(payload)) {
+        let r;
+        try { r = onLine(line); } catch (e) { this.kill(); return reject(e); }
+        if (r && typeof r.then === 'function') {
+          if (pending++ === 0) this.pause();
+          r.then(() => { if (--pending === 0) this.resume(); }, (e) => { this.kill(); reject(e); });
+        }
+      }
+    });
+  });
+};
+
+// fileLines(path, { maxLine, chunk }): lazy lines of a file of any size.
+addon.fileLines = function* (file, opts) {
+  const reader = new addon.LineFile(String(file), opts);
+  try {
+    let text;
+    while ((text = reader.read()) !== null) yield* splitLines(text);
+  } finally {
+    reader.close();
+  }
+};
+
+// output(cmd, opts) -> { stdout, code }; for short outputs only.
+addon.output = (cmd, opts = {}) => {
+  const proc = addon.run(cmd, { stdin: 'ignore', ...opts, stdout: 'pipe' });
+  const lines = [...proc.lines()];
+  return { stdout: lines.join('\n'), ...proc.wait() };
+};
+
+module.exports = addon
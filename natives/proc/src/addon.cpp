@@ -0,0 +1,754 @@
+#include <napi.h>
+#include <uv.h>
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#if !defined(__ANDROID__) || __ANDROID_API__ >= 28
+#include <spawn.h>
+#define NOVA_HAVE_POSIX_SPAWN 1
+#endif
+#if defined(__APPLE__) || (defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29))) || \
+    (defined(__ANDROID__) && __ANDROID_API__ >= 34)
+#define NOVA_HAVE_ADDCHDIR 1
+#endif
+
+extern char** environ;
+
+// Child processes without a shell in between and without buffering their
+// whole output. A Process is a pipeline of one or more argv stages wired
+// together with pipes; the caller pulls stdout/stderr a block of lines at a
+// time, either blocking (read) or from the event loop (start). Nothing
+// is read until it is asked for, so a slow consumer leaves the pipe full and
+// the child blocks in write(): memory stays bounded by the line buffers no
+// matter how much the child prints.
+//
+// LineFile runs the same splitter over a regular file, so readLines on a
+// file of any size needs one buffer, not the whole file as a string.
+//
+// POSIX only. posix_spawnp is used where available (no fork of the Node heap's
+// page tables); old Android and spawns that need a cwd without
+// posix_spawn_file_actions_addchdir_np fall back to fork + exec.
+
+static const size_t kChunk = 64 * 1024;
+static const size_t kDefaultMaxLine = 1 << 20;
+static const size_t kMaxBuffered = 4 << 20;     // per stream, complete lines not yet taken
+
+// memrchr is vectorised in glibc and bionic.
+static const char* lastNewline(const char* p, size_t n) {
+#if defined(__GLIBC__) || defined(__ANDROID__)
+    return static_cast<const char*>(memrchr(p, '\n', n));
+#else
+    for (const char* q = p + n; q > p;)
+        if (*--q == '\n') return q;
+    return nullptr;
+#endif
+}
+
+static ssize_t readFd(int fd, char* p, size_t n) {
+    ssize_t r;
+    do { r = read(fd, p, n); } while (r < 0 && errno == EINTR);
+    return r;
+}
+
+// Incremental line splitter over a pipe or file. An unterminated line is
+// buffered up to maxLine bytes and then handed out in maxLine pieces.
+struct LineReader {
+    int fd = -1;
+    bool eof = false;
+    std::vector<char> buf;
+    size_t begin = 0, end = 0;
+    size_t maxLine = kDefaultMaxLine;
+    size_t chunk = kChunk;      // bytes per read()
+
+    bool piped() const { return fd >= 0; }
+    bool done() const { return !piped() || (eof && begin == end); }
+    size_t buffered() const { return end - begin; }
+
+    // One read(). >0 bytes, 0 at EOF, -1 with errno (EAGAIN when non-blocking),
+    // -2 when the buffer is full of lines nobody has taken yet.
+    ssize_t fill() {
+        if (eof) return 0;
+        if (begin > 0 && (begin == end || end + chunk > buf.size())) {
+            memmove(buf.data(), buf.data() + begin, end - begin);
+            end -= begin;
+            begin = 0;
+        }
+        if (buf.size() - end < chunk) {
+            size_t cap = std::max(maxLine, kMaxBuffered) + chunk;
+            if (buf.size() >= cap) return -2;
+            buf.resize(std::min(cap, std::max(buf.size() * 2, end + chunk)));
+        }
+        ssize_t n = readFd(fd, buf.data() + end, buf.size() - end);
+        if (n == 0) eof = true;
+        if (n > 0) end += n;
+        return n;
+    }
+
+    // Next block of whole lines: everything up to the last buffered '\n'
+    // (that newline excluded), a maxLine piece of an overlong line, or the
+    // tail at EOF. One string per block lets JS split it, which is far cheaper
+    // than creating every line through N-API.
+    bool takeBlock(const char*& p, size_t& len) {
+        size_t avail = end - begin;
+        if (avail == 0) return false;
+        const char* base = buf.data() + begin;
+        const char* last = lastNewline(base, avail);
+        if (last) {
+            p = base;
+            len = last - base;
+            begin += len + 1;
+            if (len > 0 && base[len - 1] == '\r') len--;   // JS splits the inner \r\n
+        } else if (avail >= maxLine || eof) {
+            p = base;
+            len = std::min(avail, maxLine);
+            // Don't split a UTF-8 sequence when cutting an overlong line.
+            if (len < avail)
+                while (len > 1 && (static_cast<unsigned char>(base[len]) & 0xC0) == 0x80) len--;
+            begin += len;
+        } else {
+            return false;
+        }
+        if (begin == end) begin = end = 0;
+        return true;
+    }
+
+    void close() {
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+        eof = true;
+    }
+};
+
+static int signalNumber(const Napi::Value& v) {
+    if (v.IsNumber()) return v.As<Napi::Number>().Int32Value();
+    if (!v.IsString()) return SIGTERM;
+    std::string name = v.As<Napi::String>().Utf8Value();
+    if (name.rfind("SIG", 0) == 0) name = name.substr(3);
+    static const struct { const char* name; int sig; } table[] = {
+        {"HUP", SIGHUP}, {"INT", SIGINT}, {"QUIT", SIGQUIT}, {"KILL", SIGKILL}, {"TERM", SIGTERM},
+        {"USR1", SIGUSR1}, {"USR2", SIGUSR2}, {"STOP", SIGSTOP}, {"CONT", SIGCONT}, {"PIPE", SIGPIPE},
+    };
+    for (const auto& s : table) if (name == s.name) return s.sig;
+    return SIGTERM;
+}
+
+struct StdioSpec {
+    enum Mode { Pipe, Inherit, Ignore, Stdout } mode;
+};
+
+static bool parseMode(Napi::Env env, Napi::Object opts, const char* key, StdioSpec::Mode def, StdioSpec::Mode& out) {
+    out = def;
+    if (!opts.Has(key) || opts.Get(key).IsUndefined()) return true;
+    std::string m = opts.Get(key).ToString().Utf8Value();
+    if (m == "pipe") out = StdioSpec::Pipe;
+    else if (m == "inherit") out = StdioSpec::Inherit;
+    else if (m == "ignore") out = StdioSpec::Ignore;
+    else if (m == "stdout" && std::string(key) == "stderr") out = StdioSpec::Stdout;
+    else {
+        Napi::TypeError::New(env, std::string(key) + " must be 'pipe', 'inherit' or 'ignore'").ThrowAsJavaScriptException();
+        return false;
+    }
+    return true;
+}
+
+// Starts one stage with fds [in, out, err] as its stdio (-1 = inherit).
+// Returns the pid, or -errno.
+static pid_t spawnStage(const std::vector<std::string>& argv, const std::vector<std::string>& envList,
+                        bool customEnv, const std::string& cwd, const int fds[3]) {
+    std::vector<char*> args, envp;
+    for (const auto& a : argv) args.push_back(const_cast<char*>(a.c_str()));
+    args.push_back(nullptr);
+    for (const auto& e : envList) envp.push_back(const_cast<char*>(e.c_str()));
+    envp.push_back(nullptr);
+    char** envv = customEnv ? envp.data() : environ;
+
+#ifdef NOVA_HAVE_POSIX_SPAWN
+#ifndef NOVA_HAVE_ADDCHDIR
+    if (cwd.empty())
+#endif
+    {
+        // Every fd we create is O_CLOEXEC; dup2 onto 0-2 clears the flag, so
+        // the child inherits exactly its three stdio pipes.
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        for (int i = 0; i < 3; i++)
+            if (fds[i] >= 0) posix_spawn_file_actions_adddup2(&actions, fds[i], i);
+#ifdef NOVA_HAVE_ADDCHDIR
+        if (!cwd.empty()) posix_spawn_file_actions_addchdir_np(&actions, cwd.c_str());
+#endif
+        posix_spawnattr_t attr;
+        posix_spawnattr_init(&attr);
+        sigset_t all, none;
+        sigfillset(&all);
+        sigemptyset(&none);
+        // Node ignores SIGPIPE and may block signals; children get defaults.
+        posix_spawnattr_setsigdefault(&attr, &all);
+        posix_spawnattr_setsigmask(&attr, &none);
+        posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGDEF | POSIX_SPAWN_SETSIGMASK);
+        pid_t pid = -1;
+        int rc = posix_spawnp(&pid, args[0], &actions, &attr, args.data(), envv);
+        posix_spawnattr_destroy(&attr);
+        posix_spawn_file_actions_destroy(&actions);
+        return rc == 0 ? pid : -rc;
+    }
+#endif
+    // Exec failures are reported through a CLOEXEC pipe, like posix_spawn does.
+    int report[2];
+    if (pipe2(report, O_CLOEXEC) != 0) return -errno;
+    pid_t pid = fork();
+    if (pid < 0) {
+        int err = errno;
+        ::close(report[0]);
+        ::close(report[1]);
+        return -err;
+    }
+    if (pid == 0) {
+        for (int i = 0; i < 3; i++)
+            if (fds[i] >= 0) dup2(fds[i], i);
+        sigset_t none;
+        sigemptyset(&none);
+        sigprocmask(SIG_SETMASK, &none, nullptr);
+        for (int s = 1; s < NSIG; s++) signal(s, SIG_DFL);
+        int err = 0;
+        if (!cwd.empty() && chdir(cwd.c_str()) != 0) err = errno;
+        if (!err) {
+            if (customEnv) environ = envv;
+            execvp(args[0], args.data());
+            err = errno;
+        }
+        ssize_t w = write(report[1], &err, sizeof err);
+        (void)w;
+        _exit(127);
+    }
+    ::close(report[1]);
+    int err = 0;
+    ssize_t n = readFd(report[0], reinterpret_cast<char*>(&err), sizeof err);
+    ::close(report[0]);
+    if (n == sizeof err && err) {
+        waitpid(pid, nullptr, 0);
+        return -err;
+    }
+    return pid;
+}
+
+class Process : public Napi::ObjectWrap<Process> {
+public:
+    static Napi::Function Define(Napi::Env env) {
+        return DefineClass(env, "Process", {
+            InstanceMethod("read", &Process::Read),
+            InstanceMethod("write", &Process::Write),
+            InstanceMethod("end", &Process::End),
+            InstanceMethod("wait", &Process::Wait),
+            InstanceMethod("tryWait", &Process::TryWait),
+            InstanceMethod("kill", &Process::Kill),
+            InstanceMethod("start", &Process::Start),
+            InstanceMethod("pause", &Process::Pause),
+            InstanceMethod("resume", &Process::Resume),
+            InstanceMethod("close", &Process::Close),
+            InstanceAccessor("pid", &Process::Pid, nullptr),
+            InstanceAccessor("pids", &Process::Pids, nullptr),
+        });
+    }
+
+    // new Process([[argv...], ...], { cwd, env, stdin, stdout, stderr, maxLine })
+    Process(const Napi::CallbackInfo& info) : Napi::ObjectWrap<Process>(info) {
+        Napi::Env env = info.Env();
+        if (!info[0].IsArray() || info[0].As<Napi::Array>().Length() == 0) {
+            Napi::TypeError::New(env, "Expected a non-empty array of argv arrays").ThrowAsJavaScriptException();
+            return;
+        }
+        std::vector<std::vector<std::string>> stages;
+        Napi::Array list = info[0].As<Napi::Array>();
+        for (uint32_t i = 0; i < list.Length(); i++) {
+            Napi::Value s = list.Get(i);
+            if (!s.IsArray() || s.As<Napi::Array>().Length() == 0) {
+                Napi::TypeError::New(env, "Each pipeline stage must be a non-empty argv array").ThrowAsJavaScriptException();
+                return;
+            }
+            Napi::Array a = s.As<Napi::Array>();
+            std::vector<std::string> argv;
+            for (uint32_t j = 0; j < a.Length(); j++) argv.push_back(a.Get(j).ToString().Utf8Value());
+            stages.push_back(std::move(argv));
+        }
+
+        Napi::Object opts = info[1].IsObject() ? info[1].As<Napi::Object>() : Napi::Object::New(env);
+        StdioSpec::Mode inMode, outMode, errMode;
+        if (!parseMode(env, opts, "stdin", StdioSpec::Inherit, inMode)) return;
+        if (!parseMode(env, opts, "stdout", StdioSpec::Pipe, outMode)) return;
+        if (!parseMode(env, opts, "stderr", StdioSpec::Inherit, errMode)) return;
+        std::string cwd = opts.Has("cwd") && opts.Get("cwd").IsString() ? opts.Get("cwd").As<Napi::String>().Utf8Value() : "";
+        if (opts.Get("maxLine").IsNumber())
+            maxLine_ = std::max<int64_t>(1, opts.Get("maxLine").As<Napi::Number>().Int64Value());
+        std::vector<std::string> envList;
+        bool customEnv = opts.Get("env").IsObject();
+        if (customEnv) {
+            Napi::Object e = opts.Get("env").As<Napi::Object>();
+            Napi::Array keys = e.GetPropertyNames();
+            for (uint32_t i = 0; i < keys.Length(); i++) {
+                std::string k = keys.Get(i).ToString().Utf8Value();
+                Napi::Value v = e.Get(k);
+                if (!v.IsUndefined()) envList.push_back(k + "=" + v.ToString().Utf8Value());
+            }
+        }
+
+        // Parent-side fds we keep, and child-side fds closed after spawning.
+        std::vector<int> childFds;
+        auto fail = [&](const std::string& what, int err) {
+            for (int fd : childFds) ::close(fd);
+            closeAll();
+            killAll(SIGKILL);
+            for (size_t i = 0; i < pids_.size(); i++) waitpid(pids_[i], nullptr, 0);
+            pids_.clear();
+            Napi::Error::New(env, what + ": " + strerror(err)).ThrowAsJavaScriptException();
+        };
+        auto makePipe = [&](int fds[2]) {
+            if (pipe2(fds, O_CLOEXEC) != 0) return false;
+            childFds.push_back(fds[0]);
+            childFds.push_back(fds[1]);
+            return true;
+        };
+        int devnull = -1;
+        auto nullFd = [&]() {
+            if (devnull < 0) {
+                devnull = open("/dev/null", O_RDWR | O_CLOEXEC);
+                if (devnull >= 0) childFds.push_back(devnull);
+            }
+            return devnull;
+        };
+        auto keep = [&](int fd) { childFds.erase(std::find(childFds.begin(), childFds.end(), fd)); return fd; };
+
+        int stdinFd = -1, stdoutFd = -1, stderrFd = -1;
+        int p[2];
+        if (inMode == StdioSpec::Pipe) {
+            if (!makePipe(p)) { fail("pipe", errno); return; }
+            stdinFd = p[0];
+            stdin_ = keep(p[1]);
+        } else if (inMode == StdioSpec::Ignore) {
+            stdinFd = nullFd();
+        }
+        if (outMode == StdioSpec::Pipe) {
+            if (!makePipe(p)) { fail("pipe", errno); return; }
+            stdoutFd = p[1];
+            out_.fd = keep(p[0]);
+        } else if (outMode == StdioSpec::Ignore) {
+            stdoutFd = nullFd();
+        }
+        if (errMode == StdioSpec::Pipe) {
+            if (!makePipe(p)) { fail("pipe", errno); return; }
+            stderrFd = p[1];
+            err_.fd = keep(p[0]);
+        } else if (errMode == StdioSpec::Ignore) {
+            stderrFd = nullFd();
+        }
+        out_.maxLine = err_.maxLine = maxLine_;
+
+        int prevRead = stdinFd;
+        for (size_t i = 0; i < stages.size(); i++) {
+            int fds[3] = { prevRead, stdoutFd, stderrFd };
+            int next[2] = { -1, -1 };
+            if (i + 1 < stages.size()) {
+                if (!makePipe(next)) { fail("pipe", errno); return; }
+                fds[1] = next[1];
+            }
+            if (errMode == StdioSpec::Stdout) fds[2] = fds[1] >= 0 ? fds[1] : 1;
+            pid_t pid = spawnStage(stages[i], envList, customEnv, cwd, fds);
+            if (pid < 0) { fail("spawn " + stages[i][0], -pid); return; }
+            pids_.push_back(pid);
+            statuses_.push_back(-1);
+            prevRead = next[0];
+        }
+        for (int fd : childFds) ::close(fd);
+    }
+
+    ~Process() {
+        closeAll();
+        // Reap whatever already exited. Children still running are waited
+        // for on a detached thread, so they don't stay zombies once they end.
+        std::vector<pid_t> running;
+        for (size_t i = 0; i < pids_.size(); i++) {
+            if (statuses_[i] >= 0) continue;
+            pid_t r;
+            do { r = waitpid(pids_[i], nullptr, WNOHANG); } while (r < 0 && errno == EINTR);
+            if (r == 0) running.push_back(pids_[i]);
+        }
+        if (running.empty()) return;
+        std::thread([running] {
+            for (pid_t pid : running) {
+                pid_t r;
+                do { r = waitpid(pid, nullptr, 0); } while (r < 0 && errno == EINTR);
+            }
+        }).detach();
+    }
+
+private:
+    std::vector<pid_t> pids_;
+    std::vector<int> statuses_;    // raw wait status, -1 until reaped
+    int stdin_ = -1;
+    LineReader out_, err_;
+    size_t maxLine_ = kDefaultMaxLine;
+
+    // Event-loop mode.
+    Napi::FunctionReference callback_;
+    uv_poll_t* outPoll_ = nullptr;
+    uv_poll_t* errPoll_ = nullptr;
+    uv_timer_t* exitTimer_ = nullptr;
+    bool running_ = false, paused_ = false;
+    uint64_t exitDelay_ = 1;
+
+    void closeAll() {
+        stopPoll(outPoll_);
+        stopPoll(errPoll_);
+        if (stdin_ >= 0) ::close(stdin_);
+        stdin_ = -1;
+        out_.close();
+        err_.close();
+    }
+
+    void killAll(int sig) {
+        for (size_t i = 0; i < pids_.size(); i++)
+            if (statuses_[i] < 0) ::kill(pids_[i], sig);
+    }
+
+    bool reap(bool block) {
+        bool all = true;
+        for (size_t i = 0; i < pids_.size(); i++) {
+            if (statuses_[i] >= 0) continue;
+            int status = 0;
+            pid_t r;
+            do { r = waitpid(pids_[i], &status, block ? 0 : WNOHANG); } while (r < 0 && errno == EINTR);
+            if (r == pids_[i]) statuses_[i] = status;
+            else if (r < 0) statuses_[i] = 0;     // reaped elsewhere
+            else all = false;
+        }
+        return all;
+    }
+
+    // { code, signal, codes }: code follows the last stage, like sh without pipefail.
+    Napi::Object exitResult(Napi::Env env) {
+        Napi::Object result = Napi::Object::New(env);
+        Napi::Array codes = Napi::Array::New(env, pids_.size());
+        for (size_t i = 0; i < pids_.size(); i++) {
+            int s = statuses_[i];
+            codes.Set(i, WIFSIGNALED(s) ? 128 + WTERMSIG(s) : WEXITSTATUS(s));
+        }
+        int last = statuses_.back();
+        result.Set("code", WIFSIGNALED(last) ? 128 + WTERMSIG(last) : WEXITSTATUS(last));
+        result.Set("signal", WIFSIGNALED(last) ? Napi::Value(Napi::Number::New(env, WTERMSIG(last))) : env.Null());
+        result.Set("codes", codes);
+        return result;
+    }
+
+    // read(stream = 'stdout', timeoutMs = -1) -> string | null | false
+    // Blocks until at least one whole line (or EOF / timeout) and returns the
+    // lines joined by '\n'. null once the stream is finished, false on timeout.
+    // The other piped stream is drained meanwhile so a chatty stderr can't
+    // wedge the child.
+    Napi::Value Read(const Napi::CallbackInfo& info) {
+        Napi::Env env = info.Env();
+        bool wantErr = info[0].IsString() && info[0].As<Napi::String>().Utf8Value() == "stderr";
+        int timeout = info[1].IsNumber() ? info[1].As<Napi::Number>().Int32Value() : -1;
+        if (running_) {
+            Napi::Error::New(env, "read is not available after start()").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        LineReader& r = wantErr ? err_ : out_;
+        LineReader& other = wantErr ? out_ : err_;
+        if (!r.piped() && !r.eof) {
+            Napi::Error::New(env, std::string(wantErr ? "stderr" : "stdout") + " is not piped").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        for (;;) {
+            const char* p;
+            size_t len;
+            if (r.takeBlock(p, len)) return Napi::String::New(env, p, len);
+            if (r.done()) return env.Null();
+            struct pollfd pfd[2] = { { r.fd, POLLIN, 0 }, { -1, POLLIN, 0 } };
+            if (other.piped() && !other.eof && other.buffered() < kMaxBuffered) pfd[1].fd = other.fd;
+            int rc = poll(pfd, 2, timeout);
+            if (rc < 0 && errno == EINTR) continue;
+            if (rc == 0) return Napi::Boolean::New(env, false);
+            if (pfd[1].revents) other.fill();
+            if (pfd[0].revents) {
+                ssize_t n = r.fill();
+                if (n < 0 && n != -2 && errno != EAGAIN) r.eof = true;
+            }
+        }
+    }
+
+    // write(string | Buffer) -> false if the child closed its stdin
+    Napi::Value Write(const Napi::CallbackInfo& info) {
+        Napi::Env env = info.Env();
+        if (stdin_ < 0) {
+            Napi::Error::New(env, "stdin is not piped or already ended").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        std::string text;
+        const char* data;
+        size_t len;
+        if (info[0].IsBuffer()) {
+            auto b = info[0].As<Napi::Buffer<char>>();
+            data = b.Data();
+            len = b.Length();
+        } else {
+            text = info[0].ToString().Utf8Value();
+            data = text.data();
+            len = text.size();
+        }
+        while (len > 0) {
+            ssize_t n = ::write(stdin_, data, len);
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0 && errno == EAGAIN) {
+                struct pollfd pfd = { stdin_, POLLOUT, 0 };
+                poll(&pfd, 1, -1);
+                continue;
+            }
+            if (n < 0) return Napi::Boolean::New(env, false);
+            data += n;
+            len -= n;
+        }
+        return Napi::Boolean::New(env, true);
+    }
+
+    Napi::Value End(const Napi::CallbackInfo& info) {
+        if (stdin_ >= 0) ::close(stdin_);
+        stdin_ = -1;
+        return info.Env().Undefined();
+    }
+
+    // wait() -> { code, signal, codes }. Output nobody read is discarded.
+    Napi::Value Wait(const Napi::CallbackInfo& info) {
+        Napi::Env env = info.Env();
+        if (stdin_ >= 0) ::close(stdin_);
+        stdin_ = -1;
+        while (!out_.done() || !err_.done()) {
+            struct pollfd pfd[2] = { { out_.eof ? -1 : out_.fd, POLLIN, 0 }, { err_.eof ? -1 : err_.fd, POLLIN, 0 } };
+            if (poll(pfd, 2, -1) < 0 && errno != EINTR) break;
+            for (LineReader* r : { &out_, &err_ }) {
+                if (r->eof || r->fd < 0) continue;
+                r->begin = r->end = 0;
+                ssize_t n = r->fill();
+                if (n < 0 && errno != EAGAIN && errno != EINTR) r->eof = true;
+                r->begin = r->end = 0;
+            }
+        }
+        reap(true);
+        return exitResult(env);
+    }
+
+    Napi::Value TryWait(const Napi::CallbackInfo& info) {
+        return reap(false) ? Napi::Value(exitResult(info.Env())) : info.Env().Null();
+    }
+
+    Napi::Value Kill(const Napi::CallbackInfo& info) {
+        killAll(signalNumber(info[0]));
+        return info.Env().Undefined();
+    }
+
+    Napi::Value Close(const Napi::CallbackInfo& info) {
+        closeAll();
+        return info.Env().Undefined();
+    }
+
+    Napi::Value Pid(const Napi::CallbackInfo& info) {
+        return pids_.empty() ? info.Env().Null() : Napi::Value(Napi::Number::New(info.Env(), pids_.back()));
+    }
+
+    Napi::Value Pids(const Napi::CallbackInfo& info) {
+        Napi::Array a = Napi::Array::New(info.Env(), pids_.size());
+        for (size_t i = 0; i < pids_.size(); i++) a.Set(i, pids_[i]);
+        return a;
+    }
+
+    // ---- event-loop mode ----
+    // start(cb): cb('stdout' | 'stderr', text) for every block of lines read, then
+    // cb('exit', { code, signal, codes }). pause()/resume() stop reading, which
+    // pushes back on the child through the pipe.
+    Napi::Value Start(const Napi::CallbackInfo& info) {
+        Napi::Env env = info.Env();
+        if (running_ || !info[0].IsFunction()) {
+            Napi::Error::New(env, running_ ? "Process already started" : "start expects a callback").ThrowAsJavaScriptException();
+            return env.Null();
+        }
+        uv_loop_t* loop = nullptr;
+        napi_get_uv_event_loop(env, &loop);
+        callback_ = Napi::Persistent(info[0].As<Napi::Function>());
+        running_ = true;
+        Ref();
+        for (LineReader* r : { &out_, &err_ }) {
+            if (!r->piped() || r->eof) continue;
+            fcntl(r->fd, F_SETFL, fcntl(r->fd, F_GETFL) | O_NONBLOCK);
+            uv_poll_t*& poll = r == &out_ ? outPoll_ : errPoll_;
+            poll = new uv_poll_t;
+            uv_poll_init(loop, poll, r->fd);
+            poll->data = this;
+        }
+        exitTimer_ = new uv_timer_t;
+        uv_timer_init(loop, exitTimer_);
+        exitTimer_->data = this;
+        if (!paused_) Resume(info);
+        checkFinished();
+        return env.Undefined();
+    }
+
+    Napi::Value Pause(const Napi::CallbackInfo& info) {
+        paused_ = true;
+        if (outPoll_) uv_poll_stop(outPoll_);
+        if (errPoll_) uv_poll_stop(errPoll_);
+        return info.Env().Undefined();
+    }
+
+    Napi::Value Resume(const Napi::CallbackInfo& info) {
+        paused_ = false;
+        if (outPoll_) uv_poll_start(outPoll_, UV_READABLE | UV_DISCONNECT, OnReadable);
+        if (errPoll_) uv_poll_start(errPoll_, UV_READABLE | UV_DISCONNECT, OnReadable);
+        return info.Env().Undefined();
+    }
+
+    static void OnReadable(uv_poll_t* handle, int status, int) {
+        Process* self = static_cast<Process*>(handle->data);
+        bool isErr = handle == self->errPoll_;
+        LineReader& r = isErr ? self->err_ : self->out_;
+        // Bounded work per wakeup so one firehose child can't starve the loop.
+        for (int i = 0; i < 16 && !r.eof; i++) {
+            ssize_t n = r.fill();
+            if (n == -2) break;
+            if (n < 0) {
+                if (errno != EAGAIN && errno != EWOULDBLOCK) r.eof = true;
+                break;
+            }
+        }
+        if (status < 0) r.eof = true;
+        Napi::Env env = self->Env();
+        {
+            Napi::HandleScope scope(env);
+            const char* p;
+            size_t len;
+            while (r.takeBlock(p, len)) self->emit(isErr ? "stderr" : "stdout", Napi::String::New(env, p, len));
+        }
+        if (r.done()) {
+            stopPoll(isErr ? self->errPoll_ : self->outPoll_);
+            r.close();
+            self->checkFinished();
+        }
+    }
+
+    void emit(const char* event, Napi::Value payload) {
+        Napi::Env env = Env();
+        Napi::AsyncContext context(env, "nova:proc");
+        callback_.MakeCallback(Value(), { Napi::String::New(env, event), payload }, context);
+        // Nothing up the stack can catch it: report it like any uncaught error.
+        if (env.IsExceptionPending()) napi_fatal_exception(env, env.GetAndClearPendingException().Value());
+    }
+
+    // Once the output streams are done, poll waitpid (1 ms doubling to 50 ms)
+    // instead of competing with libuv for SIGCHLD.
+    void checkFinished() {
+        if (!running_ || outPoll_ || errPoll_) return;
+        if (reap(false)) {
+            running_ = false;
+            uv_close(reinterpret_cast<uv_handle_t*>(exitTimer_), [](uv_handle_t* h) { delete reinterpret_cast<uv_timer_t*>(h); });
+            exitTimer_ = nullptr;
+            Napi::Env env = Env();
+            Napi::HandleScope scope(env);
+            emit("exit", exitResult(env));
+            callback_.Reset();
+            Unref();
+            return;
+        }
+        uv_timer_start(exitTimer_, [](uv_timer_t* t) { static_cast<Process*>(t->data)->checkFinished(); }, exitDelay_, 0);
+        exitDelay_ = std::min<uint64_t>(exitDelay_ * 2, 50);
+    }
+
+    static void stopPoll(uv_poll_t*& poll) {
+        if (!poll) return;
+        uv_poll_stop(poll);
+        uv_close(reinterpret_cast<uv_handle_t*>(poll), [](uv_handle_t* h) { delete reinterpret_cast<uv_poll_t*>(h); });
+        poll = nullptr;
+    }
+};
+
+class LineFile : public Napi::ObjectWrap<LineFile> {
+public:
+    static Napi::Function Define(Napi::Env env) {
+        return DefineClass(env, "LineFile", {
+            InstanceMethod("read", &LineFile::Read),
+            InstanceMethod("close", &LineFile::Close),
+            InstanceAccessor("bytesRead", &LineFile::BytesRead, nullptr),
+        });
+    }
+
+    // new LineFile(path, { maxLine, chunk })
+    LineFile(const Napi::CallbackInfo& info) : Napi::ObjectWrap<LineFile>(info) {
+        Napi::Env env = info.Env();
+        if (!info[0].IsString()) {
+            Napi::TypeError::New(env, "Expected a file path").ThrowAsJavaScriptException();
+            return;
+        }
+        std::string path = info[0].As<Napi::String>().Utf8Value();
+        Napi::Object opts = info[1].IsObject() ? info[1].As<Napi::Object>() : Napi::Object::New(env);
+        if (opts.Get("maxLine").IsNumber())
+            reader_.maxLine = std::max<int64_t>(1, opts.Get("maxLine").As<Napi::Number>().Int64Value());
+        reader_.chunk = opts.Get("chunk").IsNumber()
+            ? std::max<int64_t>(4096, opts.Get("chunk").As<Napi::Number>().Int64Value())
+            : kFileChunk;
+        int fd;
+        do { fd = open(path.c_str(), O_RDONLY | O_CLOEXEC); } while (fd < 0 && errno == EINTR);
+        if (fd < 0) {
+            Napi::Error::New(env, "open " + path + ": " + strerror(errno)).ThrowAsJavaScriptException();
+            return;
+        }
+#ifdef POSIX_FADV_SEQUENTIAL
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+        reader_.fd = fd;
+    }
+
+    ~LineFile() { reader_.close(); }
+
+private:
+    static const size_t kFileChunk = 1 << 20;
+    LineReader reader_;
+    double bytesRead_ = 0;
+
+    // read() -> next block of whole lines joined by '\n', or null at EOF.
+    Napi::Value Read(const Napi::CallbackInfo& info) {
+        Napi::Env env = info.Env();
+        for (;;) {
+            const char* p;
+            size_t len;
+            if (reader_.takeBlock(p, len)) return Napi::String::New(env, p, len);
+            if (reader_.done()) return env.Null();
+            ssize_t n = reader_.fill();
+            if (n > 0) bytesRead_ += n;
+            if (n == -1) {
+                Napi::Error::New(env, std::string("read: ") + strerror(errno)).ThrowAsJavaScriptException();
+                return env.Null();
+            }
+        }
+    }
+
+    Napi::Value Close(const Napi::CallbackInfo& info) {
+        reader_.close();
+        return info.Env().Undefined();
+    }
+
+    Napi::Value BytesRead(const Napi::CallbackInfo& info) {
+        return Napi::Number::New(info.Env(), bytesRead_);
+    }
+};
+
+Napi::Object Init(Napi::Env env, Napi::Object exports) {
+    exports.Set("Process", Process::Define(env));
+    exports.Set("LineFile", LineFile::Define(env));
+    return exports;
+}
+
+NODE_API_MODULE(proc, Init)
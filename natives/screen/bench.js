@@ -0,0 +1,36 @@
+// Simulates a 60 Hz dashboard (progress bar + table) and compares a full
+// redraw per frame with the damage-tracked screen.
+// usage: node bench.js [frames]
+const screen = require('./index.js');
+const { generateConsoleUI } = require('../../core/nova.js');
+
+const frames = Number(process.argv[2]) || 600;
+
+const progress = (i) => ({ type: 'progressBar', width: 60, progress: i % 101, max: 100 });
+const table = (i) => ({
+  type: 'table', width: 60, title: 'Workers',
+  headers: ['id', 'state', 'jobs'],
+  data: [0, 1, 2, 3, 4, 5].map(w => [w, (i + w) % 30 === 0 ? 'busy' : 'idle', Math.floor(i / (w + 1))]),
+});
+
+function run(label, draw) {
+  const cpu = process.cpuUsage();
+  const t0 = process.hrtime.bigint();
+  let bytes = 0;
+  for (let i = 0; i < frames; i++) bytes += draw(i);
+  const wall = Number(process.hrtime.bigint() - t0) / 1e6;
+  const used = process.cpuUsage(cpu);
+  console.log(`${label.padEnd(8)} frames=${frames} bytes=${bytes} bytes/frame=${(bytes / frames).toFixed(1)} ` +
+    `cpu=${((used.user + used.system) / 1000).toFixed(1)}ms wall=${wall.toFixed(1)}ms`);
+}
+
+run('full', (i) => Buffer.byteLength('\x1b[H' + generateConsoleUI(progress(i)) + '\n\n' + generateConsoleUI(table(i))));
+
+screen.init(24, 80);
+screen.widget('progress', 0, 0);
+screen.widget('table', 2, 0);
+run('diff', (i) => {
+  screen.setContent('progress', generateConsoleUI(progress(i)));
+  screen.setContent('table', generateConsoleUI(table(i)));
+  return Buffer.byteLength(screen.frame());
+});
@@ -0,0 +1,3 @@
+const addon = require('bindings')('screen');
+
+module.exports = addon
@@ -0,0 +1,352 @@
+#include <napi.h>
+#include <unistd.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+
+// Retained-mode terminal screen. Widgets own a rectangle of cells in a back
+// buffer; frame() diffs the back buffer against what was last emitted and
+// returns only the ANSI needed to bring the terminal up to date.
+
+struct Pen {
+    int16_t fg = -1;      // -1 = default, 0..255 = palette index
+    int16_t bg = -1;
+    uint16_t attrs = 0;   // bit n = SGR n (1 bold, 2 dim, 4 underline, 7 reverse, ...)
+
+    bool operator==(const Pen& o) const { return fg == o.fg && bg == o.bg && attrs == o.attrs; }
+    bool operator!=(const Pen& o) const { return !(*this == o); }
+};
+
+struct Cell {
+    uint32_t ch = ' ';
+    Pen pen;
+
+    bool operator==(const Cell& o) const { return ch == o.ch && pen == o.pen; }
+    bool operator!=(const Cell& o) const { return !(*this == o); }
+};
+
+struct Widget {
+    int row = 0;
+    int col = 0;
+    int height = 0;   // extent covered by the last content
+    int width = 0;
+    std::string content;
+};
+
+struct Screen {
+    int rows = 24;
+    int cols = 80;
+    std::vector<Cell> back;
+    std::vector<Cell> front;
+    bool frontValid = false;
+    std::map<std::string, Widget> widgets;
+    uint64_t bytesEmitted = 0;
+    uint64_t cellsEmitted = 0;
+    uint64_t frames = 0;
+
+    void resize(int r, int c) {
+        rows = r > 0 ? r : 1;
+        cols = c > 0 ? c : 1;
+        back.assign((size_t)rows * cols, Cell());
+        front.assign((size_t)rows * cols, Cell());
+        frontValid = false;
+    }
+
+    Cell* at(int r, int c) {
+        if (r < 0 || c < 0 || r >= rows || c >= cols) return nullptr;
+        return &back[(size_t)r * cols + c];
+    }
+};
+
+Screen screen;
+
+// ---------- ANSI parsing ----------
+void applySGR(Pen& pen, const std::vector<int>& params) {
+    if (params.empty()) { pen = Pen(); return; }
+    for (size_t i = 0; i < params.size(); i++) {
+        int p = params[i];
+        if (p == 0) pen = Pen();
+        else if (p >= 1 && p <= 9) pen.attrs |= (1u << p);
+        else if (p == 22) pen.attrs &= ~((1u << 1) | (1u << 2));
+        else if (p >= 23 && p <= 29) pen.attrs &= ~(1u << (p - 20));
+        else if (p >= 30 && p <= 37) pen.fg = p - 30;
+        else if (p == 39) pen.fg = -1;
+        else if (p >= 40 && p <= 47) pen.bg = p - 40;
+        else if (p == 49) pen.bg = -1;
+        else if (p >= 90 && p <= 97) pen.fg = p - 90 + 8;
+        else if (p >= 100 && p <= 107) pen.bg = p - 100 + 8;
+        else if ((p == 38 || p == 48) && i + 2 < params.size() && params[i + 1] == 5) {
+            (p == 38 ? pen.fg : pen.bg) = (int16_t)(params[i + 2] & 0xff);
+            i += 2;
+        }
+    }
+}
+
+uint32_t decodeUtf8(const std::string& s, size_t& i) {
+    unsigned char c = s[i];
+    uint32_t cp;
+    int extra;
+    if (c < 0x80) { i++; return c; }
+    else if ((c >> 5) == 0x6) { cp = c & 0x1f; extra = 1; }
+    else if ((c >> 4) == 0xe) { cp = c & 0x0f; extra = 2; }
+    else if ((c >> 3) == 0x1e) { cp = c & 0x07; extra = 3; }
+    else { i++; return '?'; }
+    i++;
+    for (int k = 0; k < extra && i < s.size(); k++, i++) cp = (cp << 6) | (s[i] & 0x3f);
+    return cp;
+}
+
+void appendUtf8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) out.push_back((char)cp);
+    else if (cp < 0x800) {
+        out.push_back((char)(0xc0 | (cp >> 6)));
+        out.push_back((char)(0x80 | (cp & 0x3f)));
+    } else if (cp < 0x10000) {
+        out.push_back((char)(0xe0 | (cp >> 12)));
+        out.push_back((char)(0x80 | ((cp >> 6) & 0x3f)));
+        out.push_back((char)(0x80 | (cp & 0x3f)));
+    } else {
+        out.push_back((char)(0xf0 | (cp >> 18)));
+        out.push_back((char)(0x80 | ((cp >> 12) & 0x3f)));
+        out.push_back((char)(0x80 | ((cp >> 6) & 0x3f)));
+        out.push_back((char)(0x80 | (cp & 0x3f)));
+    }
+}
+
+// Paints an ANSI string (as produced by generateConsoleUI) into the back
+// buffer at (row, col). Returns the covered extent.
+void paint(const std::string& text, int row, int col, int& outH, int& outW) {
+    Pen pen;
+    int r = row, c = col;
+    outH = 0;
+    outW = 0;
+    size_t i = 0;
+    while (i < text.size()) {
+        unsigned char ch = text[i];
+        if (ch == 0x1b && i + 1 < text.size() && text[i + 1] == '[') {
+            size_t j = i + 2;
+            std::vector<int> params;
+            int cur = 0;
+            bool have = false;
+            while (j < text.size() && ((text[j] >= '0' && text[j] <= '9') || text[j] == ';')) {
+                if (text[j] == ';') { params.push_back(have ? cur : 0); cur = 0; have = false; }
+                else { cur = cur * 10 + (text[j] - '0'); have = true; }
+                j++;
+            }
+            if (have) params.push_back(cur);
+            if (j < text.size() && text[j] == 'm') applySGR(pen, params);
+            i = j + 1;
+            continue;
+        }
+        if (ch == '\n') { r++; c = col; i++; continue; }
+        if (ch == '\r') { c = col; i++; continue; }
+        uint32_t cp = decodeUtf8(text, i);
+        if (Cell* cell = screen.at(r, c)) {
+            cell->ch = cp;
+            cell->pen = pen;
+        }
+        c++;
+        if (r - row + 1 > outH) outH = r - row + 1;
+        if (c - col > outW) outW = c - col;
+    }
+}
+
+void blank(int row, int col, int h, int w) {
+    for (int r = row; r < row + h; r++)
+        for (int c = col; c < col + w; c++)
+            if (Cell* cell = screen.at(r, c)) *cell = Cell();
+}
+
+// ---------- Diff emission ----------
+void emitPen(std::string& out, const Pen& pen) {
+    out += "\x1b[0";
+    for (int a = 1; a <= 9; a++)
+        if (pen.attrs & (1u << a)) { out += ';'; out += std::to_string(a); }
+    if (pen.fg >= 0) {
+        if (pen.fg < 8) out += ";" + std::to_string(30 + pen.fg);
+        else if (pen.fg < 16) out += ";" + std::to_string(90 + pen.fg - 8);
+        else out += ";38;5;" + std::to_string(pen.fg);
+    }
+    if (pen.bg >= 0) {
+        if (pen.bg < 8) out += ";" + std::to_string(40 + pen.bg);
+        else if (pen.bg < 16) out += ";" + std::to_string(100 + pen.bg - 8);
+        else out += ";48;5;" + std::to_string(pen.bg);
+    }
+    out += 'm';
+}
+
+std::string diffFrame() {
+    std::string out;
+    const int cols = screen.cols;
+    bool full = !screen.frontValid;
+    if (full) out += "\x1b[H\x1b[2J";
+
+    Pen pen;
+    bool penKnown = false;
+    int curR = -1, curC = -1;
+
+    for (int r = 0; r < screen.rows; r++) {
+        const Cell* b = &screen.back[(size_t)r * cols];
+        Cell* f = &screen.front[(size_t)r * cols];
+        for (int c = 0; c < cols; c++) {
+            if (!full && b[c] == f[c]) continue;
+            if (full && b[c] == Cell()) continue;
+
+            if (curR != r || curC != c) {
+                // Rewriting a short run of unchanged cells is cheaper than a CUP.
+                int gap = c - curC;
+                bool bridged = false;
+                if (curR == r && gap > 0 && gap <= 4) {
+                    bridged = true;
+                    for (int k = curC; k < c; k++)
+                        if (b[k].pen != pen || !penKnown) { bridged = false; break; }
+                    if (bridged)
+                        for (int k = curC; k < c; k++) appendUtf8(out, b[k].ch);
+                }
+                if (!bridged) out += "\x1b[" + std::to_string(r + 1) + ";" + std::to_string(c + 1) + "H";
+            }
+            if (!penKnown || b[c].pen != pen) {
+                emitPen(out, b[c].pen);
+                pen = b[c].pen;
+                penKnown = true;
+            }
+            appendUtf8(out, b[c].ch);
+            f[c] = b[c];
+            screen.cellsEmitted++;
+            curR = r;
+            curC = c + 1;
+        }
+    }
+
+    if (full) screen.front = screen.back;
+    screen.frontValid = true;
+    if (!out.empty()) {
+        if (penKnown) out += "\x1b[0m";
+        // Park the cursor below the managed area so regular output stays clear of it.
+        out += "\x1b[" + std::to_string(screen.rows) + ";1H";
+    }
+    screen.bytesEmitted += out.size();
+    screen.frames++;
+    return out;
+}
+
+// ---------- Wrappers ----------
+Napi::Value InitScreen(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    int rows = info.Length() > 0 && info[0].IsNumber() ? info[0].As<Napi::Number>().Int32Value() : 24;
+    int cols = info.Length() > 1 && info[1].IsNumber() ? info[1].As<Napi::Number>().Int32Value() : 80;
+    screen.resize(rows, cols);
+    for (auto& kv : screen.widgets) {
+        kv.second.content.clear();
+        kv.second.height = kv.second.width = 0;
+    }
+    return env.Undefined();
+}
+
+// widget(id, row, col) -> registers or moves a widget
+Napi::Value WidgetAt(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 3 || !info[1].IsNumber() || !info[2].IsNumber()) {
+        Napi::TypeError::New(env, "Expected (id, row, col)").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    std::string id = info[0].ToString().Utf8Value();
+    Widget& w = screen.widgets[id];
+    int row = info[1].As<Napi::Number>().Int32Value();
+    int col = info[2].As<Napi::Number>().Int32Value();
+    if (w.row != row || w.col != col) {
+        blank(w.row, w.col, w.height, w.width);
+        w.row = row;
+        w.col = col;
+        w.height = w.width = 0;
+        w.content.clear();
+    }
+    return env.Undefined();
+}
+
+// setContent(id, ansiText) -> { rows, cols, changed }
+Napi::Value SetContent(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 2 || !info[1].IsString()) {
+        Napi::TypeError::New(env, "Expected (id, text)").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    std::string id = info[0].ToString().Utf8Value();
+    auto it = screen.widgets.find(id);
+    if (it == screen.widgets.end()) {
+        Napi::Error::New(env, "Unknown widget: " + id).ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    Widget& w = it->second;
+    std::string text = info[1].As<Napi::String>().Utf8Value();
+    bool changed = text != w.content;
+    if (changed) {
+        blank(w.row, w.col, w.height, w.width);
+        paint(text, w.row, w.col, w.height, w.width);
+        w.content = std::move(text);
+    }
+    Napi::Object res = Napi::Object::New(env);
+    res.Set("rows", w.height);
+    res.Set("cols", w.width);
+    res.Set("changed", changed);
+    return res;
+}
+
+Napi::Value RemoveWidget(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    std::string id = info[0].ToString().Utf8Value();
+    auto it = screen.widgets.find(id);
+    if (it != screen.widgets.end()) {
+        blank(it->second.row, it->second.col, it->second.height, it->second.width);
+        screen.widgets.erase(it);
+    }
+    return env.Undefined();
+}
+
+Napi::Value Frame(const Napi::CallbackInfo& info) {
+    return Napi::String::New(info.Env(), diffFrame());
+}
+
+Napi::Value Flush(const Napi::CallbackInfo& info) {
+    std::string out = diffFrame();
+    size_t off = 0;
+    while (off < out.size()) {
+        ssize_t n = write(STDOUT_FILENO, out.data() + off, out.size() - off);
+        if (n <= 0) break;
+        off += (size_t)n;
+    }
+    return Napi::Number::New(info.Env(), (double)out.size());
+}
+
+// invalidate() forces the next frame to repaint everything (e.g. after a resize)
+Napi::Value Invalidate(const Napi::CallbackInfo& info) {
+    screen.frontValid = false;
+    return info.Env().Undefined();
+}
+
+Napi::Value Stats(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    Napi::Object res = Napi::Object::New(env);
+    res.Set("rows", screen.rows);
+    res.Set("cols", screen.cols);
+    res.Set("widgets", (double)screen.widgets.size());
+    res.Set("frames", (double)screen.frames);
+    res.Set("bytes", (double)screen.bytesEmitted);
+    res.Set("cells", (double)screen.cellsEmitted);
+    return res;
+}
+
+Napi::Object Init(Napi::Env env, Napi::Object exports) {
+    exports.Set("init", Napi::Function::New(env, InitScreen));
+    exports.Set("widget", Napi::Function::New(env, WidgetAt));
+    exports.Set("setContent", Napi::Function::New(env, SetContent));
+    exports.Set("remove", Napi::Function::New(env, RemoveWidget));
+    exports.Set("frame", Napi::Function::New(env, Frame));
+    exports.Set("flush", Napi::Function::New(env, Flush));
+    exports.Set("invalidate", Napi::Function::New(env, Invalidate));
+    exports.Set("stats", Napi::Function::New(env, Stats));
+    return exports;
+}
+
+NODE_API_MODULE(screen, Init)
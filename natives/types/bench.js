@@ -0,0 +1,93 @@
+// Stores count records in struct vectors (aos and soa) and as plain JS
+// objects, reporting heap + external bytes per record and the time to fill,
+// sort by a field, sum a column and round-trip through a file, checking
+// that every layout agrees.
+// usage: node --expose-gc bench.js [count]
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { types } = require('./index.js');
+
+const count = Number(process.argv[2]) || 1000000;
+const Particle = types.struct('BenchParticle', [['id', 'uint32'], ['x', 'float'], ['y', 'float'], ['z', 'float'], ['mass', 'double']]);
+let failed = false;
+
+const gc = global.gc || (() => {});
+function memory() {
+  gc();
+  const m = process.memoryUsage();
+  return m.heapUsed + m.external;
+}
+
+function time(run) {
+  const t0 = process.hrtime.bigint();
+  const out = run();
+  return [out, Number(process.hrtime.bigint() - t0) / 1e6];
+}
+
+const rand = new Float32Array(count * 4);
+for (let i = 0; i < rand.length; i++) rand[i] = Math.random() * 100;
+const item = (i) => ({ id: i, x: rand[4 * i], y: rand[4 * i + 1], z: rand[4 * i + 2], mass: rand[4 * i + 3] });
+
+function run(name, make) {
+  const before = memory();
+  const [store, fillMs] = time(make);
+  const bytes = (memory() - before) / count;
+  const [, sortMs] = time(() => store.sort());
+  const [total, sumMs] = time(() => store.sum());
+  const [firstId, ioMs] = time(() => store.roundTrip());
+  console.log(`${name.padEnd(8)} ${bytes.toFixed(0).padStart(5)} B/record  fill ${fillMs.toFixed(0).padStart(5)} ms  sort ${sortMs.toFixed(0).padStart(5)} ms  sum ${sumMs.toFixed(1).padStart(6)} ms  save+load ${ioMs.toFixed(0).padStart(5)} ms`);
+  return [total, firstId];
+}
+
+const file = path.join(os.tmpdir(), `nova-vector-bench-${process.pid}.bin`);
+
+function vectorStore(layout) {
+  const vec = types.vector(Particle, count, { layout });
+  for (let i = 0; i < count; i++) vec.push(item(i));
+  return {
+    sort: () => vec.sortBy('x'),
+    sum: () => {
+      let t = 0;
+      if (layout === 'soa') {
+        const mass = vec.column('mass');
+        for (let i = 0; i < mass.length; i++) t += mass[i];
+      } else {
+        for (const p of vec) t += p.mass;
+      }
+      return t;
+    },
+    roundTrip: () => {
+      vec.save(file);
+      const back = types.loadVector(file, { layout });
+      return back.get(0).id;
+    },
+  };
+}
+
+function objectStore() {
+  let arr = [];
+  for (let i = 0; i < count; i++) arr.push(item(i));
+  return {
+    sort: () => arr.sort((a, b) => a.x - b.x),
+    sum: () => arr.reduce((t, p) => t + p.mass, 0),
+    roundTrip: () => {
+      fs.writeFileSync(file, JSON.stringify(arr));
+      arr = JSON.parse(fs.readFileSync(file, 'utf8'));
+      return arr[0].id;
+    },
+  };
+}
+
+try {
+  const results = [run('objects', objectStore), run('aos', () => vectorStore('aos')), run('soa', () => vectorStore('soa'))];
+  // Every sort is stable, so all layouts agree on the first record.
+  const [refTotal, refFirst] = results[0];
+  for (const [total, first] of results.slice(1)) {
+    if (Math.abs(total - refTotal) > 1e-6 * Math.abs(refTotal) || first !== refFirst) failed = true;
+  }
+  console.log(failed ? 'WRONG' : 'ok');
+} finally {
+  fs.rmSync(file, { force: true });
+}
+process.exitCode = failed ? 1 : 0;
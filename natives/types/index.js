@@ -1,3 +1,377 @@
+const os = require('os');
 const addon = require('bindings')('pointer-addon.node');
 
+const { types } = addon;
+const LE = os.endianness() === 'LE';
+
+// Struct types by name, for nested fields.
+types.structs = {};
+
+// DataView method and typed array per fixed-width kind.
+const scalars = {
+  int8: ['Int8', Int8Array], uint8: ['Uint8', Uint8Array],
+  int16: ['Int16', Int16Array], uint16: ['Uint16', Uint16Array],
+  int32: ['Int32', Int32Array], uint32: ['Uint32', Uint32Array],
+  int64: ['BigInt64', BigInt64Array], uint64: ['BigUint64', BigUint64Array],
+  float32: ['Float32', Float32Array], float64: ['Float64', Float64Array],
+};
+scalars.char = types.charSigned ? scalars.int8 : scalars.uint8;
+scalars.bool = scalars.uint8;
+
+// Memory a struct view can sit on: ArrayBuffer, typed array / Buffer,
+// DataView, or a native pointer (BigInt from the pointers addon, External
+// from dl) of which `length` bytes are mapped.
+function dataView(memory, length) {
+  if (memory instanceof DataView) return memory;
+  if (memory instanceof ArrayBuffer || (typeof SharedArrayBuffer !== 'undefined' && memory instanceof SharedArrayBuffer)) return new DataView(memory);
+  if (ArrayBuffer.isView(memory)) return new DataView(memory.buffer, memory.byteOffset, memory.byteLength);
+  return new DataView(types.view(memory, length));
+}
+
+const utf8 = new TextDecoder();
+const encoder = new TextEncoder();
+
+// Runtime helpers the generated accessors call for the less common kinds.
+const helpers = {
+  LE,
+  bigint: (v) => (typeof v === 'bigint' ? v : BigInt(v)),
+  address: (v) => (typeof v === 'bigint' ? v : v == null ? 0n : types.address(v)),
+  // char[n]: text up to the first NUL
+  readChars(dv, at, n) {
+    const bytes = new Uint8Array(dv.buffer, dv.byteOffset + at, n);
+    const end = bytes.indexOf(0);
+    return utf8.decode(end < 0 ? bytes : bytes.subarray(0, end));
+  },
+  writeChars(dv, at, n, v) {
+    const bytes = new Uint8Array(dv.buffer, dv.byteOffset + at, n);
+    const { written } = encoder.encodeInto(String(v), bytes);
+    bytes.fill(0, written);
+  },
+  // numeric arrays: a typed array over the struct's memory when aligned,
+  // else a copy
+  readArray(dv, at, n, kind) {
+    const [method, Typed] = scalars[kind];
+    const start = dv.byteOffset + at;
+    if (kind !== 'bool' && start % Typed.BYTES_PER_ELEMENT === 0) return new Typed(dv.buffer, start, n);
+    const out = new Array(n);
+    for (let i = 0; i < n; i++) out[i] = dv[`get${method}`](at + i * Typed.BYTES_PER_ELEMENT, LE);
+    return kind === 'bool' ? out.map(Boolean) : out;
+  },
+  writeArray(dv, at, n, kind, v) {
+    const [method, Typed] = scalars[kind];
+    const big = Typed === BigInt64Array || Typed === BigUint64Array;
+    let i = 0;
+    for (const x of v) {
+      if (i === n) break;
+      dv[`set${method}`](at + i++ * Typed.BYTES_PER_ELEMENT, big ? helpers.bigint(x) : kind === 'bool' ? (x ? 1 : 0) : x, LE);
+    }
+  },
+  readPointers(dv, at, n, size) {
+    const out = new Array(n);
+    for (let i = 0; i < n; i++) out[i] = size === 8 ? dv.getBigUint64(at + i * 8, LE) : BigInt(dv.getUint32(at + i * 4, LE));
+    return out;
+  },
+  writePointers(dv, at, n, size, v) {
+    let i = 0;
+    for (const x of v) {
+      if (i === n) break;
+      if (size === 8) dv.setBigUint64(at + i * 8, helpers.address(x), LE);
+      else dv.setUint32(at + i * 4, Number(helpers.address(x)), LE);
+      i++;
+    }
+  },
+  structs: types.structs,
+};
+
+// Source of the getter/setter pair for one field: dv is the DataView
+// expression and at the field's byte offset in it.
+function accessorSource(f, dv = 'this.$view', at = `this.$offset + ${f.offset}`) {
+  const key = JSON.stringify(f.name);
+  let get, set;
+  if (f.kind === 'struct') {
+    const T = `h.structs[${JSON.stringify(f.struct.name)}]`;
+    if (f.array) {
+      get = `const T = ${T}, out = new Array(${f.count}); for (let i = 0; i < ${f.count}; i++) out[i] = new T(${dv}, ${at} + i * ${f.size}); return out;`;
+      set = `const T = ${T}; let i = 0; for (const x of v) { if (i === ${f.count}) break; new T(${dv}, ${at} + i++ * ${f.size}).assign(x); }`;
+    } else {
+      get = `return new ${T}(${dv}, ${at});`;
+      set = `new ${T}(${dv}, ${at}).assign(v);`;
+    }
+  } else if (f.kind === 'pointer') {
+    if (f.array) {
+      get = `return h.readPointers(${dv}, ${at}, ${f.count}, ${f.size});`;
+      set = `h.writePointers(${dv}, ${at}, ${f.count}, ${f.size}, v);`;
+    } else if (f.size === 8) {
+      get = `return ${dv}.getBigUint64(${at}, ${LE});`;
+      set = `${dv}.setBigUint64(${at}, h.address(v), ${LE});`;
+    } else {
+      get = `return BigInt(${dv}.getUint32(${at}, ${LE}));`;
+      set = `${dv}.setUint32(${at}, Number(h.address(v)), ${LE});`;
+    }
+  } else if (f.array) {
+    if (f.kind === 'char') {
+      get = `return h.readChars(${dv}, ${at}, ${f.count});`;
+      set = `h.writeChars(${dv}, ${at}, ${f.count}, v);`;
+    } else {
+      get = `return h.readArray(${dv}, ${at}, ${f.count}, ${JSON.stringify(f.kind)});`;
+      set = `h.writeArray(${dv}, ${at}, ${f.count}, ${JSON.stringify(f.kind)}, v);`;
+    }
+  } else {
+    const [method] = scalars[f.kind];
+    if (f.kind === 'bool') {
+      get = `return ${dv}.getUint8(${at}) !== 0;`;
+      set = `${dv}.setUint8(${at}, v ? 1 : 0);`;
+    } else if (f.kind === 'int64' || f.kind === 'uint64') {
+      get = `return ${dv}.get${method}(${at}, ${LE});`;
+      set = `${dv}.set${method}(${at}, h.bigint(v), ${LE});`;
+    } else {
+      get = `return ${dv}.get${method}(${at}, ${LE});`;
+      set = `${dv}.set${method}(${at}, v, ${LE});`;
+    }
+  }
+  return `get [${key}]() { ${get} }\n  set [${key}](v) { ${set} }`;
+}
+
+// Plain-object copy of one field's value (arrays and nested structs too).
+const plain = (v) => (v instanceof StructRecord ? v.toObject() : ArrayBuffer.isView(v) ? Array.from(v) : Array.isArray(v) ? v.map(plain) : v);
+helpers.plain = plain;
+
+// Class source: the field accessors plus assign(obj), which copies the
+// fields obj has, and toObject(), spelled out per field so both stay
+// monomorphic. The name goes in the source: redefining a class's `name`
+// afterwards makes V8 construct it far more slowly.
+function classSource(name, fields, accessor) {
+  const ident = name.replace(/\W/g, '_').replace(/^(?=\d)/, '_');
+  const keys = fields.map((f) => JSON.stringify(f.name));
+  const assign = keys.map((k) => `if ((v = o[${k}]) !== undefined) this[${k}] = v;`).join(' ');
+  const copy = fields.map((f, i) => `${keys[i]}: ${f.kind === 'struct' || f.array ? `h.plain(this[${keys[i]}])` : `this[${keys[i]}]`}`).join(', ');
+  return `return class ${ident} extends Base {
+  ${fields.map(accessor).join('\n  ')}
+  assign(o) { if (o == null) return this; let v; ${assign} return this; }
+  toObject() { return { ${copy} }; }
+};`;
+}
+
+// What struct views and vector records share.
+class StructRecord {
+  toJSON() { return this.toObject(); }
+}
+
+// A window onto memory at $offset; move $offset by Type.size to walk an
+// array of records.
+class StructView extends StructRecord {
+  constructor(memory, offset = 0) {
+    super();
+    this.$view = dataView(memory, offset + this.constructor.size);
+    this.$offset = offset;
+  }
+
+  // BigInt address of the struct, for the pointers addon or dl calls
+  get $address() { return types.address(this.$view) + BigInt(this.$offset); }
+}
+
+// struct(name, fields, { packed, pack, align }) -> struct type
+// fields: [[name, type], ...] or { name: type, ... } with C type names
+// ("int", "unsigned long", "double", "char[16]", "void*", another struct).
+// The type is a class: new T(memory, offset) / T.at(...) is a view whose
+// fields read and write the memory directly; T.size, T.align, T.fields
+// describe the layout.
+types.struct = (name, fields, opts) => {
+  const layout = types.defineStruct(name, fields, opts);
+  const T = new Function('Base', 'h', classSource(layout.name, layout.fields, (f) => accessorSource(f)))(StructView, helpers);
+  Object.assign(T, {
+    size: layout.size,
+    align: layout.align,
+    fields: layout.fields,
+    layout,
+    at: (memory, offset = 0) => new T(memory, offset),
+    // a zeroed ArrayBuffer for count records, viewed at the first
+    alloc: (count = 1) => new T(new ArrayBuffer(layout.size * count), 0),
+    read: (memory, offset = 0) => new T(memory, offset).toObject(),
+    write: (memory, obj, offset = 0) => new T(memory, offset).assign(obj),
+    offsetof: (field) => {
+      const f = layout.fields.find((x) => x.name === field);
+      if (!f) throw new TypeError(`No field '${field}' in struct ${layout.name}`);
+      return f.offset;
+    },
+  });
+  types.structs[layout.name] = T;
+  return T;
+};
+
+// ---------- vectors ----------
+
+// Record i of a vector. It reads the vector's current buffers through
+// $buf (shared with the vector and updated when it grows), so it stays
+// valid across appends.
+class VectorRecord extends StructRecord {
+  constructor(vec, buf, index) {
+    super();
+    this.$vec = vec;
+    this.$buf = buf;
+    this.$index = index;
+  }
+}
+
+// The record class of Type for one layout, generated once: aos fields sit
+// at index * size + offset in buffer 0, soa fields at index * width in
+// their own column.
+function recordClass(T, soa) {
+  const key = soa ? '$soaRecord' : '$aosRecord';
+  if (T[key]) return T[key];
+  const src = classSource(`${T.layout.name}Record`, T.fields, (f, k) => (soa
+    ? accessorSource(f, `this.$buf.cols[${k}]`, `this.$index * ${f.size * f.count}`)
+    : accessorSource(f, 'this.$buf.cols[0]', `this.$index * ${T.size} + ${f.offset}`)));
+  const R = new Function('Base', 'h', src)(VectorRecord, helpers);
+  R.fields = T.fields;
+  R.size = T.size;
+  T[key] = R;
+  return R;
+}
+
+const proto = types.StructVector.prototype;
+
+function setup(vec, T) {
+  vec.type = T;
+  vec.$buf = { cols: [], length: vec.count, capacity: 0 };
+  vec.$Record = recordClass(T, vec.soa);
+  vec.$cursor = new vec.$Record(vec, vec.$buf, 0);
+  vec.$refresh();
+  return vec;
+}
+
+proto.$refresh = function () {
+  this.$buf.cols = this.buffers().map((b) => new DataView(b));
+  this.$buf.capacity = this.capacity;
+};
+
+// The native count and capacity, mirrored in $buf so reads stay in JS.
+Object.defineProperty(proto, 'length', {
+  get() { return this.$buf.length; },
+  set(n) {
+    this.count = n;
+    this.$buf.length = n;
+  },
+});
+
+// The native $reserve and $appendBytes can move the storage, so these
+// refresh the views and the mirrored count after them.
+proto.reserve = function (n) {
+  if (n > this.$buf.capacity && this.$reserve(n)) this.$refresh();
+  return this;
+};
+
+proto.appendBytes = function (bytes) {
+  this.$appendBytes(bytes);
+  this.$refresh();
+  this.$buf.length = this.count;
+  return this.length;
+};
+
+proto.get = function (i) {
+  const buf = this.$buf;
+  if (!(i >= 0 && i < buf.length)) throw new RangeError(`Index ${i} out of range (length ${buf.length})`);
+  return new this.$Record(this, buf, i);
+};
+
+proto.set = function (i, obj) {
+  this.get(i).assign(obj);
+  return this;
+};
+
+proto.push = function (...items) {
+  if (items.length !== 1) return this.append(items);
+  const n = this.$buf.length;
+  if (n === this.$buf.capacity) this.reserve(n + 1);
+  this.$cursor.$index = n;
+  this.$cursor.assign(items[0]);
+  this.length = n + 1;
+  return n + 1;
+};
+
+// append(items) -> new length. items: objects (or records of any struct
+// vector / view with the same field names), or raw records in the struct's
+// C layout as an ArrayBuffer / typed array / Buffer, copied in natively.
+proto.append = function (items) {
+  if (items instanceof ArrayBuffer || ArrayBuffer.isView(items)) return this.appendBytes(items);
+  if (items instanceof types.StructVector && !items.soa && items.type === this.type) {
+    return this.append(new Uint8Array(items.buffers()[0], 0, items.length * this.type.size));
+  }
+  const list = Array.isArray(items) ? items : Array.from(items);
+  const start = this.length;
+  this.reserve(start + list.length);
+  const cursor = this.$cursor;
+  for (let i = 0; i < list.length; i++) {
+    cursor.$index = start + i;
+    cursor.assign(list[i]);
+  }
+  this.length = start + list.length;
+  return this.length;
+};
+
+// column(field): soa -> typed array over the column itself (char[n] and
+// nested fields as bytes); aos -> a copy, the field being strided.
+proto.column = function (field) {
+  const k = this.type.fields.findIndex((f) => f.name === field);
+  if (k < 0) throw new TypeError(`No field '${field}' in struct ${this.type.layout.name}`);
+  const f = this.type.fields[k];
+  const typed = !f.array && scalars[f.kind] && f.kind !== 'bool' ? scalars[f.kind][1] : null;
+  if (this.soa) {
+    const buffer = this.buffers()[k];
+    return typed ? new typed(buffer, 0, this.length) : new Uint8Array(buffer, 0, this.length * f.size * f.count);
+  }
+  const n = this.length;
+  const out = typed ? new typed(n) : new Array(n);
+  const cursor = this.$cursor;
+  for (let i = 0; i < n; i++) {
+    cursor.$index = i;
+    out[i] = cursor[field];
+  }
+  return out;
+};
+
+proto.sortBy = function (field, { descending = false } = {}) {
+  this.sort(field, descending);
+  return this;
+};
+
+proto.clear = function () {
+  this.length = 0;
+  return this;
+};
+
+proto.toArray = function () {
+  const n = this.length, cursor = this.$cursor, out = new Array(n);
+  for (let i = 0; i < n; i++) {
+    cursor.$index = i;
+    out[i] = cursor.toObject();
+  }
+  return out;
+};
+
+// Fresh record objects; the loop stops at the length when it started.
+proto[Symbol.iterator] = function* () {
+  const n = this.length, Record = this.$Record, buf = this.$buf;
+  for (let i = 0; i < n; i++) yield new Record(this, buf, i);
+};
+
+proto.toJSON = function () { return this.toArray(); };
+
+// vector(Type, capacity, { layout: 'aos' | 'soa' }) -> StructVector of
+// Type (a struct type or its name) in contiguous buffers: one array of C
+// records (aos) or one array per field (soa).
+types.vector = (T, capacity = 0, { layout = 'aos' } = {}) => {
+  if (typeof T === 'string') T = types.structs[T];
+  if (!T || !T.layout) throw new TypeError('Expected a struct type from types.struct');
+  if (layout !== 'aos' && layout !== 'soa') throw new TypeError("layout must be 'aos' or 'soa'");
+  return setup(new types.StructVector(T.layout.name, capacity, layout === 'soa'), T);
+};
+
+// loadVector(path, { layout }) -> the vector saved with vec.save(path); its
+// struct must be defined (with the same layout) first.
+types.loadVector = (path, { layout } = {}) => {
+  const vec = types.StructVector.load(String(path), layout === undefined ? undefined : layout === 'soa');
+  return setup(vec, types.structs[vec.structName]);
+};
+
 module.exports = addon
@@ -6,6 +6,13 @@
 #include <variant>
 #include <unordered_map>
 #include <memory>
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+#include "layout.h"
 
 using namespace Napi;
 
@@ -157,9 +164,519 @@ Object MakeHelpers(Napi::Env env) {
     return types;
 }
 
+// Struct types defined with types.struct, by name (for nesting and vectors)
+std::unordered_map<std::string, std::shared_ptr<const Layout>> structTypes;
+
+std::shared_ptr<const Layout> findStruct(const std::string& name) {
+    auto it = structTypes.find(name);
+    return it == structTypes.end() ? nullptr : it->second;
+}
+
+Napi::Object DescribeStruct(Napi::Env env, const Layout& layout) {
+    Napi::Object out = Napi::Object::New(env);
+    out.Set("name", layout.name);
+    out.Set("size", Napi::Number::New(env, layout.size));
+    out.Set("align", Napi::Number::New(env, layout.align));
+    Napi::Array fields = Napi::Array::New(env, layout.fields.size());
+    for (size_t i = 0; i < layout.fields.size(); i++) {
+        const Field& f = layout.fields[i];
+        Napi::Object d = Napi::Object::New(env);
+        d.Set("name", f.name);
+        d.Set("type", f.type);
+        d.Set("kind", kindName(f.kind));
+        d.Set("offset", Napi::Number::New(env, f.offset));
+        d.Set("size", Napi::Number::New(env, f.size));
+        d.Set("align", Napi::Number::New(env, f.align));
+        d.Set("count", Napi::Number::New(env, f.count));
+        d.Set("array", Napi::Boolean::New(env, f.array));
+        if (f.layout) d.Set("struct", DescribeStruct(env, *f.layout));
+        fields.Set(i, d);
+    }
+    out.Set("fields", fields);
+    return out;
+}
+
+// struct(name, fields, { packed, pack, align }) -> layout description
+// fields: [[name, type], ...], [{ name, type }, ...] or { name: type, ... }
+Napi::Value DefineStruct(const CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 2 || !info[0].IsString() || !info[1].IsObject()) {
+        TypeError::New(env, "Expected struct name and fields").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    std::string name = info[0].As<Napi::String>().Utf8Value();
+    std::vector<std::pair<std::string, std::string>> specs;
+    if (info[1].IsArray()) {
+        Napi::Array list = info[1].As<Napi::Array>();
+        for (uint32_t i = 0; i < list.Length(); i++) {
+            Napi::Value item = list.Get(i);
+            if (item.IsArray() && item.As<Napi::Array>().Length() >= 2) {
+                Napi::Array pair = item.As<Napi::Array>();
+                specs.emplace_back(pair.Get(0u).ToString().Utf8Value(), pair.Get(1u).ToString().Utf8Value());
+            } else if (item.IsObject() && item.As<Napi::Object>().Has("name") && item.As<Napi::Object>().Has("type")) {
+                Napi::Object f = item.As<Napi::Object>();
+                specs.emplace_back(f.Get("name").ToString().Utf8Value(), f.Get("type").ToString().Utf8Value());
+            } else {
+                TypeError::New(env, "Each field must be [name, type] or { name, type }").ThrowAsJavaScriptException();
+                return env.Undefined();
+            }
+        }
+    } else {
+        Napi::Object map = info[1].As<Napi::Object>();
+        Napi::Array keys = map.GetPropertyNames();
+        for (uint32_t i = 0; i < keys.Length(); i++) {
+            std::string key = keys.Get(i).ToString().Utf8Value();
+            specs.emplace_back(key, map.Get(key).ToString().Utf8Value());
+        }
+    }
+
+    size_t pack = 0, minAlign = 0;
+    if (info.Length() > 2 && info[2].IsObject()) {
+        Napi::Object opts = info[2].As<Napi::Object>();
+        if (opts.Get("packed").ToBoolean()) pack = 1;
+        if (opts.Get("pack").IsNumber()) pack = opts.Get("pack").As<Napi::Number>().Int64Value();
+        if (opts.Get("align").IsNumber()) minAlign = opts.Get("align").As<Napi::Number>().Int64Value();
+    }
+
+    try {
+        auto layout = buildLayout(name, specs, pack, minAlign, findStruct);
+        structTypes[name] = layout;
+        dynamicTypes[name] = { layout->size, layout->align };
+        return DescribeStruct(env, *layout);
+    } catch (const std::exception& e) {
+        TypeError::New(env, e.what()).ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+}
+
+// Raw address from a BigInt / number (pointers addon) or an External (dl).
+bool AddressOf(const Napi::Value& v, uintptr_t& addr) {
+    if (v.IsBigInt()) {
+        bool lossless;
+        addr = static_cast<uintptr_t>(v.As<Napi::BigInt>().Uint64Value(&lossless));
+    } else if (v.IsNumber()) {
+        addr = static_cast<uintptr_t>(v.As<Napi::Number>().Int64Value());
+    } else if (v.IsExternal()) {
+        addr = reinterpret_cast<uintptr_t>(v.As<Napi::External<void>>().Data());
+    } else if (v.IsArrayBuffer()) {
+        addr = reinterpret_cast<uintptr_t>(v.As<Napi::ArrayBuffer>().Data());
+    } else if (v.IsTypedArray()) {
+        Napi::TypedArray a = v.As<Napi::TypedArray>();
+        addr = reinterpret_cast<uintptr_t>(a.ArrayBuffer().Data()) + a.ByteOffset();
+    } else if (v.IsDataView()) {
+        Napi::DataView d = v.As<Napi::DataView>();
+        addr = reinterpret_cast<uintptr_t>(d.ArrayBuffer().Data()) + d.ByteOffset();
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// view(pointer, length) -> ArrayBuffer over native memory, not owned
+Napi::Value View(const CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    uintptr_t addr;
+    if (info.Length() < 2 || !AddressOf(info[0], addr) || !info[1].IsNumber()) {
+        TypeError::New(env, "Expected pointer and length").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    if (addr == 0) {
+        TypeError::New(env, "Null pointer").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    size_t length = info[1].As<Napi::Number>().Int64Value();
+    return Napi::ArrayBuffer::New(env, reinterpret_cast<void*>(addr), length);
+}
+
+// address(memory) -> BigInt, for the pointers addon
+Napi::Value Address(const CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    uintptr_t addr;
+    if (info.Length() < 1 || !AddressOf(info[0], addr)) {
+        TypeError::New(env, "Expected a pointer, ArrayBuffer or typed array").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    return Napi::BigInt::New(env, static_cast<uint64_t>(addr));
+}
+
+// pointer(memory) -> External, for dl-bound functions taking a pointer
+Napi::Value Pointer(const CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    uintptr_t addr;
+    if (info.Length() < 1 || !AddressOf(info[0], addr)) {
+        TypeError::New(env, "Expected a pointer, ArrayBuffer or typed array").ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    return Napi::External<void>::New(env, reinterpret_cast<void*>(addr));
+}
+
+// ---------- struct vectors ----------
+// Records of one struct type in V8-allocated ArrayBuffers: one buffer of
+// size * capacity bytes (aos), or one per field of fieldBytes * capacity
+// (soa). JS reads and writes records through the struct's accessors; here
+// the buffers grow, take raw records in bulk, sort by a field and go to
+// and from files.
+
+static const char kVectorMagic[8] = {'N', 'V', 'S', 'T', 'R', 'U', 'C', 'T'};
+static const uint32_t kVectorVersion = 1;
+
+// Bytes of raw memory from an ArrayBuffer, typed array / Buffer or DataView.
+bool BytesOf(const Napi::Value& v, const uint8_t*& bytes, size_t& length) {
+    if (v.IsArrayBuffer()) {
+        Napi::ArrayBuffer b = v.As<Napi::ArrayBuffer>();
+        bytes = static_cast<const uint8_t*>(b.Data());
+        length = b.ByteLength();
+    } else if (v.IsTypedArray()) {
+        Napi::TypedArray a = v.As<Napi::TypedArray>();
+        bytes = static_cast<const uint8_t*>(a.ArrayBuffer().Data()) + a.ByteOffset();
+        length = a.ByteLength();
+    } else if (v.IsDataView()) {
+        Napi::DataView d = v.As<Napi::DataView>();
+        bytes = static_cast<const uint8_t*>(d.ArrayBuffer().Data()) + d.ByteOffset();
+        length = d.ByteLength();
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Order of n keys of type T read at base + i * stride; NaNs last.
+template <typename T>
+std::vector<size_t> SortOrder(const uint8_t* base, size_t stride, size_t n, bool descending) {
+    std::vector<T> keys(n);
+    for (size_t i = 0; i < n; i++) std::memcpy(&keys[i], base + i * stride, sizeof(T));
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        const T& x = keys[a];
+        const T& y = keys[b];
+        if constexpr (std::is_floating_point_v<T>) {
+            if (std::isnan(x)) return false;
+            if (std::isnan(y)) return true;
+        }
+        return descending ? y < x : x < y;
+    });
+    return order;
+}
+
+// char[n] fields sort as C strings.
+std::vector<size_t> SortOrderChars(const uint8_t* base, size_t stride, size_t width, size_t n, bool descending) {
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        const char* x = reinterpret_cast<const char*>(base + a * stride);
+        const char* y = reinterpret_cast<const char*>(base + b * stride);
+        int c = std::strncmp(x, y, width);
+        return descending ? c > 0 : c < 0;
+    });
+    return order;
+}
+
+class StructVector : public ObjectWrap<StructVector> {
+public:
+    static FunctionReference constructor;
+
+    static Napi::Function Define(Napi::Env env) {
+        Napi::Function func = DefineClass(env, "StructVector", {
+            InstanceAccessor("count", &StructVector::Count, &StructVector::SetCount),
+            InstanceAccessor("capacity", &StructVector::Capacity, nullptr),
+            InstanceAccessor("structName", &StructVector::StructName, nullptr),
+            InstanceAccessor("soa", &StructVector::Soa, nullptr),
+            InstanceMethod("buffers", &StructVector::Buffers),
+            InstanceMethod("$reserve", &StructVector::Reserve),
+            InstanceMethod("$appendBytes", &StructVector::AppendBytes),
+            InstanceMethod("sort", &StructVector::Sort),
+            InstanceMethod("save", &StructVector::Save),
+            StaticMethod("load", &StructVector::Load),
+        });
+        constructor = Napi::Persistent(func);
+        constructor.SuppressDestruct();
+        return func;
+    }
+
+    // new StructVector(structName, capacity, soa)
+    StructVector(const CallbackInfo& info) : ObjectWrap<StructVector>(info) {
+        Napi::Env env = info.Env();
+        if (info.Length() < 1 || !info[0].IsString()) {
+            TypeError::New(env, "Expected a struct type name").ThrowAsJavaScriptException();
+            return;
+        }
+        std::string name = info[0].As<Napi::String>().Utf8Value();
+        layout = findStruct(name);
+        if (!layout) {
+            TypeError::New(env, "Unknown struct type: " + name).ThrowAsJavaScriptException();
+            return;
+        }
+        soa = info.Length() > 2 && info[2].ToBoolean();
+        buffers.resize(Columns());
+        data.resize(Columns(), nullptr);
+        Grow(env, info.Length() > 1 && info[1].IsNumber() ? info[1].As<Napi::Number>().Int64Value() : 0);
+    }
+
+private:
+    std::shared_ptr<const Layout> layout;
+    bool soa = false;
+    size_t count = 0;
+    size_t capacity = 0;
+    std::vector<Napi::Reference<Napi::ArrayBuffer>> buffers;
+    std::vector<uint8_t*> data;
+
+    size_t Columns() const { return soa ? layout->fields.size() : 1; }
+    size_t Width(size_t col) const {
+        return soa ? layout->fields[col].size * layout->fields[col].count : layout->size;
+    }
+
+    // Capacity for at least want records, doubling; existing records are
+    // copied into the new buffers and JS must fetch buffers() again.
+    void Grow(Napi::Env env, size_t want) {
+        if (want <= capacity && !buffers.empty() && !buffers[0].IsEmpty()) return;
+        size_t cap = std::max({want, capacity * 2, size_t{16}});
+        for (size_t c = 0; c < Columns(); c++) {
+            Napi::ArrayBuffer next = Napi::ArrayBuffer::New(env, cap * Width(c));
+            uint8_t* bytes = static_cast<uint8_t*>(next.Data());
+            if (count) std::memcpy(bytes, data[c], count * Width(c));
+            buffers[c] = Napi::Persistent(next);
+            data[c] = bytes;
+        }
+        capacity = cap;
+    }
+
+    // n AoS records (layout->size bytes each) in at the end.
+    void Append(const uint8_t* src, size_t n) {
+        if (!soa) {
+            std::memmove(data[0] + count * layout->size, src, n * layout->size);
+        } else {
+            for (size_t c = 0; c < Columns(); c++) {
+                const Field& f = layout->fields[c];
+                size_t w = Width(c);
+                uint8_t* dst = data[c] + count * w;
+                for (size_t r = 0; r < n; r++) std::memcpy(dst + r * w, src + r * layout->size + f.offset, w);
+            }
+        }
+        count += n;
+    }
+
+    Napi::Value Count(const CallbackInfo& info) { return Napi::Number::New(info.Env(), count); }
+
+    // JS writes new records through views, then moves count; shrinking drops records.
+    void SetCount(const CallbackInfo& info, const Napi::Value& value) {
+        size_t n = value.As<Napi::Number>().Int64Value();
+        if (n > capacity) {
+            RangeError::New(info.Env(), "count beyond capacity; reserve() first").ThrowAsJavaScriptException();
+            return;
+        }
+        count = n;
+    }
+
+    Napi::Value Capacity(const CallbackInfo& info) { return Napi::Number::New(info.Env(), capacity); }
+    Napi::Value StructName(const CallbackInfo& info) { return Napi::String::New(info.Env(), layout->name); }
+    Napi::Value Soa(const CallbackInfo& info) { return Napi::Boolean::New(info.Env(), soa); }
+
+    Napi::Value Buffers(const CallbackInfo& info) {
+        Napi::Array out = Napi::Array::New(info.Env(), Columns());
+        for (size_t c = 0; c < Columns(); c++) out.Set(c, buffers[c].Value());
+        return out;
+    }
+
+    // $reserve(n) -> true when the buffers were replaced
+    Napi::Value Reserve(const CallbackInfo& info) {
+        size_t before = capacity;
+        Grow(info.Env(), info[0].As<Napi::Number>().Int64Value());
+        return Napi::Boolean::New(info.Env(), capacity != before);
+    }
+
+    // $appendBytes(bytes) -> records appended; bytes hold whole records in
+    // the struct's C layout (a binary file, another vector's buffer, ...)
+    Napi::Value AppendBytes(const CallbackInfo& info) {
+        Napi::Env env = info.Env();
+        const uint8_t* src;
+        size_t length;
+        if (info.Length() < 1 || !BytesOf(info[0], src, length)) {
+            TypeError::New(env, "Expected an ArrayBuffer, typed array or DataView").ThrowAsJavaScriptException();
+            return env.Undefined();
+        }
+        if (layout->size == 0 || length % layout->size) {
+            RangeError::New(env, "Byte length is not a whole number of " + layout->name + " records").ThrowAsJavaScriptException();
+            return env.Undefined();
+        }
+        size_t n = length / layout->size;
+        // src may sit in one of our own buffers, which Grow replaces but
+        // JS keeps alive for the duration of the call
+        Grow(env, count + n);
+        Append(src, n);
+        return Napi::Number::New(env, n);
+    }
+
+    // sort(field, descending) in place; stable
+    Napi::Value Sort(const CallbackInfo& info) {
+        Napi::Env env = info.Env();
+        std::string name = info[0].ToString().Utf8Value();
+        bool descending = info.Length() > 1 && info[1].ToBoolean();
+        const Field* f = layout->find(name);
+        if (!f) {
+            TypeError::New(env, "No field '" + name + "' in struct " + layout->name).ThrowAsJavaScriptException();
+            return env.Undefined();
+        }
+        size_t col = soa ? static_cast<size_t>(f - layout->fields.data()) : 0;
+        const uint8_t* base = data[col] + (soa ? 0 : f->offset);
+        size_t stride = Width(col);
+        std::vector<size_t> order;
+        if (f->array && f->kind == Kind::Char) {
+            order = SortOrderChars(base, stride, f->count, count, descending);
+        } else if (f->array || f->kind == Kind::Struct) {
+            TypeError::New(env, "Cannot sort by field '" + name + "' of type " + f->type).ThrowAsJavaScriptException();
+            return env.Undefined();
+        } else {
+            switch (f->kind) {
+            case Kind::I8: order = SortOrder<int8_t>(base, stride, count, descending); break;
+            case Kind::U8: case Kind::Bool: order = SortOrder<uint8_t>(base, stride, count, descending); break;
+            case Kind::I16: order = SortOrder<int16_t>(base, stride, count, descending); break;
+            case Kind::U16: order = SortOrder<uint16_t>(base, stride, count, descending); break;
+            case Kind::I32: order = SortOrder<int32_t>(base, stride, count, descending); break;
+            case Kind::U32: order = SortOrder<uint32_t>(base, stride, count, descending); break;
+            case Kind::I64: order = SortOrder<int64_t>(base, stride, count, descending); break;
+            case Kind::U64: order = SortOrder<uint64_t>(base, stride, count, descending); break;
+            case Kind::F32: order = SortOrder<float>(base, stride, count, descending); break;
+            case Kind::F64: order = SortOrder<double>(base, stride, count, descending); break;
+            case Kind::Char: order = SortOrder<char>(base, stride, count, descending); break;
+            case Kind::Ptr: order = SortOrder<uintptr_t>(base, stride, count, descending); break;
+            case Kind::Struct: break;
+            }
+        }
+        for (size_t c = 0; c < Columns(); c++) {
+            size_t w = Width(c);
+            std::vector<uint8_t> sorted(count * w);
+            for (size_t i = 0; i < count; i++) std::memcpy(sorted.data() + i * w, data[c] + order[i] * w, w);
+            if (!sorted.empty()) std::memcpy(data[c], sorted.data(), sorted.size());
+        }
+        return info.This();
+    }
+
+    // File: magic, version, soa flag, count, the struct's name and field
+    // table (checked on load), then each buffer's used bytes. Native byte
+    // order.
+    Napi::Value Save(const CallbackInfo& info) {
+        Napi::Env env = info.Env();
+        std::string path = info[0].ToString().Utf8Value();
+        FILE* fp = std::fopen(path.c_str(), "wb");
+        if (!fp) {
+            Napi::Error::New(env, "Cannot open " + path + ": " + std::strerror(errno)).ThrowAsJavaScriptException();
+            return env.Undefined();
+        }
+        auto u32 = [&](uint32_t v) { std::fwrite(&v, sizeof v, 1, fp); };
+        auto str = [&](const std::string& v) { u32(static_cast<uint32_t>(v.size())); std::fwrite(v.data(), 1, v.size(), fp); };
+        std::fwrite(kVectorMagic, 1, sizeof kVectorMagic, fp);
+        u32(kVectorVersion);
+        u32(soa ? 1 : 0);
+        uint64_t n = count;
+        std::fwrite(&n, sizeof n, 1, fp);
+        str(layout->name);
+        u32(static_cast<uint32_t>(layout->size));
+        u32(static_cast<uint32_t>(layout->fields.size()));
+        for (const Field& f : layout->fields) {
+            str(f.name);
+            u32(static_cast<uint32_t>(f.kind));
+            u32(static_cast<uint32_t>(f.offset));
+            u32(static_cast<uint32_t>(f.size));
+            u32(static_cast<uint32_t>(f.count));
+        }
+        bool ok = true;
+        for (size_t c = 0; c < Columns(); c++) {
+            size_t bytes = count * Width(c);
+            if (bytes && std::fwrite(data[c], 1, bytes, fp) != bytes) ok = false;
+        }
+        if (std::fclose(fp) != 0) ok = false;
+        if (!ok) Napi::Error::New(env, "Cannot write " + path + ": " + std::strerror(errno)).ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+
+    // StructVector.load(path, soa?) -> vector in the saved layout, or
+    // converted to soa / aos when given
+    static Napi::Value Load(const CallbackInfo& info) {
+        Napi::Env env = info.Env();
+        std::string path = info[0].ToString().Utf8Value();
+        FILE* fp = std::fopen(path.c_str(), "rb");
+        if (!fp) {
+            Napi::Error::New(env, "Cannot open " + path + ": " + std::strerror(errno)).ThrowAsJavaScriptException();
+            return env.Undefined();
+        }
+        std::unique_ptr<FILE, int (*)(FILE*)> closer(fp, std::fclose);
+        bool ok = true;
+        auto read = [&](void* p, size_t n) { if (n && std::fread(p, 1, n, fp) != n) ok = false; };
+        auto u32 = [&]() { uint32_t v = 0; read(&v, sizeof v); return v; };
+        auto str = [&]() {
+            uint32_t n = u32();
+            if (!ok || n > 4096) { ok = false; return std::string(); }
+            std::string v(n, '\0');
+            read(v.data(), n);
+            return v;
+        };
+        auto fail = [&](const std::string& why) {
+            Napi::Error::New(env, path + ": " + why).ThrowAsJavaScriptException();
+            return env.Undefined();
+        };
+
+        char magic[sizeof kVectorMagic];
+        read(magic, sizeof magic);
+        if (!ok || std::memcmp(magic, kVectorMagic, sizeof magic) != 0) return fail("not a saved struct vector");
+        if (u32() != kVectorVersion) return fail("unsupported version");
+        bool savedSoa = u32() != 0;
+        uint64_t n = 0;
+        read(&n, sizeof n);
+        std::string name = str();
+        if (!ok) return fail("truncated header");
+        auto layout = findStruct(name);
+        if (!layout) return fail("struct " + name + " is not defined; define it with types.struct first");
+        bool same = u32() == layout->size;
+        uint32_t fields = u32();
+        same = same && fields == layout->fields.size();
+        for (uint32_t i = 0; ok && same && i < fields; i++) {
+            const Field& f = layout->fields[i];
+            same = str() == f.name && u32() == static_cast<uint32_t>(f.kind) && u32() == f.offset
+                && u32() == f.size && u32() == f.count;
+        }
+        if (!ok) return fail("truncated header");
+        if (!same) return fail("saved layout of " + name + " does not match its current definition");
+
+        bool targetSoa = info.Length() > 1 && info[1].IsBoolean() ? info[1].As<Napi::Boolean>().Value() : savedSoa;
+        Napi::Object obj = constructor.New({ Napi::String::New(env, name), Napi::Number::New(env, static_cast<double>(n)),
+                                             Napi::Boolean::New(env, targetSoa) });
+        StructVector* v = Unwrap(obj);
+        if (savedSoa == targetSoa) {
+            for (size_t c = 0; c < v->Columns(); c++) read(v->data[c], n * v->Width(c));
+            v->count = n;
+        } else if (!savedSoa) {
+            std::vector<uint8_t> records(n * layout->size);
+            read(records.data(), records.size());
+            v->Append(records.data(), n);
+        } else {
+            // soa file into aos: each column scattered to its field offset
+            std::vector<uint8_t> column;
+            for (const Field& f : layout->fields) {
+                size_t w = f.size * f.count;
+                column.resize(n * w);
+                read(column.data(), column.size());
+                for (size_t r = 0; r < n; r++) std::memcpy(v->data[0] + r * layout->size + f.offset, column.data() + r * w, w);
+            }
+            v->count = n;
+        }
+        if (!ok) return fail("truncated data");
+        return obj;
+    }
+};
+
+FunctionReference StructVector::constructor;
+
 Object InitAll(Napi::Env env, Object exports) {
     TypedValue::Init(env, exports);
-    exports.Set("types", MakeHelpers(env));
+    Napi::Object types = MakeHelpers(env);
+    types.Set("defineStruct", Napi::Function::New(env, DefineStruct));
+    types.Set("view", Napi::Function::New(env, View));
+    types.Set("address", Napi::Function::New(env, Address));
+    types.Set("pointer", Napi::Function::New(env, Pointer));
+    types.Set("charSigned", Napi::Boolean::New(env, std::is_signed_v<char>));
+    types.Set("StructVector", StructVector::Define(env));
+    exports.Set("types", types);
     return exports;
 }
 
@@ -0,0 +1,203 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// C struct layout: field types named as in C ("int", "unsigned long",
+// "char[16]", "double*", "struct Point") with this platform's sizes and
+// alignments, offsets under natural alignment or #pragma pack(n), nested
+// structs and fixed-size arrays.
+
+enum class Kind { I8, U8, I16, U16, I32, U32, I64, U64, F32, F64, Bool, Char, Ptr, Struct };
+
+struct Layout;
+
+struct Field {
+    std::string name;
+    std::string type;       // as written, e.g. "unsigned int[4]"
+    Kind kind;
+    std::shared_ptr<const Layout> layout;  // Kind::Struct only
+    size_t offset = 0;
+    size_t size = 0;        // one element
+    size_t align = 1;       // after packing
+    size_t count = 1;       // elements; arrays may have 0 (trailing flexible member)
+    bool array = false;
+};
+
+struct Layout {
+    std::string name;
+    size_t size = 0;
+    size_t align = 1;
+    std::vector<Field> fields;
+
+    const Field* find(const std::string& field) const {
+        for (const Field& f : fields)
+            if (f.name == field) return &f;
+        return nullptr;
+    }
+};
+
+struct Scalar {
+    Kind kind;
+    size_t size, align;
+};
+
+template <typename T>
+static Scalar scalarOf(Kind k) { return {k, sizeof(T), alignof(T)}; }
+
+// int / long / size_t ... to the fixed-width kind of the same size here.
+template <typename T>
+static Scalar integerOf() {
+    constexpr bool s = std::is_signed_v<T>;
+    Kind k = sizeof(T) == 1 ? (s ? Kind::I8 : Kind::U8)
+           : sizeof(T) == 2 ? (s ? Kind::I16 : Kind::U16)
+           : sizeof(T) == 4 ? (s ? Kind::I32 : Kind::U32)
+           : (s ? Kind::I64 : Kind::U64);
+    return {k, sizeof(T), alignof(T)};
+}
+
+static const std::unordered_map<std::string, Scalar>& scalarTypes() {
+    static const std::unordered_map<std::string, Scalar> types = {
+        {"int8", integerOf<int8_t>()}, {"int8_t", integerOf<int8_t>()},
+        {"uint8", integerOf<uint8_t>()}, {"uint8_t", integerOf<uint8_t>()},
+        {"int16", integerOf<int16_t>()}, {"int16_t", integerOf<int16_t>()},
+        {"uint16", integerOf<uint16_t>()}, {"uint16_t", integerOf<uint16_t>()},
+        {"int32", integerOf<int32_t>()}, {"int32_t", integerOf<int32_t>()},
+        {"uint32", integerOf<uint32_t>()}, {"uint32_t", integerOf<uint32_t>()},
+        {"int64", integerOf<int64_t>()}, {"int64_t", integerOf<int64_t>()},
+        {"uint64", integerOf<uint64_t>()}, {"uint64_t", integerOf<uint64_t>()},
+        {"signed char", integerOf<signed char>()},
+        {"unsigned char", integerOf<unsigned char>()}, {"uchar", integerOf<unsigned char>()},
+        {"short", integerOf<short>()}, {"unsigned short", integerOf<unsigned short>()},
+        {"int", integerOf<int>()}, {"signed", integerOf<int>()},
+        {"unsigned int", integerOf<unsigned>()}, {"unsigned", integerOf<unsigned>()}, {"uint", integerOf<unsigned>()},
+        {"long", integerOf<long>()}, {"unsigned long", integerOf<unsigned long>()}, {"ulong", integerOf<unsigned long>()},
+        {"long long", integerOf<long long>()}, {"unsigned long long", integerOf<unsigned long long>()},
+        {"size_t", integerOf<size_t>()}, {"ssize_t", integerOf<ptrdiff_t>()}, {"ptrdiff_t", integerOf<ptrdiff_t>()},
+        {"intptr_t", integerOf<intptr_t>()}, {"uintptr_t", integerOf<uintptr_t>()},
+        {"float", scalarOf<float>(Kind::F32)}, {"float32", scalarOf<float>(Kind::F32)},
+        {"double", scalarOf<double>(Kind::F64)}, {"float64", scalarOf<double>(Kind::F64)},
+        {"bool", scalarOf<bool>(Kind::Bool)},
+        {"char", scalarOf<char>(Kind::Char)},
+        {"pointer", scalarOf<void*>(Kind::Ptr)},
+    };
+    return types;
+}
+
+static std::string trimType(std::string s) {
+    // collapse runs of spaces, drop them around '*' / '[' and at the ends
+    std::string out;
+    for (char c : s) {
+        if (c == ' ' || c == '\t') {
+            if (!out.empty() && out.back() != ' ') out += ' ';
+            continue;
+        }
+        if ((c == '*' || c == '[' || c == ']') && !out.empty() && out.back() == ' ') out.pop_back();
+        out += c;
+    }
+    if (!out.empty() && out.back() == ' ') out.pop_back();
+    for (const char* q : {"const ", "volatile "})
+        while (out.compare(0, std::char_traits<char>::length(q), q) == 0) out.erase(0, std::char_traits<char>::length(q));
+    return out;
+}
+
+using StructLookup = std::function<std::shared_ptr<const Layout>(const std::string&)>;
+
+// Kind, size and alignment of one field type (without packing).
+static Field resolveField(const std::string& name, const std::string& written, const StructLookup& lookup) {
+    Field f;
+    f.name = name;
+    f.type = written;
+    std::string t = trimType(written);
+
+    if (!t.empty() && t.back() == ']') {
+        size_t open = t.rfind('[');
+        if (open == std::string::npos) throw std::runtime_error("Bad array type: " + written);
+        std::string n = t.substr(open + 1, t.size() - open - 2);
+        if (n.empty() || n.find_first_not_of("0123456789") != std::string::npos)
+            throw std::runtime_error("Bad array length in type: " + written);
+        f.count = std::stoull(n);
+        f.array = true;
+        t = trimType(t.substr(0, open));
+        if (!t.empty() && t.back() == ']') throw std::runtime_error("Multi-dimensional arrays are not supported: " + written);
+    }
+
+    if (!t.empty() && t.back() == '*') {
+        Scalar p = scalarOf<void*>(Kind::Ptr);
+        f.kind = p.kind; f.size = p.size; f.align = p.align;
+        return f;
+    }
+    if (t.compare(0, 7, "struct ") == 0) t.erase(0, 7);
+    auto& scalars = scalarTypes();
+    auto it = scalars.find(t);
+    if (it != scalars.end()) {
+        f.kind = it->second.kind; f.size = it->second.size; f.align = it->second.align;
+        return f;
+    }
+    auto nested = lookup(t);
+    if (!nested) throw std::runtime_error("Unknown field type: " + written);
+    f.kind = Kind::Struct;
+    f.layout = nested;
+    f.size = nested->size;
+    f.align = nested->align;
+    return f;
+}
+
+static size_t alignUp(size_t n, size_t a) { return (n + a - 1) / a * a; }
+
+static bool isPow2(size_t n) { return n && !(n & (n - 1)); }
+
+// pack: 0 for natural alignment, else each field's alignment is capped at
+// pack as with #pragma pack(n) (1 = packed). minAlign raises the struct's
+// own alignment as __attribute__((aligned(n))) does.
+static std::shared_ptr<Layout> buildLayout(const std::string& name,
+                                           const std::vector<std::pair<std::string, std::string>>& specs,
+                                           size_t pack, size_t minAlign, const StructLookup& lookup) {
+    if (pack && !isPow2(pack)) throw std::runtime_error("pack must be a power of two");
+    if (minAlign && !isPow2(minAlign)) throw std::runtime_error("align must be a power of two");
+    auto out = std::make_shared<Layout>();
+    out->name = name;
+    size_t offset = 0;
+    for (size_t i = 0; i < specs.size(); i++) {
+        const auto& [fname, ftype] = specs[i];
+        if (fname.empty()) throw std::runtime_error("Field without a name in struct " + name);
+        if (out->find(fname)) throw std::runtime_error("Duplicate field '" + fname + "' in struct " + name);
+        Field f = resolveField(fname, ftype, lookup);
+        if (f.array && f.count == 0 && i + 1 != specs.size())
+            throw std::runtime_error("Only the last field may be a zero-length array: " + fname);
+        if (pack && f.align > pack) f.align = pack;
+        f.offset = alignUp(offset, f.align);
+        offset = f.offset + f.size * f.count;
+        if (f.align > out->align) out->align = f.align;
+        out->fields.push_back(std::move(f));
+    }
+    if (minAlign > out->align) out->align = minAlign;
+    out->size = alignUp(offset, out->align);
+    return out;
+}
+
+static const char* kindName(Kind k) {
+    switch (k) {
+    case Kind::I8: return "int8";
+    case Kind::U8: return "uint8";
+    case Kind::I16: return "int16";
+    case Kind::U16: return "uint16";
+    case Kind::I32: return "int32";
+    case Kind::U32: return "uint32";
+    case Kind::I64: return "int64";
+    case Kind::U64: return "uint64";
+    case Kind::F32: return "float32";
+    case Kind::F64: return "float64";
+    case Kind::Bool: return "bool";
+    case Kind::Char: return "char";
+    case Kind::Ptr: return "pointer";
+    case Kind::Struct: return "struct";
+    }
+    return "?";
+}
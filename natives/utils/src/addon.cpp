@@ -48,9 +48,11 @@ Napi::Value Exit(const Napi::CallbackInfo &info)
     exit(code);
     return Napi::Number::New(env, code);
 }
-#include <mutex>
-#include <condition_variable>
+#include "../../async/src/await.h"
 
+// Blocking on a condition variable would deadlock: the promise settles on
+// this same thread. The async addon's awaitBlock loop (await.h) runs the
+// ticks and the event loop until it settles, with the same nesting limit.
 Napi::Value AwaitSync(const Napi::CallbackInfo &info)
 {
     Napi::Env env = info.Env();
@@ -61,59 +63,12 @@ Napi::Value AwaitSync(const Napi::CallbackInfo &info)
         return env.Undefined();
     }
 
-    Napi::Promise promise = info[0].As<Napi::Promise>();
-
-    // Mutex and condition variable to block the thread
-    std::mutex mtx;
-    std::condition_variable cv;
-    bool completed = false;
-    Napi::Value result = env.Undefined();
-    Napi::Value error = env.Undefined();
-
-    // The deferred callback is used to resolve/reject the internal promise
-    Napi::Reference<Napi::Promise> wrappedPromiseRef = Napi::Persistent(promise);
-
-    // Callbacks for promise resolution/rejection
-    auto onFulfilled = [&](const Napi::CallbackInfo &info)
-    {
-        std::lock_guard<std::mutex> lock(mtx);
-        // Get the first argument from the callback info
-        result = info[0];
-        completed = true;
-        cv.notify_one();
-    };
-
-    auto onRejected = [&](const Napi::CallbackInfo &info)
-    {
-        std::lock_guard<std::mutex> lock(mtx);
-        // Get the first argument from the callback info
-        error = info[0];
-        completed = true;
-        cv.notify_one();
-    };
-
-    // Attach callbacks to the promise
-    promise.As<Napi::Object>().Set("then", Napi::Function::New(env, onFulfilled));
-    promise.As<Napi::Object>().Set("catch", Napi::Function::New(env, onRejected));
-
-    // The blocking loop
-    {
-        std::unique_lock<std::mutex> lock(mtx);
-        cv.wait(lock, [&]
-                { return completed; });
-    }
-
-    // Clean up the persistent reference
-    wrappedPromiseRef.Unref();
-
-    // Check if an error occurred and throw it
-    if (!error.IsUndefined())
-    {
-        Napi::Error jsError = error.As<Napi::Error>();
-        jsError.ThrowAsJavaScriptException();
-    }
-
-    return result;
+    // Thenables are adopted into a real Promise first.
+    Napi::Object promiseCtor = env.Global().Get("Promise").As<Napi::Object>();
+    Napi::Value promise = promiseCtor.Get("resolve").As<Napi::Function>().Call(promiseCtor, {info[0]});
+    if (env.IsExceptionPending())
+        return env.Undefined();
+    return awaitPromise(env, promise.As<Napi::Promise>(), -1, "awaitSync");
 }
 Napi::Value Sstream(const Napi::CallbackInfo &info)
 {
@@ -0,0 +1,42 @@
+// Lists and greps a generated tree with the addon and with plain fs calls
+// (the recursive readdirSync / read-every-file loop it replaces).
+// usage: node bench.js [files] [threads]
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const walk = require('./index.js');
+
+const files = Number(process.argv[2]) || 100000;
+const threads = Number(process.argv[3]) || 0;
+const root = fs.mkdtempSync(path.join(os.tmpdir(), 'nova-walk-'));
+
+const body = 'let x = compute(1, 2);\nprint(x);\n'.repeat(20);
+for (let i = 0; i < files; i++) {
+  const dir = path.join(root, `d${i % 100}`, `e${Math.floor(i / 100) % 50}`);
+  if (i < 5000) fs.mkdirSync(dir, { recursive: true });
+  fs.writeFileSync(path.join(dir, `f${i}.${i % 4 ? 'nv' : 'txt'}`), i % 997 ? body : body + 'needle_here();\n');
+}
+
+function time(name, fn) {
+  const t0 = process.hrtime.bigint();
+  const n = fn().length;
+  console.log(`${name.padEnd(26)} ${String(n).padStart(7)}  ${(Number(process.hrtime.bigint() - t0) / 1e6).toFixed(0)} ms`);
+}
+
+try {
+  time('walk *.nv', () => walk.walk(root, { pattern: '*.nv', ...(threads && { threads }) }));
+  time('readdirSync recursive', () => fs.readdirSync(root, { recursive: true }).filter((f) => f.endsWith('.nv')));
+  time('search needle_here', () => walk.search(root, { pattern: '*.nv', needle: 'needle_here', ...(threads && { threads }) }));
+  time('serial read + regex', () => {
+    const hits = [];
+    for (const f of fs.readdirSync(root, { recursive: true })) {
+      if (!f.endsWith('.nv')) continue;
+      fs.readFileSync(path.join(root, f), 'utf8').split('\n').forEach((line, i) => {
+        if (/needle_here/.test(line)) hits.push({ file: f, line: i + 1 });
+      });
+    }
+    return hits;
+  });
+} finally {
+  fs.rmSync(root, { recursive: true, force: true });
+}
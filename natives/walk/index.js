@@ -0,0 +1,3 @@
+const addon = require('bindings')('walk');
+
+module.exports = addon
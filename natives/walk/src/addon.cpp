@@ -0,0 +1,474 @@
+#include <napi.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+// Recursive directory listing and content search on a thread pool.
+//
+// Directories are a shared work queue: a worker takes one, reads it with
+// getdents64 (readdir elsewhere) through a descriptor opened relative to the
+// root, filters the entries with the glob/ignore lists and pushes the
+// subdirectories back for any idle worker. d_type saves a stat per entry on
+// every filesystem that fills it in.
+//
+// In search mode each matching file is read by the worker that found it and
+// scanned for a literal needle; only the lines that contain it (or, without
+// a needle, the whole text) go back to JS, which confirms them against the
+// real regex. Binary files (a NUL in the first 8 KB) are skipped like grep
+// does.
+
+static const size_t kDentBuf = 64 * 1024;
+static const size_t kBinaryProbe = 8192;
+
+struct Options {
+    std::vector<std::string> include;   // globs; empty means everything
+    std::vector<std::string> exclude;   // globs; a matching directory is pruned
+    bool hidden = false;                // descend into / list dot entries
+    int maxDepth = -1;                  // 1 = root entries only, -1 = unlimited
+    bool files = true;
+    bool dirs = false;
+    unsigned threads = 0;
+
+    bool search = false;
+    std::string needle;                 // lines containing it; empty = whole files
+    bool ignoreCase = false;            // ASCII only
+    size_t maxFileSize = 64 << 20;
+};
+
+struct Hit {
+    std::string file;
+    uint32_t line;                      // 0 for a whole-file hit
+    std::string text;
+};
+
+struct Result {
+    std::vector<std::string> paths;
+    std::vector<Hit> hits;
+};
+
+// ---------- globs ----------
+// '*' and '?' stop at '/', '**' crosses it, "[a-z]" / "[!x]" are classes.
+// Braces are expanded on the JS side.
+
+// p points at '['; returns -1 for an unterminated class (then '[' is a
+// literal), else whether c is in it, leaving p on the closing ']'.
+static int matchClass(const char*& p, char c) {
+    const char* q = p + 1;
+    bool negate = *q == '!' || *q == '^';
+    if (negate) q++;
+    bool hit = false;
+    for (bool first = true; *q && (*q != ']' || first); q++) {
+        first = false;
+        char lo = *q, hi = lo;
+        if (q[1] == '-' && q[2] && q[2] != ']') { hi = q[2]; q += 2; }
+        if (c >= lo && c <= hi) hit = true;
+    }
+    if (!*q) return -1;
+    p = q;
+    return hit != negate;
+}
+
+static bool globMatch(const char* p, const char* s) {
+    while (*p) {
+        if (p[0] == '*' && p[1] == '*') {
+            p += 2;
+            if (*p == '/') {
+                // "**/" also matches no directory at all
+                if (globMatch(p + 1, s)) return true;
+            }
+            for (;; s++) {
+                if (globMatch(p, s)) return true;
+                if (!*s) return false;
+            }
+        }
+        if (*p == '*') {
+            p++;
+            for (;; s++) {
+                if (globMatch(p, s)) return true;
+                if (!*s || *s == '/') return false;
+            }
+        }
+        if (!*s) return false;
+        if (*p == '?') {
+            if (*s == '/') return false;
+        } else if (*p == '[' && *s != '/') {
+            int m = matchClass(p, *s);
+            if (m == 0) return false;
+            if (m < 0 && *s != '[') return false;
+        } else {
+            if (*p == '\\' && p[1]) p++;
+            if (*p != *s) return false;
+        }
+        p++;
+        s++;
+    }
+    return !*s;
+}
+
+// Patterns with a '/' are matched against the path relative to the root,
+// the rest against the entry name.
+static bool anyMatch(const std::vector<std::string>& globs, const char* name, const std::string& rel) {
+    for (const auto& g : globs)
+        if (globMatch(g.c_str(), g.find('/') == std::string::npos ? name : rel.c_str())) return true;
+    return false;
+}
+
+// ---------- search ----------
+
+// memchr is vectorised in glibc and bionic, so it does the skipping; the
+// last byte is checked before the full compare to drop most false starts.
+static const char* findNeedle(const char* p, const char* end, const std::string& needle) {
+    const size_t n = needle.size();
+    const char first = needle[0], last = needle[n - 1];
+    while (static_cast<size_t>(end - p) >= n) {
+        p = static_cast<const char*>(memchr(p, first, (end - p) - n + 1));
+        if (!p) return nullptr;
+        if (p[n - 1] == last && memcmp(p, needle.data(), n) == 0) return p;
+        p++;
+    }
+    return nullptr;
+}
+
+static const char* lineStart(const char* base, const char* at) {
+#if defined(__GLIBC__) || defined(__ANDROID__)
+    const void* nl = memrchr(base, '\n', at - base);
+    return nl ? static_cast<const char*>(nl) + 1 : base;
+#else
+    while (at > base && at[-1] != '\n') at--;
+    return at;
+#endif
+}
+
+static ssize_t readFd(int fd, char* p, size_t n) {
+    ssize_t r;
+    do { r = read(fd, p, n); } while (r < 0 && errno == EINTR);
+    return r;
+}
+
+class Walker {
+public:
+    Walker(const Options& o, int rootFd) : o(o), rootFd(rootFd), needle(o.needle) {
+        if (o.ignoreCase)
+            for (auto& c : needle) c = lower(c);
+    }
+
+    void run(Result& out) {
+        unsigned n = o.threads;
+        if (n == 0) n = std::min(32u, std::max(4u, std::thread::hardware_concurrency() * 2));
+        queue.push_back({ std::string(), 0 });
+        std::vector<Result> partial(n);
+        std::vector<std::thread> pool;
+        for (unsigned i = 1; i < n; i++) pool.emplace_back([this, &partial, i] { work(partial[i]); });
+        work(partial[0]);
+        for (auto& t : pool) t.join();
+
+        for (auto& r : partial) {
+            out.paths.insert(out.paths.end(), std::make_move_iterator(r.paths.begin()), std::make_move_iterator(r.paths.end()));
+            out.hits.insert(out.hits.end(), std::make_move_iterator(r.hits.begin()), std::make_move_iterator(r.hits.end()));
+        }
+        std::sort(out.paths.begin(), out.paths.end());
+        std::stable_sort(out.hits.begin(), out.hits.end(), [](const Hit& a, const Hit& b) { return a.file < b.file; });
+    }
+
+private:
+    struct Dir {
+        std::string rel;
+        int depth;
+    };
+
+    const Options& o;
+    int rootFd;
+    std::string needle;
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<Dir> queue;
+    unsigned busy = 0;
+
+    // per worker
+    struct Scratch {
+        std::vector<char> dents;
+        std::string data, folded;
+        std::vector<Dir> found;
+    };
+
+    static char lower(char c) { return c >= 'A' && c <= 'Z' ? c + 32 : c; }
+
+    void work(Result& out) {
+        Scratch s;
+        s.dents.resize(kDentBuf);
+        for (;;) {
+            Dir dir;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.wait(lock, [this] { return !queue.empty() || busy == 0; });
+                if (queue.empty()) return;   // nothing queued and nobody scanning
+                dir = std::move(queue.front());
+                queue.pop_front();
+                busy++;
+            }
+            scan(dir, s, out);
+            bool wake;
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                for (auto& d : s.found) queue.push_back(std::move(d));
+                busy--;
+                wake = !s.found.empty() || busy == 0;
+            }
+            if (wake) cv.notify_all();
+            s.found.clear();
+        }
+    }
+
+    void entry(int dirFd, const Dir& dir, const char* name, unsigned char type, Scratch& s, Result& out) {
+        if (name[0] == '.' && (!name[1] || (name[1] == '.' && !name[2]))) return;
+        if (name[0] == '.' && !o.hidden) return;
+        std::string rel = dir.rel.empty() ? std::string(name) : dir.rel + '/' + name;
+        if (!o.exclude.empty() && anyMatch(o.exclude, name, rel)) return;
+
+        if (type == DT_UNKNOWN) {
+            struct stat st;
+            if (fstatat(dirFd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) return;
+            type = S_ISDIR(st.st_mode) ? DT_DIR : S_ISREG(st.st_mode) ? DT_REG : S_ISLNK(st.st_mode) ? DT_LNK : DT_UNKNOWN;
+        }
+        bool wanted = o.include.empty() || anyMatch(o.include, name, rel);
+
+        if (type == DT_DIR) {
+            if (o.dirs && wanted && !o.search) out.paths.push_back(rel);
+            if (o.maxDepth < 0 || dir.depth + 1 < o.maxDepth) s.found.push_back({ std::move(rel), dir.depth + 1 });
+            return;
+        }
+        if (!o.files || !wanted) return;
+        if (o.search) searchFile(dirFd, name, rel, s, out);
+        else out.paths.push_back(std::move(rel));
+    }
+
+    void scan(const Dir& dir, Scratch& s, Result& out) {
+        int fd = openat(rootFd, dir.rel.empty() ? "." : dir.rel.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC | O_NOFOLLOW);
+        if (fd < 0) return;   // vanished or unreadable: skipped like find 2>/dev/null
+#if defined(__linux__)
+        struct Dent {
+            uint64_t ino;
+            int64_t off;
+            unsigned short reclen;
+            unsigned char type;
+            char name[1];
+        };
+        for (;;) {
+            long n = syscall(SYS_getdents64, fd, s.dents.data(), s.dents.size());
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;
+            for (long pos = 0; pos < n;) {
+                auto* d = reinterpret_cast<Dent*>(s.dents.data() + pos);
+                entry(fd, dir, d->name, d->type, s, out);
+                pos += d->reclen;
+            }
+        }
+        close(fd);
+#else
+        DIR* d = fdopendir(fd);
+        if (!d) { close(fd); return; }
+        while (struct dirent* e = readdir(d)) entry(fd, dir, e->d_name, e->d_type, s, out);
+        closedir(d);
+#endif
+    }
+
+    void searchFile(int dirFd, const char* name, const std::string& rel, Scratch& s, Result& out) {
+        // O_NONBLOCK so a FIFO in the tree can't hang the open
+        int fd = openat(dirFd, name, O_RDONLY | O_CLOEXEC | O_NOCTTY | O_NONBLOCK);
+        if (fd < 0) return;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || static_cast<size_t>(st.st_size) > o.maxFileSize) {
+            close(fd);
+            return;
+        }
+        size_t size = static_cast<size_t>(st.st_size), n = 0;
+        s.data.resize(size);
+        while (n < size) {
+            ssize_t r = readFd(fd, &s.data[n], size - n);
+            if (r <= 0) break;
+            n += r;
+        }
+        close(fd);
+        const char* data = s.data.data();
+        if (memchr(data, 0, std::min(n, kBinaryProbe))) return;
+
+        if (needle.empty()) {
+            out.hits.push_back({ rel, 0, std::string(data, n) });
+            return;
+        }
+
+        const char* hay = data;
+        if (o.ignoreCase) {
+            s.folded.resize(n);
+            for (size_t i = 0; i < n; i++) s.folded[i] = lower(data[i]);
+            hay = s.folded.data();
+        }
+        const char* end = hay + n;
+        const char* counted = hay;
+        uint32_t line = 1;
+        for (const char* p = hay; (p = findNeedle(p, end, needle));) {
+            const char* ls = lineStart(hay, p);
+            const char* le = static_cast<const char*>(memchr(p, '\n', end - p));
+            if (!le) le = end;
+            line += static_cast<uint32_t>(std::count(counted, ls, '\n'));
+            counted = ls;
+            const char* te = le > ls && le[-1] == '\r' ? le - 1 : le;
+            out.hits.push_back({ rel, line, std::string(data + (ls - hay), te - ls) });
+            p = le;
+        }
+    }
+};
+
+// ---------- JS glue ----------
+
+static std::vector<std::string> stringList(Napi::Value v) {
+    std::vector<std::string> out;
+    if (v.IsString()) out.push_back(v.As<Napi::String>().Utf8Value());
+    else if (v.IsArray()) {
+        Napi::Array a = v.As<Napi::Array>();
+        for (uint32_t i = 0; i < a.Length(); i++) out.push_back(a.Get(i).ToString().Utf8Value());
+    }
+    return out;
+}
+
+static bool parseOptions(const Napi::CallbackInfo& info, std::string& root, Options& o, bool search) {
+    Napi::Env env = info.Env();
+    if (info.Length() < 1 || !info[0].IsString()) {
+        Napi::TypeError::New(env, "Expected a directory path").ThrowAsJavaScriptException();
+        return false;
+    }
+    root = info[0].As<Napi::String>().Utf8Value();
+    o.search = search;
+    if (info.Length() < 2 || !info[1].IsObject()) return true;
+    Napi::Object opts = info[1].As<Napi::Object>();
+    o.include = stringList(opts.Get("pattern"));
+    o.exclude = stringList(opts.Get("ignore"));
+    if (opts.Get("hidden").IsBoolean()) o.hidden = opts.Get("hidden").As<Napi::Boolean>();
+    if (opts.Get("maxDepth").IsNumber()) o.maxDepth = opts.Get("maxDepth").As<Napi::Number>().Int32Value();
+    if (opts.Get("threads").IsNumber()) o.threads = opts.Get("threads").As<Napi::Number>().Uint32Value();
+    Napi::Value type = opts.Get("type");
+    if (type.IsString()) {
+        std::string t = type.As<Napi::String>();
+        o.files = t != "dir";
+        o.dirs = t != "file";
+    }
+    if (opts.Get("needle").IsString()) o.needle = opts.Get("needle").As<Napi::String>().Utf8Value();
+    if (opts.Get("ignoreCase").IsBoolean()) o.ignoreCase = opts.Get("ignoreCase").As<Napi::Boolean>();
+    if (opts.Get("maxFileSize").IsNumber()) o.maxFileSize = static_cast<size_t>(opts.Get("maxFileSize").As<Napi::Number>().Int64Value());
+    return true;
+}
+
+static bool runWalk(const std::string& root, const Options& o, Result& out, std::string& error) {
+    int rootFd = open(root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (rootFd < 0) {
+        error = "open " + root + ": " + strerror(errno);
+        return false;
+    }
+    Walker(o, rootFd).run(out);
+    close(rootFd);
+    return true;
+}
+
+static Napi::Value toJS(Napi::Env env, Result& r, bool search) {
+    if (!search) {
+        Napi::Array a = Napi::Array::New(env, r.paths.size());
+        for (size_t i = 0; i < r.paths.size(); i++) a.Set(i, Napi::String::New(env, r.paths[i]));
+        return a;
+    }
+    Napi::Array a = Napi::Array::New(env, r.hits.size());
+    Napi::String file, kFile = Napi::String::New(env, "file"), kLine = Napi::String::New(env, "line"), kText = Napi::String::New(env, "text");
+    const std::string* last = nullptr;
+    for (size_t i = 0; i < r.hits.size(); i++) {
+        Hit& h = r.hits[i];
+        if (!last || *last != h.file) { file = Napi::String::New(env, h.file); last = &h.file; }
+        Napi::Object o = Napi::Object::New(env);
+        o.Set(kFile, file);
+        o.Set(kLine, Napi::Number::New(env, h.line));
+        o.Set(kText, Napi::String::New(env, h.text));
+        a.Set(i, o);
+    }
+    return a;
+}
+
+template <bool Search>
+static Napi::Value Walk(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    std::string root, error;
+    Options o;
+    if (!parseOptions(info, root, o, Search)) return env.Undefined();
+    Result r;
+    if (!runWalk(root, o, r, error)) {
+        Napi::Error::New(env, error).ThrowAsJavaScriptException();
+        return env.Undefined();
+    }
+    return toJS(env, r, Search);
+}
+
+// *Async forms run on a libuv worker and resolve a Promise.
+template <bool Search>
+class WalkWorker : public Napi::AsyncWorker {
+public:
+    WalkWorker(Napi::Env env, std::string root, Options o)
+        : Napi::AsyncWorker(env), deferred(Napi::Promise::Deferred::New(env)), root(std::move(root)), o(std::move(o)) {}
+
+    Napi::Promise Promise() { return deferred.Promise(); }
+
+    void Execute() override {
+        if (!runWalk(root, o, result, error)) SetError(error);
+    }
+    void OnOK() override { deferred.Resolve(toJS(Env(), result, Search)); }
+    void OnError(const Napi::Error& e) override { deferred.Reject(e.Value()); }
+
+private:
+    Napi::Promise::Deferred deferred;
+    std::string root, error;
+    Options o;
+    Result result;
+};
+
+template <bool Search>
+static Napi::Value WalkAsync(const Napi::CallbackInfo& info) {
+    Napi::Env env = info.Env();
+    std::string root;
+    Options o;
+    if (!parseOptions(info, root, o, Search)) return env.Undefined();
+    auto* worker = new WalkWorker<Search>(env, std::move(root), std::move(o));
+    Napi::Promise promise = worker->Promise();
+    worker->Queue();
+    return promise;
+}
+
+static Napi::Value Match(const Napi::CallbackInfo& info) {
+    if (info.Length() < 2 || !info[0].IsString() || !info[1].IsString()) {
+        Napi::TypeError::New(info.Env(), "Expected (glob, path)").ThrowAsJavaScriptException();
+        return info.Env().Undefined();
+    }
+    std::string g = info[0].As<Napi::String>(), s = info[1].As<Napi::String>();
+    return Napi::Boolean::New(info.Env(), globMatch(g.c_str(), s.c_str()));
+}
+
+Napi::Object Init(Napi::Env env, Napi::Object exports) {
+    exports.Set("walk", Napi::Function::New(env, Walk<false>));
+    exports.Set("walkAsync", Napi::Function::New(env, WalkAsync<false>));
+    exports.Set("search", Napi::Function::New(env, Walk<true>));
+    exports.Set("searchAsync", Napi::Function::New(env, WalkAsync<true>));
+    exports.Set("match", Napi::Function::New(env, Match));
+    return exports;
+}
+
+NODE_API_MODULE(walk, Init)
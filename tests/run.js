@@ -0,0 +1,30 @@
+// Runs every tests/*.nv through the interpreter and compares what it prints
+// with the .out file next to it.
+// usage: node tests/run.js [name ...]
+const fs = require('fs');
+const path = require('path');
+const { execFileSync } = require('child_process');
+
+const dir = __dirname;
+const nova = path.join(dir, '..', 'core', 'nova.js');
+const only = process.argv.slice(2);
+let failed = 0;
+
+for (const file of fs.readdirSync(dir).filter((f) => f.endsWith('.nv')).sort()) {
+  const name = path.basename(file, '.nv');
+  if (only.length && !only.includes(name)) continue;
+  const expected = fs.readFileSync(path.join(dir, name + '.out'), 'utf8');
+  let actual;
+  try {
+    actual = execFileSync(process.execPath, ['-e', `require(${JSON.stringify(nova)}).runNovaCode(require('fs').readFileSync(${JSON.stringify(path.join(dir, file))}, 'utf8'))`], { encoding: 'utf8' });
+  } catch (e) {
+    actual = (e.stdout || '') + (e.stderr || '');
+  }
+  if (actual === expected) {
+    console.log(`ok   ${name}`);
+  } else {
+    failed++;
+    console.log(`FAIL ${name}\n--- expected\n${expected}--- actual\n${actual}`);
+  }
+}
+process.exitCode = failed ? 1 : 0;